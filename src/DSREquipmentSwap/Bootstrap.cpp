@@ -0,0 +1,112 @@
+#include "Bootstrap.h"
+
+#include <utility>
+
+using namespace DSREquipmentSwap;
+
+namespace
+{
+    std::int64_t MicrosecondsSince(const std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+} // namespace
+
+const char* DSREquipmentSwap::GetBootstrapStateName(const BootstrapState state)
+{
+    switch (state)
+    {
+        case BootstrapState::NOT_STARTED:
+            return "not started";
+        case BootstrapState::INITIALIZING:
+            return "initializing";
+        case BootstrapState::RUNNING:
+            return "running";
+        case BootstrapState::FAILED:
+            return "failed";
+        case BootstrapState::STOPPED:
+            return "stopped";
+    }
+    return "unknown";
+}
+
+Bootstrap::~Bootstrap()
+{
+    Stop();
+}
+
+bool Bootstrap::Start(Steps steps)
+{
+    std::lock_guard lock(m_mutex);
+    if (GetState() != BootstrapState::NOT_STARTED)
+        return false;
+
+    m_steps = std::move(steps);
+    m_startTime = std::chrono::steady_clock::now();
+    m_state.store(BootstrapState::INITIALIZING, std::memory_order_release);
+    m_thread = std::thread([this] { ThreadMain(); });
+    return true;
+}
+
+void Bootstrap::Stop()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopRequested = true;
+        if (GetState() == BootstrapState::NOT_STARTED)
+            m_state.store(BootstrapState::STOPPED, std::memory_order_release); // never starts now
+        else if (GetState() == BootstrapState::RUNNING)
+            m_steps.requestStop();
+    }
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void Bootstrap::MarkFirstTick()
+{
+    std::int64_t notYet = -1;
+    m_firstTickUs.compare_exchange_strong(notYet, MicrosecondsSince(m_startTime), std::memory_order_acq_rel);
+}
+
+void Bootstrap::ThreadMain()
+{
+    const auto initializeStart = std::chrono::steady_clock::now();
+    bool initialized = false;
+    try
+    {
+        initialized = m_steps.initialize();
+    }
+    catch (...)
+    {
+        // Must not escape the thread (that would terminate the game). Reported as a failed initialization.
+    }
+    m_initializeUs.store(MicrosecondsSince(initializeStart), std::memory_order_release);
+
+    {
+        std::lock_guard lock(m_mutex);
+        if (!initialized)
+        {
+            m_state.store(BootstrapState::FAILED, std::memory_order_release);
+            return;
+        }
+        if (m_stopRequested)
+        {
+            m_state.store(BootstrapState::STOPPED, std::memory_order_release);
+            return;
+        }
+        // From here on, `Stop()` ends the run through `requestStop`.
+        m_state.store(BootstrapState::RUNNING, std::memory_order_release);
+    }
+
+    try
+    {
+        m_steps.run();
+    }
+    catch (...)
+    {
+        // Same as above: the swapper loop died, so nothing is running any more.
+        m_state.store(BootstrapState::FAILED, std::memory_order_release);
+        return;
+    }
+    m_state.store(BootstrapState::STOPPED, std::memory_order_release);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Lifecycle of a `Bootstrap`. Never goes back to an earlier stage (a bootstrap is started at most once).
+    enum class BootstrapState : int
+    {
+        NOT_STARTED = 0,  // `Start()` not called yet
+        INITIALIZING = 1, // bootstrap thread is loading the config and building the swapper: not ready yet
+        RUNNING = 2,      // swapper loop is running (ready)
+        FAILED = 3,       // initialization failed, or the swapper loop threw; nothing is running
+        STOPPED = 4,      // stopped, either before it was ready or after running
+    };
+
+    /// @brief Get the name of `state`, for logging.
+    const char* GetBootstrapStateName(BootstrapState state);
+
+    /// @brief Moves startup work (config load and compile, hook setup) off the thread that starts it.
+    ///
+    /// @details `DllMain` runs under the loader lock, so `DLL_PROCESS_ATTACH` only calls `Start()`, which spawns the
+    /// bootstrap thread and returns at once. That thread runs `Steps::initialize`, then (unless stopped meanwhile)
+    /// `Steps::run`, which is the swapper loop itself. Anything that needs the swapper checks `IsReady()` first.
+    ///
+    /// Knows nothing about the swapper, so the state machine can be driven by plain functions (e.g. in a test).
+    class Bootstrap
+    {
+    public:
+        /// @brief Work done by the bootstrap thread.
+        struct Steps
+        {
+            std::function<bool()> initialize;  // returns false on failure (an exception also counts as failure)
+            std::function<void()> run;         // blocks until `requestStop` is called (an exception means `FAILED`)
+            std::function<void()> requestStop; // makes `run` return soon; only called while `RUNNING`
+        };
+
+        Bootstrap() = default;
+        Bootstrap(const Bootstrap&) = delete;
+        Bootstrap& operator=(const Bootstrap&) = delete;
+
+        /// @brief Stops the bootstrap thread if it is still running.
+        ~Bootstrap();
+
+        /// @brief Start the bootstrap thread and return immediately. Returns false if already started.
+        bool Start(Steps steps);
+
+        /// @brief Stop whatever stage the bootstrap is in and wait for its thread. An initialization in progress is
+        /// allowed to finish, but `run` will not be entered. Before `Start()`, the bootstrap goes straight to `STOPPED`
+        /// (and can no longer be started). Safe to call in any state, more than once.
+        void Stop();
+
+        /// @brief Record the first update of the swapper loop (call from `Steps::run`). Only the first call counts.
+        void MarkFirstTick();
+
+        [[nodiscard]] BootstrapState GetState() const { return m_state.load(std::memory_order_acquire); }
+
+        /// @brief True once initialization succeeded and the swapper loop is running.
+        [[nodiscard]] bool IsReady() const { return GetState() == BootstrapState::RUNNING; }
+
+        /// @brief Time spent in `Steps::initialize`, once it has returned.
+        [[nodiscard]] std::optional<std::chrono::microseconds> GetInitializeDuration() const
+        {
+            return LoadDuration(m_initializeUs);
+        }
+
+        /// @brief Time from `Start()` to the first `MarkFirstTick()`, once it has been called.
+        [[nodiscard]] std::optional<std::chrono::microseconds> GetTimeToFirstTick() const
+        {
+            return LoadDuration(m_firstTickUs);
+        }
+
+    private:
+        std::thread m_thread;
+        std::mutex m_mutex; // orders `Stop()` against the `INITIALIZING` -> `RUNNING` transition
+        Steps m_steps;
+        std::atomic<BootstrapState> m_state = BootstrapState::NOT_STARTED;
+        bool m_stopRequested = false; // guarded by `m_mutex`
+        std::chrono::steady_clock::time_point m_startTime;
+        std::atomic<std::int64_t> m_initializeUs = -1; // -1 == not yet
+        std::atomic<std::int64_t> m_firstTickUs = -1;  // -1 == not yet
+
+        /// @brief Body of the bootstrap thread.
+        void ThreadMain();
+
+        [[nodiscard]] static std::optional<std::chrono::microseconds> LoadDuration(
+            const std::atomic<std::int64_t>& durationUs)
+        {
+            const std::int64_t us = durationUs.load(std::memory_order_acquire);
+            if (us < 0)
+                return std::nullopt;
+            return std::chrono::microseconds(us);
+        }
+    };
+} // namespace DSREquipmentSwap
@@ -1,17 +1,27 @@
 ﻿#pragma once
 
+#include <DSREquipmentSwap/Slots.h>
+#include <DSREquipmentSwap/TriggerCondition.h>
+
 #include <Firelink/Logging.h>
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <array>
 #include <filesystem>
 #include <format>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 // NOTE: Memory max is definitely less than 8 players (causes ChrSlot read errors).
 #define DSR_MAX_PLAYERS 4
 
+// Trigger groups can be enabled/disabled at runtime (see `SwapperCommandType`). Groups are 0 to this value minus one.
+#define MAX_TRIGGER_GROUPS 64
+
 // If an error condition is true, log an error (inserting trigger category) and return false.
 #define VALIDATE_ERROR(error_condition, message)            \
     if (error_condition)                                    \
@@ -22,24 +32,130 @@
 
 namespace DSREquipmentSwap
 {
+    /// @brief Where a player's active SpEffect list lives, for reading it directly (see `SpEffectListReader`).
+    ///
+    /// @details Layout offsets depend on the game version, so there are no defaults: with an empty `headPointerPath`,
+    /// the list is read through `DSRPlayer::GetPlayerActiveSpEffects()` instead.
+    struct SpEffectListConfig
+    {
+        // Pointer path from the PlayerIns address to the first list node: every offset is added, then followed.
+        std::vector<int> headPointerPath = {};
+        int nodeIDOffset = 0;        // int32 SpEffect ID
+        int nodeNextOffset = 0;      // pointer to the next node (null at the end)
+        int nodeSize = 0;            // bytes needed to read both fields
+        int maxNodesPerUpdate = 128; // per player; the rest of a longer list is ignored for that update
+
+        [[nodiscard]] bool IsEnabled() const { return !headPointerPath.empty(); }
+
+        [[nodiscard]] bool Validate() const
+        {
+            const std::string category = "spEffectList"; // for `VALIDATE_ERROR`
+            VALIDATE_ERROR(nodeIDOffset < 0 || nodeNextOffset < 0,
+                "Invalid node offsets in '{}'. Must be zero or greater.");
+            VALIDATE_ERROR(nodeSize < nodeIDOffset + 4 || nodeSize < nodeNextOffset + 8,
+                "Invalid nodeSize in '{}'. Must cover the 4-byte ID and the 8-byte next pointer.");
+            VALIDATE_ERROR(maxNodesPerUpdate <= 0,
+                "Invalid maxNodesPerUpdate in '{}'. Must be greater than zero.");
+            return true;
+        }
+    };
+
+    /// @brief JSON serialization for `SpEffectListConfig`. Missing keys keep their defaults.
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
+        SpEffectListConfig,
+        headPointerPath,
+        nodeIDOffset,
+        nodeNextOffset,
+        nodeSize,
+        maxNodesPerUpdate)
+
+    /// @brief Where a player's equipped param IDs live, for reading and writing them directly (see `PlayerSlots`).
+    ///
+    /// @details Layout offsets depend on the game version, so there are no defaults: with an empty `pointerPath`, slots
+    /// are read and written through `DSRPlayer` instead.
+    struct EquipBlockConfig
+    {
+        // Pointer path from the PlayerIns address to the equip block: every offset is added, then followed.
+        std::vector<int> pointerPath = {};
+        std::vector<int> slotOffsets = {};       // int32 param ID of each slot, in `EquipSlot` order
+        std::vector<int> weaponSlotOffsets = {}; // int32 active weapon slot (1 == secondary) of each hand, left first
+        int nameOffset = -1; // UTF-16 character name, identifies the character in the swap journal (-1 == none)
+
+        [[nodiscard]] bool IsEnabled() const { return !pointerPath.empty(); }
+
+        [[nodiscard]] bool Validate() const
+        {
+            const std::string category = "equipBlock"; // for `VALIDATE_ERROR`
+            VALIDATE_ERROR(slotOffsets.size() != EQUIP_SLOT_COUNT,
+                "Invalid slotOffsets in '{}'. Must have one offset per equipment slot (10).");
+            VALIDATE_ERROR(weaponSlotOffsets.size() != 2,
+                "Invalid weaponSlotOffsets in '{}'. Must have one offset per hand (2).");
+            VALIDATE_ERROR(std::ranges::any_of(slotOffsets, [](const int offset) { return offset < 0; })
+                    || std::ranges::any_of(weaponSlotOffsets, [](const int offset) { return offset < 0; }),
+                "Invalid offsets in '{}'. Must be zero or greater.");
+            VALIDATE_ERROR(nameOffset < -1, "Invalid nameOffset in '{}'. Must be -1 (none) or greater.");
+            return true;
+        }
+    };
+
+    /// @brief JSON serialization for `EquipBlockConfig`. Missing keys keep their defaults.
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
+        EquipBlockConfig, pointerPath, slotOffsets, weaponSlotOffsets, nameOffset)
+
     /// @brief Holds config information for game hooking and swap triggering.
     struct HookConfig
     {
         int processSearchTimeoutMs = 3600000; // 1 hour
         int processSearchIntervalMs = 500;
+        // EXE only: hook up to this many game processes at once (e.g. a test rig), each with its own swapper, updated
+        // by `workerThreads` shared threads (0 == one per process, up to the number of hardware threads).
+        int maxProcesses = 1;
+        int workerThreads = 0;
         int monitorIntervalMs = 10;
         int gameLoadedIntervalMs = 200;
-        int spEffectTriggerCooldownMs = 500;
+        int spEffectTriggerCooldownMs = 500; // only used if SpEffects are not edge-triggered (see below)
+        // If true (and polling), SpEffect triggers fire once when their SpEffect becomes active (rising edge) instead
+        // of every `spEffectTriggerCooldownMs` while it stays active.
+        bool spEffectRisingEdge = true;
+        // If true (and an event source is available), wake on SpEffect application events instead of polling each
+        // player's active SpEffect list every `monitorIntervalMs`.
+        bool eventDrivenSpEffects = false;
+        // If true (and a frame source is available), evaluate swaps once per game frame on the game's thread. Falls
+        // back to the swapper thread while frame updates take longer than `frameBudgetUs`.
+        bool frameHookMode = false;
+        int frameBudgetUs = 1000;
+        // If not empty, publish swapper status each update to a shared-memory page with this name (for overlays).
+        std::string statusPageName;
+        // If true, direct memory reads are widened to whole pages, so all regions on a page cost one read.
+        bool pageAlignedReads = false;
+        // If not empty, temporary swaps are journaled to this file, so swaps left applied by a crash (and possibly
+        // saved) are reverted the next time the character is loaded.
+        std::string swapJournalPath = "DSREquipmentSwap.journal";
+        // Optional direct reader for active SpEffect lists (disabled by default).
+        SpEffectListConfig spEffectList;
+        // Optional direct access to equipped param IDs (disabled by default).
+        EquipBlockConfig equipBlock;
     };
 
-    /// @brief Full JSON serialization for `GeneralSettings`.
-    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
+    /// @brief Full JSON serialization for `GeneralSettings`. Missing keys keep their defaults.
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
         HookConfig,
         processSearchTimeoutMs,
         processSearchIntervalMs,
+        maxProcesses,
+        workerThreads,
         monitorIntervalMs,
         gameLoadedIntervalMs,
-        spEffectTriggerCooldownMs)
+        spEffectTriggerCooldownMs,
+        spEffectRisingEdge,
+        eventDrivenSpEffects,
+        frameHookMode,
+        frameBudgetUs,
+        statusPageName,
+        pageAlignedReads,
+        swapJournalPath,
+        spEffectList,
+        equipBlock)
 
     /// @brief Available types of equipment (all "items").
     enum class EquipmentType
@@ -85,6 +201,22 @@ namespace DSREquipmentSwap
         // If true, swap is permanent, and will not be undone on game reload or weapon toggle.
         bool isPermanent = false;
 
+        // Group that this trigger belongs to, so that sets of triggers can be enabled/disabled together at runtime.
+        int group = 0;
+
+        // Only the first matching trigger of a slot swaps it per update. Higher priorities are checked first; equal
+        // priorities keep config order.
+        int priority = 0;
+
+        // If above 0, a temporary swap is also reverted this many milliseconds after it was made.
+        int durationMs = 0;
+
+        // If not empty, the trigger only fires while this expression holds (see `CompileCondition()`).
+        std::string condition;
+
+        /// @brief Field-wise, so `TriggerTable` can store identical triggers once.
+        [[nodiscard]] bool operator==(const SwapTriggerConfig&) const = default;
+
         [[nodiscard]] bool Validate(const std::string& category) const
         {
             VALIDATE_ERROR(spEffectIDTrigger == -1 && paramIDTrigger == -1,
@@ -101,23 +233,41 @@ namespace DSREquipmentSwap
 
             VALIDATE_ERROR(paramIDTrigger == -1 && maxParamIDTrigger != -1,
                 "maxParamIDTrigger must be -1 if paramIDTrigger is -1 in '{}'.");
-            VALIDATE_ERROR(paramIDTrigger != -1 && maxParamIDTrigger <= paramIDTrigger,
+            VALIDATE_ERROR(paramIDTrigger != -1 && maxParamIDTrigger != -1 && maxParamIDTrigger <= paramIDTrigger,
                 "maxParamIDTrigger must be -1 or greater than paramIDTrigger in '{}'.");
 
+            VALIDATE_ERROR(group < 0 || group >= MAX_TRIGGER_GROUPS,
+                "Invalid group in swap trigger entry in '{}'. Must be 0 to 63.");
+
+            VALIDATE_ERROR(durationMs < 0,
+                "Invalid durationMs in swap trigger entry in '{}'. Must be 0 or greater.");
+            VALIDATE_ERROR(durationMs > 0 && isPermanent,
+                "durationMs must be 0 for a permanent swap trigger in '{}'.");
+
+            if (!condition.empty())
+            {
+                // `id` compiles the same for every slot, so any slot will do here.
+                std::vector<std::int32_t> spEffectIDs;
+                std::string error;
+                if (!CompileCondition(condition, EquipSlot::LEFT_PRIMARY, spEffectIDs, error))
+                {
+                    Firelink::Error(std::format("Invalid condition in swap trigger entry in '{}': {}", category, error));
+                    return false;
+                }
+            }
+
             return true;
         }
 
-        /// @brief Check if given `paramID` is a trigger.
+        /// @brief Check if given `paramID` is a trigger: equal to `paramIDTrigger`, or in the inclusive range
+        /// `[paramIDTrigger, maxParamIDTrigger]` if a max is set.
         [[nodiscard]] bool CheckParamIDTrigger(const int paramID) const
         {
             if (paramIDTrigger <= 0)
                 return false;
-            if (paramID >= paramIDTrigger)
-            {
-                if (maxParamIDTrigger == -1 || paramIDTrigger <= maxParamIDTrigger)
-                    return true;
-            }
-            return false;
+            if (maxParamIDTrigger == -1)
+                return paramID == paramIDTrigger;
+            return paramID >= paramIDTrigger && paramID <= maxParamIDTrigger;
         }
 
         /// @brief Compute relative or absolute target Param ID based on config and `initialParamID` at trigger time.
@@ -153,21 +303,125 @@ namespace DSREquipmentSwap
                 s += std::format(" += {}", targetParamID);  // effect target is unknown in general
             if (isPermanent)
                 s += " (Permanent)";
+            if (group != 0)
+                s += std::format(" (Group {})", group);
+            if (priority != 0)
+                s += std::format(" (Priority {})", priority);
+            if (durationMs > 0)
+                s += std::format(" (Lasts {} ms)", durationMs);
+            if (!condition.empty())
+                s += std::format(" (If {})", condition);
 
             return s;
         }
 
     };
 
-    /// @brief JSON serialization for `SwapTriggerConfig`.
-    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
+    /// @brief JSON serialization for `SwapTriggerConfig`. Missing keys keep their defaults.
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
         SwapTriggerConfig,
         spEffectIDTrigger,
         paramIDTrigger,
         maxParamIDTrigger,
         targetParamID,
         isTargetIDAbsolute,
-        isPermanent)
+        isPermanent,
+        group,
+        priority,
+        durationMs,
+        condition)
+
+    /// @brief Sequence of equipment IDs in one trigger category's slots that is stepped through as a whole.
+    ///
+    /// @details Without a SpEffect trigger, any ID in the chain is swapped straight to the last ID (A -> B -> C becomes
+    /// one A -> C swap). With a SpEffect trigger, each activation advances one step, and `isCycle` wraps the last ID
+    /// back to the first (weapon "stances"). Either way, the target is looked up in a transition table precomputed at
+    /// load, so a multi-hop transform is a single write in a single update.
+    struct SwapChainConfig
+    {
+        // Name of the trigger list whose slots this chain applies to (e.g. "leftWeaponTriggers").
+        std::string category;
+
+        int spEffectIDTrigger = -1; // -1 == no SpEffect requirement (chain is followed to its end)
+        std::vector<int> paramIDs = {};
+
+        // If true, the last ID steps back to the first. Requires `spEffectIDTrigger`.
+        bool isCycle = false;
+        bool isPermanent = false;
+        int group = 0;
+
+        [[nodiscard]] bool Validate() const;
+
+        /// @brief Build a string representing this chain config.
+        [[nodiscard]] std::string ToString() const
+        {
+            std::string s;
+            if (spEffectIDTrigger > 0)
+                s += std::format("[SpEffect {}] ", spEffectIDTrigger);
+            s += "Chain";
+            for (std::size_t i = 0; i < paramIDs.size(); ++i)
+                s += std::format("{}{}", i == 0 ? " " : " -> ", paramIDs[i]);
+            if (isCycle && !paramIDs.empty())
+                s += std::format(" -> {} (Cycle)", paramIDs.front());
+            if (isPermanent)
+                s += " (Permanent)";
+            if (group != 0)
+                s += std::format(" (Group {})", group);
+            return s;
+        }
+    };
+
+    /// @brief JSON serialization for `SwapChainConfig`. Missing keys keep their defaults.
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
+        SwapChainConfig,
+        category,
+        spEffectIDTrigger,
+        paramIDs,
+        isCycle,
+        isPermanent,
+        group)
+
+    /// @brief One slot of a `LoadoutConfig`.
+    struct LoadoutTargetConfig
+    {
+        std::string slot; // `SlotInfo::key`, e.g. "leftPrimaryWeapon" or "ring0"
+        int paramID = -1; // absolute
+    };
+
+    /// @brief JSON serialization for `LoadoutTargetConfig`. Missing keys keep their defaults.
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(LoadoutTargetConfig, slot, paramID)
+
+    /// @brief Set of absolute slot targets ("loadout") swapped together by one SpEffect.
+    ///
+    /// @details All targets are written in one batch with no logging in between. If any write fails, the slots
+    /// already written are rolled back, so the player never keeps half a loadout. A temporary loadout is also reverted
+    /// as a whole, and only if every one of its slots still holds the loadout's ID.
+    struct LoadoutConfig
+    {
+        std::string name; // for logging
+        int spEffectIDTrigger = -1;
+        std::vector<LoadoutTargetConfig> targets = {};
+        bool isPermanent = false;
+        int group = 0;
+
+        [[nodiscard]] bool Validate() const;
+
+        /// @brief Build a string representing this loadout config.
+        [[nodiscard]] std::string ToString() const
+        {
+            std::string s = std::format("[SpEffect {}] Loadout '{}':", spEffectIDTrigger, name);
+            for (const LoadoutTargetConfig& target : targets)
+                s += std::format(" {}={}", target.slot, target.paramID);
+            if (isPermanent)
+                s += " (Permanent)";
+            if (group != 0)
+                s += std::format(" (Group {})", group);
+            return s;
+        }
+    };
+
+    /// @brief JSON serialization for `LoadoutConfig`. Missing keys keep their defaults.
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(LoadoutConfig, name, spEffectIDTrigger, targets, isPermanent, group)
 
     /// @brief Top-level settings struct represented by JSON.
     struct EquipmentSwapConfig
@@ -183,29 +437,117 @@ namespace DSREquipmentSwap
         std::vector<SwapTriggerConfig> legsArmorTriggers = {};
         std::vector<SwapTriggerConfig> ringTriggers = {};
 
-        [[nodiscard]] bool ValidateAll() const
+        std::vector<SwapChainConfig> swapChains = {};
+        std::vector<LoadoutConfig> loadouts = {};
+
+        [[nodiscard]] bool ValidateAll() const;
+    };
+
+    /// @brief A JSON trigger list and the equipment slots that its triggers apply to.
+    struct TriggerCategory
+    {
+        std::string_view name;      // JSON key
+        std::string_view logPrefix; // for logging
+        std::vector<SwapTriggerConfig> EquipmentSwapConfig::*triggers;
+        std::array<EquipSlot, 2> slots;
+        int slotCount;
+    };
+
+    /// @brief All trigger categories. Weapon triggers apply to both slots of their hand; ring triggers to both rings.
+    inline constexpr std::array<TriggerCategory, 7> TRIGGER_CATEGORIES = {{
+        {"leftWeaponTriggers",
+         "Left-Hand Weapon Trigger",
+         &EquipmentSwapConfig::leftWeaponTriggers,
+         {EquipSlot::LEFT_PRIMARY, EquipSlot::LEFT_SECONDARY},
+         2},
+        {"rightWeaponTriggers",
+         "Right-Hand Weapon Trigger",
+         &EquipmentSwapConfig::rightWeaponTriggers,
+         {EquipSlot::RIGHT_PRIMARY, EquipSlot::RIGHT_SECONDARY},
+         2},
+        {"headArmorTriggers", "Head Armor Trigger", &EquipmentSwapConfig::headArmorTriggers, {EquipSlot::HEAD}, 1},
+        {"bodyArmorTriggers", "Body Armor Trigger", &EquipmentSwapConfig::bodyArmorTriggers, {EquipSlot::BODY}, 1},
+        {"armsArmorTriggers", "Arms Armor Trigger", &EquipmentSwapConfig::armsArmorTriggers, {EquipSlot::ARMS}, 1},
+        {"legsArmorTriggers", "Legs Armor Trigger", &EquipmentSwapConfig::legsArmorTriggers, {EquipSlot::LEGS}, 1},
+        {"ringTriggers", "Ring Trigger", &EquipmentSwapConfig::ringTriggers, {EquipSlot::RING_0, EquipSlot::RING_1}, 2},
+    }};
+
+    /// @brief Find a trigger category by JSON key. Returns nullptr if there is none.
+    [[nodiscard]] constexpr const TriggerCategory* FindTriggerCategory(const std::string_view name)
+    {
+        for (const TriggerCategory& category : TRIGGER_CATEGORIES)
         {
-            bool valid = true;
-            for (const auto& trigger : leftWeaponTriggers)
-                valid &= trigger.Validate("leftWeaponTriggers");
-            for (const auto& trigger : rightWeaponTriggers)
-                valid &= trigger.Validate("rightWeaponTriggers");
-            for (const auto& trigger : headArmorTriggers)
-                valid &= trigger.Validate("headArmorTriggers");
-            for (const auto& trigger : bodyArmorTriggers)
-                valid &= trigger.Validate("bodyArmorTriggers");
-            for (const auto& trigger : armsArmorTriggers)
-                valid &= trigger.Validate("armsArmorTriggers");
-            for (const auto& trigger : legsArmorTriggers)
-                valid &= trigger.Validate("legsArmorTriggers");
-            for (const auto& trigger : ringTriggers)
-                valid &= trigger.Validate("ringTriggers");
-            return valid;
+            if (category.name == name)
+                return &category;
         }
-    };
+        return nullptr;
+    }
+
+    inline bool SwapChainConfig::Validate() const
+    {
+        VALIDATE_ERROR(FindTriggerCategory(category) == nullptr,
+            "Invalid category '{}' in swap chain. Must be the name of a trigger list, e.g. 'leftWeaponTriggers'.");
+        VALIDATE_ERROR(paramIDs.size() < 2,
+            "Swap chain for '{}' must have at least two paramIDs.");
+        VALIDATE_ERROR(std::ranges::any_of(paramIDs, [](const int id) { return id <= 0; }),
+            "Swap chain for '{}' has a paramID of zero or less.");
+        VALIDATE_ERROR(
+            std::ranges::any_of(paramIDs, [this](const int id) { return std::ranges::count(paramIDs, id) > 1; }),
+            "Swap chain for '{}' lists the same paramID more than once.");
+        VALIDATE_ERROR(spEffectIDTrigger < -1,
+            "Invalid spEffectIDTrigger in swap chain for '{}'. Must be -1 or greater.");
+        VALIDATE_ERROR(isCycle && spEffectIDTrigger <= 0,
+            "Swap chain cycle for '{}' needs a spEffectIDTrigger (it would never stop otherwise).");
+        VALIDATE_ERROR(group < 0 || group >= MAX_TRIGGER_GROUPS,
+            "Invalid group in swap chain for '{}'. Must be 0 to 63.");
+        return true;
+    }
+
+    inline bool LoadoutConfig::Validate() const
+    {
+        const std::string& category = name; // for `VALIDATE_ERROR`
+        VALIDATE_ERROR(spEffectIDTrigger <= 0,
+            "Loadout '{}' needs a spEffectIDTrigger greater than zero.");
+        VALIDATE_ERROR(targets.empty(),
+            "Loadout '{}' has no targets.");
+        VALIDATE_ERROR(
+            std::ranges::any_of(targets, [](const LoadoutTargetConfig& t) { return !FindEquipSlot(t.slot); }),
+            "Loadout '{}' has an invalid target slot. Must be a slot name, e.g. 'leftPrimaryWeapon' or 'ring0'.");
+        VALIDATE_ERROR(
+            std::ranges::any_of(targets, [this](const LoadoutTargetConfig& t)
+            {
+                return std::ranges::count(targets, t.slot, &LoadoutTargetConfig::slot) > 1;
+            }),
+            "Loadout '{}' lists the same slot more than once.");
+        VALIDATE_ERROR(
+            std::ranges::any_of(targets, [](const LoadoutTargetConfig& t) { return t.paramID < 0; }),
+            "Loadout '{}' has a negative target paramID.");
+        VALIDATE_ERROR(group < 0 || group >= MAX_TRIGGER_GROUPS,
+            "Invalid group in loadout '{}'. Must be 0 to 63.");
+        return true;
+    }
 
-    /// @brief JSON serialization for `EquipmentSwapConfig`.
-    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
+    inline bool EquipmentSwapConfig::ValidateAll() const
+    {
+        bool valid = true;
+        for (const TriggerCategory& category : TRIGGER_CATEGORIES)
+        {
+            for (const auto& trigger : this->*category.triggers)
+                valid &= trigger.Validate(std::string(category.name));
+        }
+        for (const SwapChainConfig& chain : swapChains)
+            valid &= chain.Validate();
+        for (const LoadoutConfig& loadout : loadouts)
+            valid &= loadout.Validate();
+        if (hookConfig.spEffectList.IsEnabled())
+            valid &= hookConfig.spEffectList.Validate();
+        if (hookConfig.equipBlock.IsEnabled())
+            valid &= hookConfig.equipBlock.Validate();
+        return valid;
+    }
+
+    /// @brief JSON serialization for `EquipmentSwapConfig`. Missing keys keep their defaults (e.g. empty lists).
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
         EquipmentSwapConfig,
         hookConfig,
         leftWeaponTriggers,
@@ -214,13 +556,21 @@ namespace DSREquipmentSwap
         bodyArmorTriggers,
         armsArmorTriggers,
         legsArmorTriggers,
-        ringTriggers)
+        ringTriggers,
+        swapChains,
+        loadouts)
+
+    /// @brief Most triggers of one list that `LogTriggers()` logs one by one, so large generated lists do not flood the
+    /// log (and slow down loading).
+    inline constexpr std::size_t MAX_LOGGED_TRIGGERS = 200;
 
-    /// @brief Log all triggers (INFO) with the given `prefix`.
+    /// @brief Log all triggers (INFO) with the given `prefix`, up to `MAX_LOGGED_TRIGGERS`.
     inline void LogTriggers(const std::vector<SwapTriggerConfig>& triggers, const std::string& prefix)
     {
-        for (const auto& swapTrigger : triggers)
-            Firelink::Info(std::format("{} -- {}", prefix, swapTrigger.ToString()));
+        for (std::size_t i = 0; i < std::min(triggers.size(), MAX_LOGGED_TRIGGERS); ++i)
+            Firelink::Info(std::format("{} -- {}", prefix, triggers[i].ToString()));
+        if (triggers.size() > MAX_LOGGED_TRIGGERS)
+            Firelink::Info(std::format("{} -- ... and {} more", prefix, triggers.size() - MAX_LOGGED_TRIGGERS));
     }
 
 } // namespace DSREquipmentSwap
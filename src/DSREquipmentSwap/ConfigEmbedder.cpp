@@ -0,0 +1,251 @@
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/SpEffectHash.h>
+#include <DSREquipmentSwap/TriggerTable.h>
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace DSREquipmentSwap;
+
+namespace
+{
+    /// @brief Format `s` as a C++ string literal.
+    std::string Quote(const std::string& s)
+    {
+        std::string quoted = "\"";
+        for (const char c : s)
+        {
+            if (c == '\n')
+                quoted += "\\n";
+            else if (c == '\t')
+                quoted += "\\t";
+            else if (c == '\r')
+                quoted += "\\r";
+            else
+            {
+                if (c == '"' || c == '\\')
+                    quoted += '\\';
+                quoted += c;
+            }
+        }
+        return quoted + "\"";
+    }
+
+    /// @brief Write `values` as a constexpr `std::array<type, N>` named `name`.
+    template <typename T>
+    void WriteArray(std::ostream& out, const std::string& type, const std::string& name, std::span<const T> values)
+    {
+        out << std::format("    inline constexpr std::array<{}, {}> {} = {{{{", type, values.size(), name);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            out << (i % 16 == 0 ? "\n        " : " ") << values[i] << ",";
+        out << "\n    }};\n";
+    }
+
+    std::string TriggerInitializer(const SwapTriggerConfig& trigger)
+    {
+        return std::format(
+            "EmbeddedSwapTrigger{{{}, {}, {}, {}, {}, {}, {}, {}, {}, {}}}",
+            trigger.spEffectIDTrigger,
+            trigger.paramIDTrigger,
+            trigger.maxParamIDTrigger,
+            trigger.targetParamID,
+            trigger.isTargetIDAbsolute,
+            trigger.isPermanent,
+            trigger.group,
+            trigger.priority,
+            trigger.durationMs,
+            Quote(trigger.condition));
+    }
+
+    /// @brief Write the embedded config header for `config`, read from `sourcePath`.
+    void WriteHeader(std::ostream& out, const EquipmentSwapConfig& config, const std::filesystem::path& sourcePath)
+    {
+        const HookConfig& hook = config.hookConfig;
+        const SpEffectListConfig& list = hook.spEffectList;
+        const EquipBlockConfig& equipBlock = hook.equipBlock;
+
+        out << "// Generated by DSREquipmentSwapConfigEmbedder from '" << sourcePath.filename().string() << "'.\n"
+            << "// Do not edit. Rebuild with a different DSR_EQUIPMENT_SWAP_EMBEDDED_CONFIG instead.\n"
+            << "#pragma once\n\n"
+            << "#include <DSREquipmentSwap/Config.h>\n"
+            << "#include <DSREquipmentSwap/EmbeddedConfig.h>\n"
+            << "#include <DSREquipmentSwap/SpEffectHash.h>\n\n"
+            << "#include <array>\n"
+            << "#include <cstdint>\n"
+            << "#include <span>\n"
+            << "#include <string_view>\n\n"
+            << "namespace DSREquipmentSwap::EmbeddedConfigData\n{\n";
+
+        out << std::format("    inline constexpr int PROCESS_SEARCH_TIMEOUT_MS = {};\n", hook.processSearchTimeoutMs)
+            << std::format("    inline constexpr int PROCESS_SEARCH_INTERVAL_MS = {};\n", hook.processSearchIntervalMs)
+            << std::format("    inline constexpr int MAX_PROCESSES = {};\n", hook.maxProcesses)
+            << std::format("    inline constexpr int WORKER_THREADS = {};\n", hook.workerThreads)
+            << std::format("    inline constexpr int MONITOR_INTERVAL_MS = {};\n", hook.monitorIntervalMs)
+            << std::format("    inline constexpr int GAME_LOADED_INTERVAL_MS = {};\n", hook.gameLoadedIntervalMs)
+            << std::format(
+                   "    inline constexpr int SP_EFFECT_TRIGGER_COOLDOWN_MS = {};\n", hook.spEffectTriggerCooldownMs)
+            << std::format("    inline constexpr bool SP_EFFECT_RISING_EDGE = {};\n", hook.spEffectRisingEdge)
+            << std::format("    inline constexpr bool EVENT_DRIVEN_SP_EFFECTS = {};\n", hook.eventDrivenSpEffects)
+            << std::format("    inline constexpr bool FRAME_HOOK_MODE = {};\n", hook.frameHookMode)
+            << std::format("    inline constexpr int FRAME_BUDGET_US = {};\n", hook.frameBudgetUs)
+            << std::format("    inline constexpr bool PAGE_ALIGNED_READS = {};\n", hook.pageAlignedReads)
+            << std::format("    inline constexpr int SP_EFFECT_LIST_NODE_ID_OFFSET = {};\n", list.nodeIDOffset)
+            << std::format("    inline constexpr int SP_EFFECT_LIST_NODE_NEXT_OFFSET = {};\n", list.nodeNextOffset)
+            << std::format("    inline constexpr int SP_EFFECT_LIST_NODE_SIZE = {};\n", list.nodeSize)
+            << std::format("    inline constexpr int SP_EFFECT_LIST_MAX_NODES = {};\n", list.maxNodesPerUpdate)
+            << std::format("    inline constexpr int EQUIP_BLOCK_NAME_OFFSET = {};\n", equipBlock.nameOffset)
+            << std::format("    inline constexpr std::string_view STATUS_PAGE_NAME = {};\n", Quote(hook.statusPageName))
+            << std::format(
+                   "    inline constexpr std::string_view SWAP_JOURNAL_PATH = {};\n\n", Quote(hook.swapJournalPath));
+
+        WriteArray(out, "int", "SP_EFFECT_LIST_HEAD_POINTER_PATH", std::span<const int>(list.headPointerPath));
+        WriteArray(out, "int", "EQUIP_BLOCK_POINTER_PATH", std::span<const int>(equipBlock.pointerPath));
+        WriteArray(out, "int", "EQUIP_BLOCK_SLOT_OFFSETS", std::span<const int>(equipBlock.slotOffsets));
+        WriteArray(out, "int", "EQUIP_BLOCK_WEAPON_SLOT_OFFSETS", std::span<const int>(equipBlock.weaponSlotOffsets));
+        out << "\n";
+
+        // One array per trigger category, in `TRIGGER_CATEGORIES` order.
+        for (std::size_t i = 0; i < TRIGGER_CATEGORIES.size(); ++i)
+        {
+            const std::vector<SwapTriggerConfig>& triggers = config.*TRIGGER_CATEGORIES[i].triggers;
+            out << std::format(
+                "    // {}\n    inline constexpr std::array<EmbeddedSwapTrigger, {}> CATEGORY_{}_TRIGGERS = {{{{\n",
+                TRIGGER_CATEGORIES[i].name,
+                triggers.size(),
+                i);
+            for (const SwapTriggerConfig& trigger : triggers)
+                out << "        " << TriggerInitializer(trigger) << ",\n";
+            out << "    }};\n";
+        }
+        out << std::format(
+            "\n    inline constexpr std::array<std::span<const EmbeddedSwapTrigger>, {}> CATEGORY_TRIGGERS = {{\n",
+            TRIGGER_CATEGORIES.size());
+        for (std::size_t i = 0; i < TRIGGER_CATEGORIES.size(); ++i)
+            out << std::format("        CATEGORY_{}_TRIGGERS,\n", i);
+        out << "    };\n\n";
+
+        // Swap chains: one ID array per chain, then the chains themselves.
+        for (std::size_t i = 0; i < config.swapChains.size(); ++i)
+        {
+            const std::vector<int>& paramIDs = config.swapChains[i].paramIDs;
+            WriteArray(out, "int", std::format("SWAP_CHAIN_{}_PARAM_IDS", i), std::span<const int>(paramIDs));
+        }
+        out << std::format(
+            "    inline constexpr std::array<EmbeddedSwapChain, {}> SWAP_CHAINS = {{{{\n", config.swapChains.size());
+        for (std::size_t i = 0; i < config.swapChains.size(); ++i)
+        {
+            const SwapChainConfig& chain = config.swapChains[i];
+            out << std::format(
+                "        EmbeddedSwapChain{{{}, {}, SWAP_CHAIN_{}_PARAM_IDS, {}, {}, {}}},\n",
+                Quote(chain.category),
+                chain.spEffectIDTrigger,
+                i,
+                chain.isCycle,
+                chain.isPermanent,
+                chain.group);
+        }
+        out << "    }};\n\n";
+
+        // Loadouts: one target array per loadout, then the loadouts themselves.
+        for (std::size_t i = 0; i < config.loadouts.size(); ++i)
+        {
+            const std::vector<LoadoutTargetConfig>& targets = config.loadouts[i].targets;
+            out << std::format(
+                "    inline constexpr std::array<EmbeddedLoadoutTarget, {}> LOADOUT_{}_TARGETS = {{{{\n",
+                targets.size(),
+                i);
+            for (const LoadoutTargetConfig& target : targets)
+                out << std::format("        EmbeddedLoadoutTarget{{{}, {}}},\n", Quote(target.slot), target.paramID);
+            out << "    }};\n";
+        }
+        out << std::format(
+            "    inline constexpr std::array<EmbeddedLoadout, {}> LOADOUTS = {{{{\n", config.loadouts.size());
+        for (std::size_t i = 0; i < config.loadouts.size(); ++i)
+        {
+            const LoadoutConfig& loadout = config.loadouts[i];
+            out << std::format(
+                "        EmbeddedLoadout{{{}, {}, LOADOUT_{}_TARGETS, {}, {}}},\n",
+                Quote(loadout.name),
+                loadout.spEffectIDTrigger,
+                i,
+                loadout.isPermanent,
+                loadout.group);
+        }
+        out << "    }};\n\n";
+
+        // SpEffect dispatch hash over the same trigger table the binary will build, so rule indices match.
+        const TriggerTable table(config);
+        const SpEffectHashView hash = table.GetSpEffectHash().GetView();
+        out << "    /// @brief Rule counts of the table the hash was built over (checked by `TriggerTable`).\n"
+            << std::format("    inline constexpr std::uint32_t TRIGGER_COUNT = {};\n", table.GetCount())
+            << std::format("    inline constexpr std::uint32_t CHAIN_COUNT = {};\n\n", table.GetChainCount());
+        WriteArray(out, "std::uint32_t", "SP_EFFECT_HASH_PILOTS", hash.pilots);
+        WriteArray(out, "std::int32_t", "SP_EFFECT_HASH_KEYS", hash.keys);
+        WriteArray(out, "std::uint32_t", "SP_EFFECT_HASH_LIST_STARTS", hash.listStarts);
+        WriteArray(out, "std::uint32_t", "SP_EFFECT_HASH_TRIGGER_INDICES", hash.triggerIndices);
+        out << "\n    /// @brief SpEffect ID to trigger indices (see `SpEffectHashView`), prebuilt so nothing is\n"
+            << "    /// searched at attach. Fully constexpr, so lookups can be folded into the caller.\n"
+            << std::format(
+                   "    inline constexpr SpEffectHashView SP_EFFECT_HASH = {{\n        {}ull,\n", hash.multiplier)
+            << "        SP_EFFECT_HASH_PILOTS,\n"
+            << "        SP_EFFECT_HASH_KEYS,\n"
+            << "        SP_EFFECT_HASH_LIST_STARTS,\n"
+            << "        SP_EFFECT_HASH_TRIGGER_INDICES,\n"
+            << "    };\n\n";
+
+        // Let the compiler check the generated tables, too.
+        for (const std::int32_t key : hash.keys)
+        {
+            out << std::format(
+                "    static_assert(SP_EFFECT_HASH.Find({}).size() == {});\n", key, hash.Find(key).size());
+        }
+        out << "} // namespace DSREquipmentSwap::EmbeddedConfigData\n";
+    }
+} // namespace
+
+/// @brief Build-time tool: `DSREquipmentSwapConfigEmbedder <config.json> <output.h>`. Parses and validates a JSON
+/// config exactly like the DLL would, then writes it as a header of constexpr tables (see `EmbeddedConfig.h`).
+int main(const int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: DSREquipmentSwapConfigEmbedder <config.json> <output.h>\n";
+        return 1;
+    }
+    const std::filesystem::path jsonPath = argv[1];
+    const std::filesystem::path outputPath = argv[2];
+
+    EquipmentSwapConfig config;
+    try
+    {
+        std::ifstream ifs(jsonPath);
+        from_json(nlohmann::json::parse(ifs), config);
+    }
+    catch (nlohmann::json::exception& e)
+    {
+        std::cerr << std::format("Failed to parse JSON file: {}. Error: {}\n", jsonPath.string(), e.what());
+        return 1;
+    }
+
+    if (!config.ValidateAll())
+    {
+        std::cerr << std::format("Invalid trigger config in '{}'. See errors above.\n", jsonPath.string());
+        return 1;
+    }
+
+    std::ofstream out(outputPath);
+    if (!out)
+    {
+        std::cerr << std::format("Could not open output file '{}'.\n", outputPath.string());
+        return 1;
+    }
+    WriteHeader(out, config, jsonPath);
+    return 0;
+}
@@ -0,0 +1,389 @@
+#include "ConfigReader.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <format>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace DSREquipmentSwap;
+
+namespace
+{
+    using Json = nlohmann::json;
+
+    /// @brief Report progress after this many list entries.
+    constexpr std::size_t PROGRESS_ENTRY_INTERVAL = 1024;
+
+    /// @brief SAX handler that builds one value at a time (a list entry, or a whole non-list value) and hands it to
+    /// `ReadConfig()`'s conversions as soon as it is complete.
+    ///
+    /// @details Events of the value being built are forwarded to nlohmann's own DOM builder. Everything else only
+    /// moves through the structure: the root object, its keys, and the trigger/chain/loadout arrays being streamed.
+    class ConfigSaxHandler final : public nlohmann::json_sax<Json>
+    {
+    public:
+        ConfigSaxHandler(
+            std::istream& input, EquipmentSwapConfig& config, ConfigReadStats& stats, const ConfigReadProgress& progress)
+            : m_input(input)
+            , m_config(config)
+            , m_stats(stats)
+            , m_progress(progress)
+        {
+        }
+
+        [[nodiscard]] const std::string& GetError() const { return m_error; }
+
+        bool null() override
+        {
+            return OnEvent(Event::VALUE, false, [](Builder& b) { return b.null(); });
+        }
+
+        bool boolean(const bool value) override
+        {
+            return OnEvent(Event::VALUE, false, [value](Builder& b) { return b.boolean(value); });
+        }
+
+        bool number_integer(const number_integer_t value) override
+        {
+            return OnEvent(Event::VALUE, false, [value](Builder& b) { return b.number_integer(value); });
+        }
+
+        bool number_unsigned(const number_unsigned_t value) override
+        {
+            return OnEvent(Event::VALUE, false, [value](Builder& b) { return b.number_unsigned(value); });
+        }
+
+        bool number_float(const number_float_t value, const string_t& text) override
+        {
+            return OnEvent(Event::VALUE, false, [value, &text](Builder& b) { return b.number_float(value, text); });
+        }
+
+        bool string(string_t& value) override
+        {
+            return OnEvent(Event::VALUE, false, [&value](Builder& b) { return b.string(value); });
+        }
+
+        bool binary(binary_t& value) override
+        {
+            return OnEvent(Event::VALUE, false, [&value](Builder& b) { return b.binary(value); });
+        }
+
+        bool start_object(const std::size_t size) override
+        {
+            return OnEvent(Event::START, true, [size](Builder& b) { return b.start_object(size); });
+        }
+
+        bool key(string_t& value) override
+        {
+            if (m_builder)
+                return m_builder->key(value);
+            if (m_skipDepth == 0 && m_depth == Depth::ROOT)
+                m_section = FindSection(value);
+            return true;
+        }
+
+        bool end_object() override
+        {
+            return OnEvent(Event::END, true, [](Builder& b) { return b.end_object(); });
+        }
+
+        bool start_array(const std::size_t size) override
+        {
+            return OnEvent(Event::START, false, [size](Builder& b) { return b.start_array(size); });
+        }
+
+        bool end_array() override
+        {
+            return OnEvent(Event::END, false, [](Builder& b) { return b.end_array(); });
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override
+        {
+            m_error = e.what();
+            return false;
+        }
+
+    private:
+        using Builder = nlohmann::detail::json_sax_dom_parser<Json>;
+
+        enum class Event
+        {
+            VALUE, // scalar
+            START, // object or array
+            END,
+        };
+
+        /// @brief Position of the handler outside the value being built.
+        enum class Depth
+        {
+            DOCUMENT, // before or after the root object
+            ROOT,     // in the root object
+            LIST,     // in a streamed list
+        };
+
+        /// @brief What a root key holds.
+        struct Section
+        {
+            enum class Kind
+            {
+                UNKNOWN,
+                HOOK,
+                TRIGGERS,
+                CHAINS,
+                LOADOUTS,
+            } kind = Kind::UNKNOWN;
+            const TriggerCategory* category = nullptr; // for `TRIGGERS`
+            std::string name;
+        };
+
+        std::istream& m_input;
+        EquipmentSwapConfig& m_config;
+        ConfigReadStats& m_stats;
+        const ConfigReadProgress& m_progress;
+        std::string m_error;
+
+        Depth m_depth = Depth::DOCUMENT;
+        Section m_section;
+        std::size_t m_entryIndex = 0;             // of the next entry of the streamed list
+        int m_skipDepth = 0;                      // containers open in an unknown section's value
+        std::vector<std::string> m_readListNames; // keys of the lists streamed so far
+
+        Json m_value;                     // value being built
+        std::optional<Builder> m_builder; // set while `m_value` is being built
+        int m_builderDepth = 0;           // containers open in `m_value`
+
+        static Section FindSection(const std::string& key)
+        {
+            using enum Section::Kind;
+            if (key == "hookConfig")
+                return {HOOK, nullptr, key};
+            if (const TriggerCategory* category = FindTriggerCategory(key))
+                return {TRIGGERS, category, key};
+            if (key == "swapChains")
+                return {CHAINS, nullptr, key};
+            if (key == "loadouts")
+                return {LOADOUTS, nullptr, key};
+            return {UNKNOWN, nullptr, key};
+        }
+
+        /// @brief Handle any event but a key. `isObject` tells objects from arrays for `START` and `END`.
+        template <typename Forward>
+        bool OnEvent(const Event event, const bool isObject, Forward&& forward)
+        {
+            if (m_builder)
+                return ForwardToBuilder(event, forward);
+
+            if (m_skipDepth > 0)
+            {
+                m_skipDepth += event == Event::START ? 1 : event == Event::END ? -1 : 0;
+                return true;
+            }
+
+            switch (m_depth)
+            {
+            case Depth::DOCUMENT:
+                if (event != Event::START || !isObject)
+                {
+                    m_error = "The config must be a JSON object.";
+                    return false;
+                }
+                m_depth = Depth::ROOT;
+                return true;
+
+            case Depth::ROOT:
+                if (event == Event::END)
+                {
+                    m_depth = Depth::DOCUMENT;
+                    return true;
+                }
+                if (m_section.kind == Section::Kind::UNKNOWN)
+                {
+                    m_skipDepth = event == Event::START ? 1 : 0; // ignored, as when converting a whole document
+                    return true;
+                }
+                if (event == Event::START && !isObject && m_section.kind != Section::Kind::HOOK)
+                {
+                    // Replaces the list, if the key appeared before.
+                    ClearSectionList();
+                    m_depth = Depth::LIST;
+                    m_entryIndex = 0;
+                    return true;
+                }
+                break; // anything else is converted whole (and will most likely fail)
+
+            case Depth::LIST:
+                if (event == Event::END)
+                {
+                    m_depth = Depth::ROOT;
+                    return true;
+                }
+                break;
+            }
+
+            m_value = nullptr;
+            m_builder.emplace(m_value);
+            m_builderDepth = 0;
+            return ForwardToBuilder(event, forward);
+        }
+
+        template <typename Forward>
+        bool ForwardToBuilder(const Event event, Forward& forward)
+        {
+            if (!forward(*m_builder))
+                return false;
+            m_builderDepth += event == Event::START ? 1 : event == Event::END ? -1 : 0;
+            if (m_builderDepth > 0)
+                return true;
+
+            m_builder.reset();
+            return m_depth == Depth::LIST ? AddEntry() : ConvertSection();
+        }
+
+        /// @brief Clear the list of `m_section`, and take entries read from an earlier list under the same key out of
+        /// the counts. (The first list of a key only clears entries that `config` held before.)
+        void ClearSectionList()
+        {
+            const bool isReadBefore = std::ranges::find(m_readListNames, m_section.name) != m_readListNames.end();
+            if (!isReadBefore)
+                m_readListNames.push_back(m_section.name);
+            switch (m_section.kind)
+            {
+            case Section::Kind::TRIGGERS:
+                ClearList(m_config.*m_section.category->triggers, isReadBefore, m_stats.triggerCount);
+                break;
+            case Section::Kind::CHAINS:
+                ClearList(m_config.swapChains, isReadBefore, m_stats.chainCount);
+                break;
+            case Section::Kind::LOADOUTS:
+                ClearList(m_config.loadouts, isReadBefore, m_stats.loadoutCount);
+                break;
+            default:
+                break;
+            }
+        }
+
+        template <typename T>
+        static void ClearList(std::vector<T>& list, const bool isReadBefore, std::size_t& count)
+        {
+            if (isReadBefore)
+                count -= list.size();
+            list.clear();
+        }
+
+        /// @brief Convert, validate and append the finished list entry in `m_value`.
+        bool AddEntry()
+        {
+            try
+            {
+                switch (m_section.kind)
+                {
+                case Section::Kind::TRIGGERS:
+                    AddValid(
+                        m_value.get<SwapTriggerConfig>(),
+                        m_config.*m_section.category->triggers,
+                        m_stats.triggerCount);
+                    break;
+                case Section::Kind::CHAINS:
+                    AddValid(m_value.get<SwapChainConfig>(), m_config.swapChains, m_stats.chainCount);
+                    break;
+                case Section::Kind::LOADOUTS:
+                    AddValid(m_value.get<LoadoutConfig>(), m_config.loadouts, m_stats.loadoutCount);
+                    break;
+                default:
+                    break;
+                }
+            }
+            catch (const nlohmann::json::exception& e)
+            {
+                m_error = std::format("Invalid entry {} in '{}': {}", m_entryIndex, m_section.name, e.what());
+                return false;
+            }
+
+            if (++m_entryIndex % PROGRESS_ENTRY_INTERVAL == 0 && m_progress)
+            {
+                // Straight from the buffer: the stream itself is being read by the parser.
+                const std::streamoff position = m_input.rdbuf()->pubseekoff(0, std::ios::cur, std::ios::in);
+                if (position >= 0)
+                    m_progress(static_cast<std::uint64_t>(position));
+            }
+            return true;
+        }
+
+        template <typename T>
+        void AddValid(T entry, std::vector<T>& list, std::size_t& count)
+        {
+            bool isValid;
+            if constexpr (std::is_same_v<T, SwapTriggerConfig>)
+                isValid = entry.Validate(m_section.name);
+            else
+                isValid = entry.Validate();
+
+            if (!isValid)
+            {
+                ++m_stats.droppedCount;
+                return;
+            }
+            list.push_back(std::move(entry));
+            ++count;
+        }
+
+        /// @brief Convert the finished whole value in `m_value` of the current root key.
+        bool ConvertSection()
+        {
+            try
+            {
+                switch (m_section.kind)
+                {
+                case Section::Kind::HOOK:
+                    m_value.get_to(m_config.hookConfig);
+                    break;
+                case Section::Kind::TRIGGERS:
+                    m_value.get_to(m_config.*m_section.category->triggers);
+                    break;
+                case Section::Kind::CHAINS:
+                    m_value.get_to(m_config.swapChains);
+                    break;
+                case Section::Kind::LOADOUTS:
+                    m_value.get_to(m_config.loadouts);
+                    break;
+                default:
+                    break;
+                }
+            }
+            catch (const nlohmann::json::exception& e)
+            {
+                m_error = std::format("Invalid value of '{}': {}", m_section.name, e.what());
+                return false;
+            }
+            m_value = nullptr;
+            return true;
+        }
+    };
+} // namespace
+
+bool DSREquipmentSwap::ReadConfig(
+    std::istream& input,
+    EquipmentSwapConfig& config,
+    ConfigReadStats& stats,
+    std::string& error,
+    const ConfigReadProgress& progress)
+{
+    ConfigSaxHandler handler(input, config, stats, progress);
+    bool isRead;
+    try
+    {
+        isRead = Json::sax_parse(input, &handler);
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+        error = e.what(); // e.g. a value too large to build
+        return false;
+    }
+    if (!isRead)
+        error = handler.GetError();
+    return isRead;
+}
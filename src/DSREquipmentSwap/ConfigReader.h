@@ -0,0 +1,43 @@
+#pragma once
+
+#include <DSREquipmentSwap/Config.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <string>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Called by `ReadConfig()` now and then with the number of bytes of input read so far.
+    using ConfigReadProgress = std::function<void(std::uint64_t bytesRead)>;
+
+    /// @brief Counts kept by `ReadConfig()`.
+    struct ConfigReadStats
+    {
+        std::size_t triggerCount = 0;  // valid triggers read (over all lists)
+        std::size_t chainCount = 0;    // valid swap chains read
+        std::size_t loadoutCount = 0;  // valid loadouts read
+        std::size_t droppedCount = 0;  // invalid triggers, chains and loadouts skipped (each logged as an error)
+    };
+
+    /// @brief Read `config` from the JSON in `input`, one event at a time, without building a document of the whole
+    /// input.
+    ///
+    /// @details Each entry of a trigger list, `swapChains` and `loadouts` is built as a small JSON value on its own,
+    /// converted, validated and appended to `config` before the next one is read, so memory use is the config itself
+    /// plus one entry. Invalid entries are logged and skipped, rather than failing the whole config. Any other value
+    /// (e.g. `hookConfig`) is converted as a whole. Unknown keys are ignored, missing keys keep the defaults already
+    /// in `config`, and a key that appears twice replaces the earlier value, as when converting a whole document.
+    ///
+    /// Returns false and sets `error` on a JSON syntax error, or on a value that cannot be converted (e.g. a string
+    /// where a number is expected). `input` should be opened in binary mode if `progress` is used, so its positions
+    /// are byte offsets.
+    bool ReadConfig(
+        std::istream& input,
+        EquipmentSwapConfig& config,
+        ConfigReadStats& stats,
+        std::string& error,
+        const ConfigReadProgress& progress = {});
+} // namespace DSREquipmentSwap
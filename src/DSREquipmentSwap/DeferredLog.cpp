@@ -0,0 +1,43 @@
+#include "DeferredLog.h"
+
+#include <Firelink/Logging.h>
+
+#include <format>
+#include <utility>
+
+using namespace DSREquipmentSwap;
+
+void DeferredLog::Flush()
+{
+    while (std::optional<Line> line = m_lines.TryPop())
+        line->log(line->text);
+
+    if (const std::uint64_t droppedCount = m_droppedCount.exchange(0, std::memory_order_relaxed); droppedCount > 0)
+        Firelink::Warning(std::format("Dropped {} deferred log lines (queue full).", droppedCount));
+}
+
+void DeferredLog::LogInfo(const std::string& line)
+{
+    Firelink::Info(line);
+}
+
+void DeferredLog::LogWarning(const std::string& line)
+{
+    Firelink::Warning(line);
+}
+
+void DeferredLog::LogError(const std::string& line)
+{
+    Firelink::Error(line);
+}
+
+void DeferredLog::Write(const LogFunction log, std::string line)
+{
+    if (!m_isDeferred)
+    {
+        log(line);
+        return;
+    }
+    if (!m_lines.TryPush(Line{log, std::move(line)}))
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <DSREquipmentSwap/MpscQueue.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Log of swap updates. Lines are written through Firelink right away, or, while deferred (e.g. during an
+    /// update on the game's frame tick), queued until `Flush()`, so no file I/O happens on the calling thread.
+    ///
+    /// @details Queueing never blocks. If the queue is full, the line is dropped and counted, and `Flush()` logs how
+    /// many were lost. Lines are kept in order as long as `Flush()` runs before the next direct line is written.
+    class DeferredLog
+    {
+    public:
+        void Info(std::string line) { Write(&LogInfo, std::move(line)); }
+        void Warning(std::string line) { Write(&LogWarning, std::move(line)); }
+        void Error(std::string line) { Write(&LogError, std::move(line)); }
+
+        /// @brief Queue lines from now on, or write them right away again. Not synchronized: only change it while no
+        /// other thread logs (e.g. under the swapper's update mutex).
+        void SetDeferred(const bool isDeferred) { m_isDeferred = isDeferred; }
+
+        /// @brief Write all queued lines. Must only be called from one thread (the swapper thread).
+        void Flush();
+
+    private:
+        using LogFunction = void (*)(const std::string&);
+
+        struct Line
+        {
+            LogFunction log = nullptr;
+            std::string text;
+        };
+
+        static void LogInfo(const std::string& line);
+        static void LogWarning(const std::string& line);
+        static void LogError(const std::string& line);
+
+        void Write(LogFunction log, std::string line);
+
+        MpscQueue<Line, 256> m_lines;
+        std::atomic<std::uint64_t> m_droppedCount = 0;
+        bool m_isDeferred = false;
+    };
+} // namespace DSREquipmentSwap
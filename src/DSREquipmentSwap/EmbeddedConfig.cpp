@@ -0,0 +1,86 @@
+#include "EmbeddedConfig.h"
+
+#include <DSREquipmentSwap/EmbeddedConfigData.h>
+
+#include <string>
+#include <vector>
+
+using namespace DSREquipmentSwap;
+
+void DSREquipmentSwap::LoadEmbeddedConfig(EquipmentSwapConfig& config)
+{
+    config = EquipmentSwapConfig{};
+
+    HookConfig& hook = config.hookConfig;
+    hook.processSearchTimeoutMs = EmbeddedConfigData::PROCESS_SEARCH_TIMEOUT_MS;
+    hook.processSearchIntervalMs = EmbeddedConfigData::PROCESS_SEARCH_INTERVAL_MS;
+    hook.maxProcesses = EmbeddedConfigData::MAX_PROCESSES;
+    hook.workerThreads = EmbeddedConfigData::WORKER_THREADS;
+    hook.monitorIntervalMs = EmbeddedConfigData::MONITOR_INTERVAL_MS;
+    hook.gameLoadedIntervalMs = EmbeddedConfigData::GAME_LOADED_INTERVAL_MS;
+    hook.spEffectTriggerCooldownMs = EmbeddedConfigData::SP_EFFECT_TRIGGER_COOLDOWN_MS;
+    hook.spEffectRisingEdge = EmbeddedConfigData::SP_EFFECT_RISING_EDGE;
+    hook.eventDrivenSpEffects = EmbeddedConfigData::EVENT_DRIVEN_SP_EFFECTS;
+    hook.frameHookMode = EmbeddedConfigData::FRAME_HOOK_MODE;
+    hook.frameBudgetUs = EmbeddedConfigData::FRAME_BUDGET_US;
+    hook.statusPageName = std::string(EmbeddedConfigData::STATUS_PAGE_NAME);
+    hook.swapJournalPath = std::string(EmbeddedConfigData::SWAP_JOURNAL_PATH);
+    hook.pageAlignedReads = EmbeddedConfigData::PAGE_ALIGNED_READS;
+    hook.spEffectList.headPointerPath.assign(
+        EmbeddedConfigData::SP_EFFECT_LIST_HEAD_POINTER_PATH.begin(),
+        EmbeddedConfigData::SP_EFFECT_LIST_HEAD_POINTER_PATH.end());
+    hook.spEffectList.nodeIDOffset = EmbeddedConfigData::SP_EFFECT_LIST_NODE_ID_OFFSET;
+    hook.spEffectList.nodeNextOffset = EmbeddedConfigData::SP_EFFECT_LIST_NODE_NEXT_OFFSET;
+    hook.spEffectList.nodeSize = EmbeddedConfigData::SP_EFFECT_LIST_NODE_SIZE;
+    hook.spEffectList.maxNodesPerUpdate = EmbeddedConfigData::SP_EFFECT_LIST_MAX_NODES;
+    hook.equipBlock.pointerPath.assign(
+        EmbeddedConfigData::EQUIP_BLOCK_POINTER_PATH.begin(), EmbeddedConfigData::EQUIP_BLOCK_POINTER_PATH.end());
+    hook.equipBlock.slotOffsets.assign(
+        EmbeddedConfigData::EQUIP_BLOCK_SLOT_OFFSETS.begin(), EmbeddedConfigData::EQUIP_BLOCK_SLOT_OFFSETS.end());
+    hook.equipBlock.weaponSlotOffsets.assign(
+        EmbeddedConfigData::EQUIP_BLOCK_WEAPON_SLOT_OFFSETS.begin(),
+        EmbeddedConfigData::EQUIP_BLOCK_WEAPON_SLOT_OFFSETS.end());
+    hook.equipBlock.nameOffset = EmbeddedConfigData::EQUIP_BLOCK_NAME_OFFSET;
+
+    for (std::size_t i = 0; i < TRIGGER_CATEGORIES.size(); ++i)
+    {
+        for (const EmbeddedSwapTrigger& trigger : EmbeddedConfigData::CATEGORY_TRIGGERS[i])
+        {
+            (config.*TRIGGER_CATEGORIES[i].triggers).push_back(
+                SwapTriggerConfig{
+                    trigger.spEffectIDTrigger,
+                    trigger.paramIDTrigger,
+                    trigger.maxParamIDTrigger,
+                    trigger.targetParamID,
+                    trigger.isTargetIDAbsolute,
+                    trigger.isPermanent,
+                    trigger.group,
+                    trigger.priority,
+                    trigger.durationMs,
+                    std::string(trigger.condition)});
+        }
+    }
+
+    for (const EmbeddedSwapChain& chain : EmbeddedConfigData::SWAP_CHAINS)
+    {
+        config.swapChains.push_back(
+            SwapChainConfig{
+                std::string(chain.category),
+                chain.spEffectIDTrigger,
+                std::vector<int>(chain.paramIDs.begin(), chain.paramIDs.end()),
+                chain.isCycle,
+                chain.isPermanent,
+                chain.group});
+    }
+
+    for (const EmbeddedLoadout& embedded : EmbeddedConfigData::LOADOUTS)
+    {
+        LoadoutConfig& loadout = config.loadouts.emplace_back();
+        loadout.name = std::string(embedded.name);
+        loadout.spEffectIDTrigger = embedded.spEffectIDTrigger;
+        for (const EmbeddedLoadoutTarget& target : embedded.targets)
+            loadout.targets.push_back(LoadoutTargetConfig{std::string(target.slot), target.paramID});
+        loadout.isPermanent = embedded.isPermanent;
+        loadout.group = embedded.group;
+    }
+}
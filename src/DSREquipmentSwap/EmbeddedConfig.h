@@ -0,0 +1,59 @@
+#pragma once
+
+#include <DSREquipmentSwap/Config.h>
+
+#include <span>
+#include <string_view>
+
+namespace DSREquipmentSwap
+{
+    // Only compiled when CMake's `DSR_EQUIPMENT_SWAP_EMBEDDED_CONFIG` is set to a JSON config path (which defines
+    // `DSR_EQUIPMENT_SWAP_EMBEDDED`). CMake then runs `DSREquipmentSwapConfigEmbedder` on that file and compiles the
+    // generated `EmbeddedConfigData.h` into the binary.
+
+    /// @brief Literal-type mirror of `SwapTriggerConfig` (whose `condition` string is not constexpr-friendly).
+    struct EmbeddedSwapTrigger
+    {
+        int spEffectIDTrigger;
+        int paramIDTrigger;
+        int maxParamIDTrigger;
+        int targetParamID;
+        bool isTargetIDAbsolute;
+        bool isPermanent;
+        int group;
+        int priority;
+        int durationMs;
+        std::string_view condition;
+    };
+
+    /// @brief Literal-type mirror of `SwapChainConfig`, so the generated header can hold chains as constexpr data.
+    struct EmbeddedSwapChain
+    {
+        std::string_view category;
+        int spEffectIDTrigger;
+        std::span<const int> paramIDs;
+        bool isCycle;
+        bool isPermanent;
+        int group;
+    };
+
+    /// @brief Literal-type mirror of `LoadoutTargetConfig`.
+    struct EmbeddedLoadoutTarget
+    {
+        std::string_view slot;
+        int paramID;
+    };
+
+    /// @brief Literal-type mirror of `LoadoutConfig`.
+    struct EmbeddedLoadout
+    {
+        std::string_view name;
+        int spEffectIDTrigger;
+        std::span<const EmbeddedLoadoutTarget> targets;
+        bool isPermanent;
+        int group;
+    };
+
+    /// @brief Fill `config` from the trigger set compiled into this build. No file I/O or JSON parsing.
+    void LoadEmbeddedConfig(EquipmentSwapConfig& config);
+} // namespace DSREquipmentSwap
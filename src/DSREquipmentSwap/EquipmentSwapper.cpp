@@ -1,8 +1,10 @@
 #include "EquipmentSwapper.h"
 
 #include <DSREquipmentSwap/Config.h>
-#include <DSREquipmentSwap/SwapTrigger.h>
-#include <DSREquipmentSwap/Weapon.h>
+#include <DSREquipmentSwap/ConfigReader.h>
+#include <DSREquipmentSwap/ParamIDMatch.h>
+#include <DSREquipmentSwap/SlotAccess.h>
+#include <DSREquipmentSwap/Slots.h>
 
 #include <Firelink/Logging.h>
 #include <Firelink/Pointer.h>
@@ -10,13 +12,16 @@
 #include <FirelinkDSRHook/DSRHook.h>
 #include <FirelinkDSRHook/DSRPlayer.h>
 
-#include <nlohmann/json.hpp>
-
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
 #include <filesystem>
 #include <format>
 #include <fstream>
 #include <memory>
 #include <ranges>
+#include <system_error>
 #include <thread>
 
 using std::filesystem::path;
@@ -25,29 +30,88 @@ using namespace Firelink;
 using namespace FirelinkDSR;
 using namespace DSREquipmentSwap;
 
+namespace
+{
+    // Size of each entry in the connected players' ChrSlot array. The PlayerIns pointer is at offset 0.
+    constexpr int CHR_SLOT_SIZE = 0x38;
+
+    // Regions this close together are merged into one direct read (the gap is read and discarded).
+    constexpr std::size_t READ_MERGE_GAP = 256;
+
+    // Config files at least this large log their reading progress.
+    constexpr std::uintmax_t CONFIG_PROGRESS_MIN_BYTES = 4 * 1024 * 1024;
+
+    // Updates without any SpEffect event for this long (while polling instead) log that the source seems unconnected.
+    constexpr std::uint64_t SPEFFECT_EVENT_WAIT_US = 30'000'000;
+
+    /// @brief Get every SpEffect ID that a trigger, chain, condition or loadout of the built tables reacts to (sorted,
+    /// no duplicates).
+    std::vector<int> GetTriggerSpEffectIDs(const TriggerTable& triggers, const LoadoutTable& loadouts)
+    {
+        std::vector<int> ids;
+        triggers.AppendSpEffectIDs(ids);
+        loadouts.AppendSpEffectIDs(ids);
+        std::erase_if(ids, [](const int id) { return id <= 0; }); // "no SpEffect"
+        std::ranges::sort(ids);
+        ids.erase(std::ranges::unique(ids).begin(), ids.end());
+        return ids;
+    }
+
+    /// @brief Current steady clock time in microseconds, for frame scheduling.
+    std::uint64_t NowUs()
+    {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+    }
+} // namespace
+
 EquipmentSwapper::EquipmentSwapper(EquipmentSwapConfig config)
-    : m_config(std::move(config))
-    , m_weaponSwapper(m_config.hookConfig.spEffectTriggerCooldownMs)
-    , m_armorSwapper(m_config.hookConfig.spEffectTriggerCooldownMs)
-    , m_ringSwapper(m_config.hookConfig.spEffectTriggerCooldownMs)
+    : m_hookConfig(std::move(config.hookConfig))
+    , m_processDiscovery(CreateProcessDiscovery(DSR_PROCESS_NAME))
+    , m_frameScheduler(static_cast<std::uint64_t>(std::max(m_hookConfig.frameBudgetUs, 1)))
+    , m_monitorIntervalMs(m_hookConfig.monitorIntervalMs)
+    , m_triggers(config)
+    , m_loadouts(config)
+    , m_triggeredSlots(m_triggers.GetTriggeredSlots() | m_loadouts.GetTargetSlots())
+    , m_readSlots(m_triggeredSlots | m_triggers.GetConditionSlots())
+    , m_readPlanner(READ_MERGE_GAP, m_hookConfig.pageAlignedReads)
+    , m_slotSwapper(m_log, m_hookConfig.spEffectTriggerCooldownMs)
 {
-    // Construct matching lists of SwapTrigger state managers.
-    auto emplaceTriggers = [](const std::vector<SwapTriggerConfig>& triggerConfigs, std::vector<SwapTrigger>& triggerList)
+    // Taken from the built tables (conditions are already compiled there), once for both SpEffect readers.
+    std::vector<int> spEffectIDs = GetTriggerSpEffectIDs(m_triggers, m_loadouts);
+    m_spEffectDeltas = SpEffectDeltaTracker(spEffectIDs);
+
+    if (const SpEffectListConfig& listConfig = m_hookConfig.spEffectList; listConfig.IsEnabled())
     {
-        triggerList.reserve(triggerConfigs.size());
-        for (const auto& triggerConfig : triggerConfigs)
-        {
-            triggerList.emplace_back(triggerConfig);
-        }
-    };
+        if (listConfig.Validate())
+            m_spEffectListReader.emplace(listConfig, std::move(spEffectIDs));
+        else
+            Warning("Reading active SpEffects through DSRPlayer instead (invalid 'spEffectList').");
+    }
 
-    emplaceTriggers(m_config.leftWeaponTriggers, m_leftWeaponTriggers);
-    emplaceTriggers(m_config.rightWeaponTriggers, m_rightWeaponTriggers);
-    emplaceTriggers(m_config.headArmorTriggers, m_headArmorTriggers);
-    emplaceTriggers(m_config.bodyArmorTriggers, m_bodyArmorTriggers);
-    emplaceTriggers(m_config.armsArmorTriggers, m_armsArmorTriggers);
-    emplaceTriggers(m_config.legsArmorTriggers, m_legsArmorTriggers);
-    emplaceTriggers(m_config.ringTriggers, m_ringTriggers);
+    if (const EquipBlockConfig& blockConfig = m_hookConfig.equipBlock; blockConfig.IsEnabled())
+    {
+        m_hasEquipBlock = blockConfig.Validate();
+        if (!m_hasEquipBlock)
+            Warning("Accessing equipment slots through DSRPlayer instead (invalid 'equipBlock').");
+    }
+
+    const TriggerTableMemory memory = m_triggers.GetMemoryUsage();
+    Info(std::format(
+        "Trigger table: {} triggers from {} distinct configs, {} chains, {} with cooldowns. {} bytes (hot {}, "
+        "conditions {}, configs {}, cooldowns {}, SpEffects {}, chains {}).",
+        m_triggers.GetCount(),
+        m_triggers.GetDefinitionCount(),
+        m_triggers.GetChainCount(),
+        m_triggers.GetCooldownRuleCount(),
+        memory.GetTotal(),
+        memory.hotBytes,
+        memory.conditionBytes,
+        memory.definitionBytes,
+        memory.cooldownBytes,
+        memory.spEffectBytes,
+        memory.chainBytes));
 }
 
 EquipmentSwapper::~EquipmentSwapper()
@@ -65,87 +129,315 @@ void EquipmentSwapper::StopThreaded()
 {
     if (!m_thread)
         throw std::runtime_error("EquipmentSwapper thread not started. Cannot stop it.");
-    m_stopFlag = true;
+    RequestStop();
     m_thread->join();
+    m_thread.reset(); // so the destructor does not try to join again
+}
+
+void EquipmentSwapper::RequestStop()
+{
+    m_stopFlag = true;
+    m_wakeSignal.Notify(); // end any wait in `Run()` immediately
+}
+
+void EquipmentSwapper::SetSpEffectEventSource(std::unique_ptr<SpEffectEventSource> source)
+{
+    if (m_thread)
+        throw std::runtime_error("Cannot set SpEffect event source while EquipmentSwapper thread is running.");
+    m_spEffectEventSource = std::move(source);
+}
+
+void EquipmentSwapper::SetFrameSource(std::unique_ptr<FrameSource> source)
+{
+    if (m_thread)
+        throw std::runtime_error("Cannot set frame source while EquipmentSwapper thread is running.");
+    m_frameSource = std::move(source);
+}
+
+bool EquipmentSwapper::PostCommand(const SwapperCommand command)
+{
+    if (!m_commands.TryPush(command))
+    {
+        m_commandsDroppedFull.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_wakeSignal.Notify();
+    return true;
 }
 
 void EquipmentSwapper::Run()
 {
-    // Do initial DSR process search.
-    std::unique_ptr<ManagedProcess> newProcess = ManagedProcess::WaitForProcess(
-        DSR_PROCESS_NAME,
-        m_config.hookConfig.processSearchTimeoutMs,
-        m_config.hookConfig.processSearchIntervalMs,
-        m_stopFlag);
+    Initialize();
 
-    if (!newProcess || m_stopFlag.load())
+    // Do initial DSR process search.
+    std::unique_ptr<ManagedProcess> newProcess = WaitForProcess();
+    if (!newProcess)
+    {
+        if (!m_stopFlag.load())
+            Error(
+                std::format(
+                    "Could not find DSR process within {} ms. Exiting...", m_hookConfig.processSearchTimeoutMs));
         return;
+    }
+    Attach(std::move(newProcess));
+
+    while (!m_stopFlag.load())
+    {
+        if (const std::optional<std::chrono::milliseconds> delay = Tick())
+        {
+            // Non-SpEffect triggers and temporary swap expiry still need a periodic check, so the delay remains an
+            // upper bound, but a SpEffect event or posted command is handled as soon as it arrives.
+            m_wakeSignal.WaitFor(*delay);
+            continue;
+        }
+
+        // Lost the process. Find a new process instance (blocking, but stoppable) and reset the hook.
+        Warning("Searching for DSR process again...");
+        newProcess = WaitForProcess();
+        if (!newProcess)
+        {
+            // Timed out (or stopped). There is no hook to monitor, so the loop must end here.
+            if (!m_stopFlag.load())
+                Error(
+                    std::format(
+                        "Could not find DSR process again within {} ms. Stopping swap trigger monitor.",
+                        m_hookConfig.processSearchTimeoutMs));
+            break;
+        }
+        Attach(std::move(newProcess));
+    }
+
+    if (m_frameSource)
+        m_frameSource->Stop();
+    if (m_spEffectEventSource)
+        m_spEffectEventSource->Stop();
+    m_log.Flush(); // lines of the last frame updates
+}
+
+void EquipmentSwapper::Attach(std::unique_ptr<ManagedProcess> process)
+{
+    Initialize();
+
+    std::lock_guard updateLock(m_updateMutex);
 
     // Our DSRHook is the sole owner of the managed process for this application.
-    m_dsrHook = make_unique<DSRHook>(std::move(newProcess));
+    ResetHook(std::move(process));
+    if (m_isMonitoring)
+        return; // re-attached after losing the process; sources and settings are kept
 
-    m_connectedPlayers = std::vector<std::pair<int, DSRPlayer>>();
+    m_isMonitoring = true;
     m_connectedPlayers.reserve(DSR_MAX_PLAYERS);
 
-    // Monitor triggers.
-    Info("Starting swap trigger monitor loop.");
-    while (true)
+    StartSpEffectEventSource();
+    StartFrameSource();
+
+    // SpEffects are polled until the event source (if any) delivers its first event. When polling, edges are
+    // computed from consecutive lists; events are already edges (one per application).
+    m_isSpEffectRisingEdge = m_hookConfig.spEffectRisingEdge && !m_hasSpEffectEvents;
+    m_slotSwapper.SetTriggerCooldownMs(m_isSpEffectRisingEdge ? 0 : m_hookConfig.spEffectTriggerCooldownMs);
+
+    Info(
+        std::format(
+            "Starting swap trigger monitor ({} triggers, {} loadouts, {} ParamID matching).",
+            m_triggers.GetCount(),
+            m_loadouts.GetCount(),
+            GetParamIDMatchPath()));
+}
+
+std::optional<std::chrono::milliseconds> EquipmentSwapper::Tick()
+{
+    // Frame updates are skipped until this update is done.
+    std::lock_guard updateLock(m_updateMutex);
+
+    // Lines of the frame updates since the last tick, before any line of this one.
+    m_log.Flush();
+
+    ProcessCommands();
+
+    if (!ValidateHook())
     {
-        if (m_stopFlag.load())
-            break;
+        // Events raised while the game is not loaded are stale by the time it is.
+        if (m_spEffectEventSource)
+            m_spEffectEvents.Clear();
+        PublishStatus();
+        if (!m_dsrHook)
+            return std::nullopt; // process lost
+        return std::chrono::milliseconds(m_hookConfig.gameLoadedIntervalMs);
+    }
 
-        if (!ValidateHook())
-            continue; // try again (appropriate sleep already done)
+    UpdateConnectedPlayers();
 
-        UpdateConnectedPlayers();
+    if (!m_connectedPlayers.empty() && m_requestTempSwapForceRevert)
+    {
+        Info("Reverting weapon/armor/ring temp swaps...");
+        m_requestTempSwapForceRevert = false;
+        ++m_metrics.tempSwapForceReverts;
+        for (const auto& [playerIndex, player] : m_connectedPlayers)
+        {
+            // Only a block already checked by an update is written directly.
+            const std::uintptr_t equipBlock = m_isEquipBlockChecked[playerIndex] ? FindPlayerEquipBlock(playerIndex) : 0;
+            m_slotSwapper.RevertTempSwaps(playerIndex, GetPlayerSlots(player, equipBlock));
+        }
+    }
 
-        if (!m_connectedPlayers.empty() && m_requestTempSwapForceRevert)
+    if (m_paused)
+    {
+        ++m_metrics.pausedTicks;
+        PublishStatus();
+        return std::chrono::milliseconds(m_monitorIntervalMs);
+    }
+
+    // In frame-hook mode, this only keeps the hook, players and commands up to date, unless frame updates are over
+    // budget or not happening.
+    if (ShouldThreadUpdate())
+        UpdatePlayers();
+
+    PublishStatus();
+    return std::chrono::milliseconds(m_monitorIntervalMs);
+}
+
+void EquipmentSwapper::UpdatePlayers()
+{
+    if (m_spEffectEventSource)
+    {
+        const std::size_t eventCount = m_spEffectEvents.DrainByPlayer(m_eventSpEffects);
+        if (!m_hasSpEffectEvents)
+            CheckSpEffectEvents(eventCount);
+    }
+
+    if (++m_metrics.ticks == 1 && m_onFirstTick)
+        m_onFirstTick();
+
+    // Once per update (not once per player), before any trigger is checked.
+    AdvanceTimers();
+
+    // Each slot that has triggers, is read by a trigger condition or has a temporary swap to track, once.
+    ReadPlayerSnapshots();
+
+    for (const auto& [playerIndex, player] : m_connectedPlayers)
+    {
+        PlayerSnapshot& snapshot = m_playerSnapshots[playerIndex];
+
+        // Get active SpEffects once for player. In event-driven mode, these are the SpEffects applied since the
+        // last iteration, so we skip reading the player's SpEffect list entirely. Conditions see these too: there is
+        // no held list without polling.
+        if (m_hasSpEffectEvents)
+        {
+            snapshot.heldSpEffects.clear();
+            snapshot.activeSpEffects = m_eventSpEffects[playerIndex];
+            snapshot.activeSpEffects.insert(
+                snapshot.activeSpEffects.end(),
+                m_retrySpEffects[playerIndex].begin(),
+                m_retrySpEffects[playerIndex].end());
+            m_retriedSpEffects[playerIndex].swap(m_retrySpEffects[playerIndex]);
+            m_retrySpEffects[playerIndex].clear();
+        }
+        else
         {
-            Info("Reverting weapon/armor/ring temp swaps...");
-            m_requestTempSwapForceRevert = false;
-            for (const auto& player : m_connectedPlayers | std::views::values)
+            const bool isComplete = ReadActiveSpEffects(playerIndex, player, snapshot);
+            if (m_isSpEffectRisingEdge)
             {
-                m_weaponSwapper.CheckTempWeaponSwaps(player, true);
-                m_armorSwapper.RevertTempArmorSwaps(player);
-                m_ringSwapper.RevertTempRingSwaps(player);
+                // Triggers only see SpEffects that were not active on the previous update. Conditions still see
+                // all of them.
+                m_spEffectDeltas.Update(
+                    playerIndex, snapshot.activeSpEffects, !isComplete, m_risingSpEffects, m_fallingSpEffects);
+                snapshot.heldSpEffects.swap(snapshot.activeSpEffects);
+                snapshot.activeSpEffects.swap(m_risingSpEffects);
             }
         }
 
-        for (const auto& [playerIndex, player] : m_connectedPlayers)
+        const PlayerSlots slots = GetPlayerSlots(player, m_equipBlocks[playerIndex]);
+
+        // Swaps that the last run left in the game, before this run's triggers touch the host's slots. The
+        // snapshot's character ID was just read along with its slots.
+        if (playerIndex == 0 && m_slotSwapper.HasJournalRecovery())
+            m_metrics.journaledSwapsReverted += m_slotSwapper.RecoverJournaledSwaps(slots, snapshot);
+
+        // Update temporary swaps by checking current weapons (we don't force-revert).
+        m_slotSwapper.RevertExpiredTempSwaps(playerIndex, slots, snapshot);
+
+        // Loadouts first, as a unit, so that triggers see the loadout's IDs. Then all slots (weapons, armor, rings)
+        // are evaluated by the same trigger table kernel.
+        m_abortedSpEffects.clear();
+        m_metrics.loadoutsApplied +=
+            m_slotSwapper.ApplyLoadouts(playerIndex, slots, snapshot, m_loadouts, m_abortedSpEffects);
+        m_metrics.swapsApplied +=
+            m_slotSwapper.CheckSwapTriggers(playerIndex, slots, snapshot, m_triggers, m_abortedSpEffects);
+        if (!m_abortedSpEffects.empty())
+            RetryAbortedSpEffects(playerIndex);
+    }
+}
+
+void EquipmentSwapper::RetryAbortedSpEffects(const int playerIndex)
+{
+    for (const int spEffectID : m_abortedSpEffects)
+    {
+        if (m_hasSpEffectEvents)
         {
-            // Get active SpEffects once for player.
-            const std::vector<int> activeSpEffects = player.GetPlayerActiveSpEffects();
-
-            // Update temporary swaps by checking current weapons (we don't force-revert).
-            m_weaponSwapper.CheckTempWeaponSwaps(player, false);
-
-            // WEAPONS: We check and replace primary AND secondary weapons per hand.
-            m_weaponSwapper.CheckHandedSwapTriggers(
-                playerIndex, player, activeSpEffects, m_leftWeaponTriggers, true);
-            m_weaponSwapper.CheckHandedSwapTriggers(
-                playerIndex, player, activeSpEffects, m_rightWeaponTriggers, false);
-
-            // ARMOR
-            m_armorSwapper.CheckArmorSwapTriggers(
-                playerIndex, player, activeSpEffects, m_headArmorTriggers, ArmorType::HEAD);
-            m_armorSwapper.CheckArmorSwapTriggers(
-                playerIndex, player, activeSpEffects, m_bodyArmorTriggers, ArmorType::BODY);
-            m_armorSwapper.CheckArmorSwapTriggers(
-                playerIndex, player, activeSpEffects, m_armsArmorTriggers, ArmorType::ARMS);
-            m_armorSwapper.CheckArmorSwapTriggers(
-                playerIndex, player, activeSpEffects, m_legsArmorTriggers, ArmorType::LEGS);
-
-            // RINGS (all slots)
-            m_ringSwapper.CheckRingSwapTriggers(
-                playerIndex, player, activeSpEffects, m_ringTriggers);
-
-            // Decrement cooldown timers for swap triggers.
-            DecrementTriggerCooldowns();
+            // Once: if the retry is not written either, the event is dropped.
+            if (std::ranges::find(m_retriedSpEffects[playerIndex], spEffectID) == m_retriedSpEffects[playerIndex].end())
+                m_retrySpEffects[playerIndex].push_back(spEffectID);
         }
+        else if (m_isSpEffectRisingEdge)
+            m_spEffectDeltas.Forget(playerIndex, spEffectID); // rises again if it is still active
+        // Otherwise (cooldown mode), the SpEffect is polled again anyway.
+    }
+}
+
+void EquipmentSwapper::OnFrame()
+{
+    // Never wait on the game thread: if the swapper thread is mid-iteration, this frame simply has no update.
+    std::unique_lock updateLock(m_updateMutex, std::try_to_lock);
+    if (!updateLock.owns_lock())
+    {
+        m_framesSkipped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // The swapper thread still handles (re)loads, pausing and force-reverts before any trigger may fire.
+    if (!m_dsrHook || !m_gameLoaded || m_paused || m_requestTempSwapForceRevert)
+        return;
+
+    const std::uint64_t startUs = NowUs();
+    if (!m_frameScheduler.ShouldRunFrame(startUs))
+        return; // over budget recently; the swapper thread is updating instead
 
-        // Sleep for refresh interval:
-        std::this_thread::sleep_for(std::chrono::milliseconds(m_config.hookConfig.monitorIntervalMs));
+    // Logging waits for the swapper thread's next `Tick()`, to keep file I/O off the game thread.
+    m_log.SetDeferred(true);
+    UpdateConnectedPlayers();
+    UpdatePlayers();
+    m_log.SetDeferred(false);
+
+    const std::uint64_t elapsedUs = NowUs() - startUs;
+    m_frameScheduler.RecordFrame(startUs, elapsedUs);
+    ++m_metrics.frameUpdates;
+    m_metrics.frameBudgetOverruns = m_frameScheduler.GetOverrunCount();
+    m_metrics.frameFallbacks = m_frameScheduler.GetFallbackCount();
+    m_metrics.maxFrameUpdateUs = m_frameScheduler.GetMaxElapsedUs();
+}
+
+bool EquipmentSwapper::ShouldThreadUpdate()
+{
+    if (!m_frameSource)
+        return true;
+
+    // Logged here rather than in `OnFrame()`, to keep file I/O off the game thread.
+    const std::uint64_t nowUs = NowUs();
+    const bool isFallback = m_frameScheduler.IsFallingBack(nowUs);
+    if (isFallback != m_wasFrameFallback)
+    {
+        m_wasFrameFallback = isFallback;
+        if (isFallback)
+            Warning(
+                std::format(
+                    "Frame updates went over the {} us budget (slowest {} us). Using the swapper thread for {} ms.",
+                    m_frameScheduler.GetBudgetUs(),
+                    m_frameScheduler.GetMaxElapsedUs(),
+                    m_frameScheduler.GetLastBackoffUs() / 1000));
+        else
+            Info("Trying frame updates again.");
     }
+    return m_frameScheduler.ShouldThreadUpdate(nowUs);
 }
 
 bool EquipmentSwapper::ValidateHook()
@@ -153,21 +445,13 @@ bool EquipmentSwapper::ValidateHook()
     if (const std::shared_ptr<ManagedProcess> dsrProcess = m_dsrHook->GetProcess();
         !dsrProcess->IsHandleValid() || dsrProcess->IsProcessTerminated())
     {
-        // Lost the process (invalid handle or terminated). We find a new process instance and reset the hook.
-
-        // Release hook of stale process (will also release process if last reference).
+        // Lost the process (invalid handle or terminated). Release hook of stale process (will also release process if
+        // last reference). Whoever drives `Tick()` finds a new process instance and calls `Attach()` again.
+        Warning("Lost DSR process handle.");
         m_dsrHook.reset();
-
-        // Find again with blocking call.
-        Warning("Lost DSR process handle. Searching again...");
-        std::unique_ptr<ManagedProcess> newProcess = ManagedProcess::WaitForProcess(
-            DSR_PROCESS_NAME,
-            m_config.hookConfig.processSearchTimeoutMs,
-            m_config.hookConfig.processSearchIntervalMs,
-            m_stopFlag);
-
-        // Pass ownership `newProcess` to a new `DSRHook` instance (sole owner).
-        m_dsrHook = make_unique<DSRHook>(std::move(newProcess));
+        m_memory.reset();
+        m_connectedPlayers.clear();
+        return false;
     }
 
     // Update `m_gameLoaded` state.
@@ -176,9 +460,8 @@ bool EquipmentSwapper::ValidateHook()
         if (m_gameLoaded)
         {
             m_gameLoaded = false;
-            Warning(std::format("Game is not loaded. Checking again every {} ms...", m_config.hookConfig.gameLoadedIntervalMs));
+            Warning(std::format("Game is not loaded. Checking again every {} ms...", m_hookConfig.gameLoadedIntervalMs));
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(m_config.hookConfig.gameLoadedIntervalMs));
         return false; // do not check triggers
     }
 
@@ -188,6 +471,11 @@ bool EquipmentSwapper::ValidateHook()
         // Game has been (re)-loaded. Any temporary weapon swaps need to be undone (forced revert).
         m_requestTempSwapForceRevert = true;
 
+        // SpEffects that are still active after the load count as new, and swaps from before it are not retried.
+        m_spEffectDeltas.ResetAll();
+        for (std::vector<int>& retrySpEffects : m_retrySpEffects)
+            retrySpEffects.clear();
+
         // NOTE: Connected players may not be immediately available.
         Info("Game is loaded. Monitoring equipment swap triggers...");
     }
@@ -195,78 +483,559 @@ bool EquipmentSwapper::ValidateHook()
     return true;
 }
 
-void EquipmentSwapper::UpdateConnectedPlayers()
+std::unique_ptr<ManagedProcess> EquipmentSwapper::WaitForProcess()
 {
-    m_connectedPlayers.clear();
+    const auto interval = std::chrono::milliseconds(m_hookConfig.processSearchIntervalMs);
+    const auto deadline = std::chrono::steady_clock::now()
+                          + std::chrono::milliseconds(m_hookConfig.processSearchTimeoutMs);
+
+    // We do the waiting between attempts ourselves, so a stop request does not have to wait out a search interval.
+    while (!m_stopFlag.load())
+    {
+        // Cheap check first. Firelink takes a full process snapshot, so it only runs once the process is there.
+        // Zero timeout: a single search attempt.
+        if (const std::optional<std::uint32_t> processID = m_processDiscovery->FindProcess())
+        {
+            if (std::unique_ptr<ManagedProcess> process = ManagedProcess::WaitForProcess(
+                    DSR_PROCESS_NAME, 0, m_hookConfig.processSearchIntervalMs, m_stopFlag))
+            {
+                Info(
+                    std::format(
+                        "Found DSR process {} ({} process names looked up by {} discovery).",
+                        *processID,
+                        m_processDiscovery->GetNameLookupCount(),
+                        m_processDiscovery->GetName()));
+                return process;
+            }
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+            break;
+        m_wakeSignal.WaitFor(
+            std::min(interval, std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now)));
+    }
+    return nullptr;
+}
 
+void EquipmentSwapper::UpdateConnectedPlayers()
+{
     const auto playerIns = m_dsrHook->PlayerIns();
     if (playerIns->IsNull())
+    {
+        m_connectedPlayers.clear();
+        m_chrSlotPlayerIns = {};
         return; // game not loaded
+    }
 
     const BasePointer chrSlotArray = playerIns->ReadPointer(
         "ChrSlotArray", PLAYER_INS::CHR_INS_NO_VTABLE + CHR_INS_NO_VTABLE::CONNECTED_PLAYERS_CHR_SLOT_ARRAY);
 
     if (chrSlotArray.IsNull())
+    {
+        m_connectedPlayers.clear();
+        m_chrSlotPlayerIns = {};
         return; // no connected players
+    }
+
+    // Read the whole ChrSlot array as one region, rather than one pointer read per slot.
+    std::array<std::byte, DSR_MAX_PLAYERS * CHR_SLOT_SIZE> chrSlots;
+    m_readPlanner.Clear();
+    m_readPlanner.Add(reinterpret_cast<std::uintptr_t>(chrSlotArray.GetAddress()), chrSlots);
+    const bool isRead = m_readPlanner.Execute(*m_memory);
+    m_metrics.directReads += m_readPlanner.GetLastReadCount();
+    if (!isRead)
+    {
+        m_log.Error("Failed to read connected players' ChrSlot array.");
+        return; // keep last known players
+    }
+
+    std::array<std::uint64_t, DSR_MAX_PLAYERS> chrSlotPlayerIns = {};
+    for (int i = 0; i < DSR_MAX_PLAYERS; ++i)
+        std::memcpy(&chrSlotPlayerIns[i], chrSlots.data() + i * CHR_SLOT_SIZE, sizeof(std::uint64_t));
+
+    if (chrSlotPlayerIns == m_chrSlotPlayerIns)
+        return; // same players in same slots; existing `DSRPlayer` wrappers are still valid
 
     for (int i = 0; i < DSR_MAX_PLAYERS; ++i)
     {
-        // Read the PlayerIns pointer for each ChrSlot (0x38 size).
-        BasePointer playerInsPtr = chrSlotArray.ReadPointer("ChrSlot", i * 0x38);
-        if (playerInsPtr.IsNull())
+        if (chrSlotPlayerIns[i] != m_chrSlotPlayerIns[i])
+        {
+            m_spEffectDeltas.Reset(i); // different player (or none) in this slot
+            m_retrySpEffects[i].clear();
+            m_isEquipBlockChecked[i] = false;
+        }
+    }
+    m_chrSlotPlayerIns = chrSlotPlayerIns;
+    m_connectedPlayers.clear();
+    for (int i = 0; i < DSR_MAX_PLAYERS; ++i)
+    {
+        if (chrSlotPlayerIns[i] == 0)
             continue; // skip if ChrSlot is null (leave as nullptr)
+        BasePointer playerInsPtr = chrSlotArray.ReadPointer("ChrSlot", i * CHR_SLOT_SIZE);
+        if (playerInsPtr.IsNull())
+            continue; // slot emptied since bulk read
         m_connectedPlayers.emplace_back(i, DSRPlayer(m_dsrHook.get(), playerInsPtr));
     }
 }
 
-void EquipmentSwapper::DecrementTriggerCooldowns()
+bool EquipmentSwapper::ReadActiveSpEffects(
+    const int playerIndex, const DSRPlayer& player, PlayerSnapshot& snapshot)
 {
-    const int interval = m_config.hookConfig.monitorIntervalMs;
-    // Decrement each timer countdown by monitor refresh interval:
-    for (SwapTrigger& trigger : m_leftWeaponTriggers)
-        trigger.DecrementAllCooldowns(interval);
-    for (SwapTrigger& trigger : m_rightWeaponTriggers)
-        trigger.DecrementAllCooldowns(interval);
-    for (SwapTrigger& trigger : m_headArmorTriggers)
-        trigger.DecrementAllCooldowns(interval);
-    for (SwapTrigger& trigger : m_bodyArmorTriggers)
-        trigger.DecrementAllCooldowns(interval);
-    for (SwapTrigger& trigger : m_armsArmorTriggers)
-        trigger.DecrementAllCooldowns(interval);
-    for (SwapTrigger& trigger : m_legsArmorTriggers)
-        trigger.DecrementAllCooldowns(interval);
-    for (SwapTrigger& trigger : m_ringTriggers)
-        trigger.DecrementAllCooldowns(interval);
+    if (!m_spEffectListReader || !m_memory)
+    {
+        snapshot.activeSpEffects = player.GetPlayerActiveSpEffects();
+        return true;
+    }
+
+    const auto playerInsAddress = static_cast<std::uintptr_t>(m_chrSlotPlayerIns[playerIndex]);
+    const bool isRead = m_spEffectListReader->Read(*m_memory, playerInsAddress, snapshot.activeSpEffects);
+    m_metrics.directReads += m_spEffectListReader->GetLastReadCount();
+    m_metrics.spEffectNodesRead += m_spEffectListReader->GetLastNodeCount();
+    if (m_spEffectListReader->WasLastTruncated())
+        ++m_metrics.spEffectListTruncations;
+    if (!isRead)
+    {
+        snapshot.activeSpEffects = player.GetPlayerActiveSpEffects(); // e.g. list changed under us; walk it instead
+        return true;
+    }
+    return !m_spEffectListReader->WasLastTruncated();
 }
 
-bool EquipmentSwapper::LoadConfig(const path& jsonConfigPath, EquipmentSwapConfig& config)
+void EquipmentSwapper::ReadPlayerSnapshots()
+{
+    // All direct reads of all players are declared first, so that regions close together (the slots of one equip
+    // block, or blocks on the same page in page-aligned mode) share a read.
+    for (const auto& [playerIndex, player] : m_connectedPlayers)
+    {
+        m_equipBlocks[playerIndex] = FindPlayerEquipBlock(playerIndex);
+        if (m_equipBlocks[playerIndex] != 0 && !m_isEquipBlockChecked[playerIndex])
+            CheckPlayerEquipBlock(playerIndex, player); // may turn direct access off for all players
+    }
+
+    m_readPlanner.Clear();
+    for (const auto& [playerIndex, player] : m_connectedPlayers)
+    {
+        const SlotMask slots = m_readSlots | m_slotSwapper.GetTempSwapSlots(playerIndex);
+        const PlayerSlots playerSlots = GetPlayerSlots(player, m_equipBlocks[playerIndex]);
+        if (playerSlots.IsDirect())
+            m_snapshotReads[playerIndex].Plan(m_readPlanner, playerSlots, slots, m_playerSnapshots[playerIndex]);
+        else
+            ReadPlayerSnapshot(playerSlots, slots, m_playerSnapshots[playerIndex]);
+    }
+    if (m_readPlanner.GetRequestCount() == 0)
+        return;
+
+    m_readPlanner.Execute(*m_memory);
+    m_metrics.directReads += m_readPlanner.GetLastReadCount();
+    for (const auto& [playerIndex, player] : m_connectedPlayers)
+    {
+        const PlayerSlots playerSlots = GetPlayerSlots(player, m_equipBlocks[playerIndex]);
+        if (playerSlots.IsDirect())
+            m_snapshotReads[playerIndex].Finish(m_readPlanner, playerSlots, m_playerSnapshots[playerIndex]);
+    }
+}
+
+std::uintptr_t EquipmentSwapper::FindPlayerEquipBlock(const int playerIndex) const
+{
+    if (!m_hasEquipBlock || !m_memory)
+        return 0;
+
+    // Found again on every update: a few reads next to the slot reads it saves, and never stale.
+    const auto playerInsAddress = static_cast<std::uintptr_t>(m_chrSlotPlayerIns[playerIndex]);
+    return FindEquipBlock(*m_memory, m_hookConfig.equipBlock, playerInsAddress);
+}
+
+void EquipmentSwapper::CheckPlayerEquipBlock(const int playerIndex, const DSRPlayer& player)
+{
+    // A layout for another game version would read (and write) unrelated memory, so it is checked against DSRPlayer
+    // before any direct access.
+    std::string mismatch;
+    if (CheckEquipBlock(GetPlayerSlots(player, m_equipBlocks[playerIndex]), mismatch))
+    {
+        m_isEquipBlockChecked[playerIndex] = true;
+        return;
+    }
+    m_log.Warning(
+        std::format(
+            "'equipBlock' does not match this game version ({}). Accessing equipment slots through DSRPlayer instead.",
+            mismatch));
+    m_hasEquipBlock = false;
+    m_equipBlocks = {};
+}
+
+PlayerSlots EquipmentSwapper::GetPlayerSlots(const DSRPlayer& player, const std::uintptr_t equipBlock) const
+{
+    if (equipBlock == 0)
+        return PlayerSlots(player);
+    return PlayerSlots(player, *m_memory, m_hookConfig.equipBlock, equipBlock);
+}
+
+void EquipmentSwapper::ResetHook(std::unique_ptr<ManagedProcess> process)
+{
+    m_dsrHook = make_unique<DSRHook>(std::move(process));
+    m_memory.emplace(m_dsrHook->GetProcess()->GetHandle());
+    m_chrSlotPlayerIns = {};
+    m_connectedPlayers.clear();
+}
+
+void EquipmentSwapper::AdvanceTimers()
+{
+    // Cooldowns and timed swaps run on elapsed time, so a slow update does not stretch them. Edge-triggered
+    // SpEffects never start a cooldown, so their wheels stay empty and advancing them is free.
+    m_triggers.ExpireCooldowns();
+    m_loadouts.ExpireCooldowns();
+    m_slotSwapper.ExpireTimedSwaps();
+}
+
+void EquipmentSwapper::Initialize()
+{
+    if (m_isInitialized)
+        return;
+    m_isInitialized = true;
+    CreateStatusPage();
+    PublishStatus(); // not loaded yet
+    OpenSwapJournal();
+}
+
+void EquipmentSwapper::CreateStatusPage()
+{
+    if (m_hookConfig.statusPageName.empty() || m_statusPage)
+        return;
+
+    m_statusPage = SharedStatusPage::Create(m_hookConfig.statusPageName);
+    if (!m_statusPage)
+        Error(std::format("Failed to create status page '{}'.", m_hookConfig.statusPageName));
+    else
+        Info(std::format("Publishing swapper status to shared-memory page '{}'.", m_hookConfig.statusPageName));
+}
+
+void EquipmentSwapper::OpenSwapJournal()
+{
+    if (m_hookConfig.swapJournalPath.empty() || m_journal)
+        return;
+
+    m_journal = SwapJournal::Open(m_hookConfig.swapJournalPath);
+    if (!m_journal)
+    {
+        Error(
+            std::format(
+                "Failed to open swap journal '{}'. Temporary swaps will not survive a crash.",
+                m_hookConfig.swapJournalPath));
+        return;
+    }
+    Info(std::format("Journaling temporary swaps to '{}'.", m_hookConfig.swapJournalPath));
+    if (!m_hasEquipBlock || m_hookConfig.equipBlock.nameOffset < 0)
+    {
+        // Reverting a journaled swap on the wrong character would write its ID into another save.
+        Warning(
+            "Swaps can only be journaled and recovered with the character's name ('equipBlock.nameOffset'). Swaps "
+            "left in the journal are kept, but not reverted.");
+    }
+    m_slotSwapper.SetJournal(m_journal.get());
+}
+
+void EquipmentSwapper::PublishStatus()
+{
+    static_assert(STATUS_PAGE_MAX_PLAYERS == DSR_MAX_PLAYERS, "Status page layout must cover all players.");
+
+    if (!m_statusPage)
+        return;
+
+    const auto now = std::chrono::steady_clock::now();
+    const std::int64_t nowUs = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+
+    SwapperStatus& status = m_status;
+    ++status.tick;
+    status.publishTimeUs = nowUs;
+    status.gameLoaded = m_dsrHook != nullptr && m_gameLoaded;
+    status.paused = m_paused;
+    status.connectedPlayerMask = 0;
+    for (const int playerIndex : m_connectedPlayers | std::views::keys)
+        status.connectedPlayerMask |= static_cast<std::uint8_t>(1 << playerIndex);
+    status.monitorIntervalMs = m_monitorIntervalMs;
+
+    for (int playerIndex = 0; playerIndex < DSR_MAX_PLAYERS; ++playerIndex)
+    {
+        for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+        {
+            const std::optional<TempSwap>& swap =
+                m_slotSwapper.GetTempSwap(playerIndex, static_cast<EquipSlot>(slotIndex));
+            status.tempSwaps[playerIndex][slotIndex] = swap
+                ? StatusTempSwap{1, swap->sourceParamID, swap->destParamID}
+                : StatusTempSwap{0, 0, 0};
+        }
+    }
+
+    // Cooldowns are stored as remaining time, so convert to deadlines on the shared clock.
+    std::uint32_t triggerCount = 0;
+    for (; triggerCount < m_triggers.GetCount() && triggerCount < STATUS_PAGE_MAX_TRIGGERS; ++triggerCount)
+    {
+        for (int playerIndex = 0; playerIndex < DSR_MAX_PLAYERS; ++playerIndex)
+        {
+            const int cooldownMs = m_triggers.GetCooldown(triggerCount, playerIndex);
+            status.cooldownDeadlinesUs[triggerCount][playerIndex] = cooldownMs > 0 ? nowUs + cooldownMs * 1000LL : 0;
+        }
+    }
+    status.triggerCount = triggerCount;
+
+    status.ticks = m_metrics.ticks;
+    status.pausedTicks = m_metrics.pausedTicks;
+    status.swapsApplied = m_metrics.swapsApplied;
+    status.tempSwapForceReverts = m_metrics.tempSwapForceReverts;
+    status.commandsProcessed = m_metrics.commandsProcessed;
+    status.commandsRejected = m_metrics.commandsRejected;
+    status.spEffectEventsDropped = m_spEffectEvents.GetDroppedCount();
+
+    m_statusPage->Publish(status);
+}
+
+void EquipmentSwapper::ProcessCommands()
+{
+    while (const std::optional<SwapperCommand> command = m_commands.TryPop())
+    {
+        ++m_metrics.commandsProcessed;
+        const std::string name = SwapperCommandTypeToString(command->type);
+        switch (command->type)
+        {
+            case SwapperCommandType::FORCE_REVERT_TEMP_SWAPS:
+                Info("Command: force-reverting all temporary swaps.");
+                m_requestTempSwapForceRevert = true;
+                break;
+            case SwapperCommandType::PAUSE:
+                Info("Command: pausing swap trigger monitor.");
+                m_paused = true;
+                break;
+            case SwapperCommandType::RESUME:
+                Info("Command: resuming swap trigger monitor.");
+                m_paused = false;
+                break;
+            case SwapperCommandType::SET_MONITOR_INTERVAL:
+                if (command->value < 1)
+                {
+                    Error(std::format("Command {} rejected: invalid interval {} ms.", name, command->value));
+                    ++m_metrics.commandsRejected;
+                    break;
+                }
+                Info(
+                    std::format(
+                        "Command: monitor interval changed from {} ms to {} ms.", m_monitorIntervalMs, command->value));
+                m_monitorIntervalMs = command->value;
+                break;
+            case SwapperCommandType::DUMP_METRICS:
+                m_metrics.spEffectEventsDropped = m_spEffectEvents.GetDroppedCount();
+                m_metrics.framesSkipped = m_framesSkipped.load(std::memory_order_relaxed);
+                m_metrics.slotWritePreRaces = m_slotSwapper.GetWriteRaceStats().preWriteRaces;
+                m_metrics.slotWritePostRaces = m_slotSwapper.GetWriteRaceStats().postWriteRaces;
+                m_metrics.slotWriteRetries = m_slotSwapper.GetWriteRaceStats().retries;
+                Info(
+                    std::format(
+                        "Metrics: {} commandsDroppedFull={}",
+                        m_metrics.ToString(),
+                        m_commandsDroppedFull.load(std::memory_order_relaxed)));
+                break;
+            case SwapperCommandType::ENABLE_TRIGGER_GROUP:
+            case SwapperCommandType::DISABLE_TRIGGER_GROUP:
+                if (command->value < 0 || command->value >= MAX_TRIGGER_GROUPS)
+                {
+                    Error(std::format("Command {} rejected: invalid trigger group {}.", name, command->value));
+                    ++m_metrics.commandsRejected;
+                    break;
+                }
+                SetTriggerGroupEnabled(command->value, command->type == SwapperCommandType::ENABLE_TRIGGER_GROUP);
+                break;
+            default:
+                Error(std::format("Unknown command type {} rejected.", static_cast<int>(command->type)));
+                ++m_metrics.commandsRejected;
+                break;
+        }
+    }
+}
+
+void EquipmentSwapper::SetTriggerGroupEnabled(const int group, const bool enabled)
+{
+    const int count = m_triggers.SetGroupEnabled(group, enabled) + m_loadouts.SetGroupEnabled(group, enabled);
+    Info(
+        std::format(
+            "Command: {} trigger group {} ({} triggers, chains and loadouts).",
+            enabled ? "enabled" : "disabled",
+            group,
+            count));
+}
+
+void EquipmentSwapper::StartSpEffectEventSource()
+{
+    if (!m_hookConfig.eventDrivenSpEffects)
+    {
+        m_spEffectEventSource.reset();
+        return;
+    }
+
+    if (!m_spEffectEventSource)
+    {
+        Warning("Event-driven SpEffect detection is enabled, but no event source is available. Polling instead.");
+        return;
+    }
+
+    if (!m_spEffectEventSource->Start(m_spEffectEvents))
+    {
+        Warning(
+            std::format(
+                "Failed to start '{}' SpEffect event source. Polling active SpEffects instead.",
+                m_spEffectEventSource->GetName()));
+        m_spEffectEventSource.reset();
+        return;
+    }
+
+    // Starting only means the source is installed: nothing tells whether anything will ever push to it.
+    Info(
+        std::format(
+            "Started '{}' SpEffect event source. Polling active SpEffects until its first event.",
+            m_spEffectEventSource->GetName()));
+}
+
+void EquipmentSwapper::CheckSpEffectEvents(const std::size_t eventCount)
 {
+    if (eventCount == 0)
+    {
+        const std::uint64_t nowUs = NowUs();
+        if (m_spEffectEventWaitStartUs == 0)
+            m_spEffectEventWaitStartUs = nowUs;
+        else if (!m_isSpEffectEventWaitLogged && nowUs - m_spEffectEventWaitStartUs > SPEFFECT_EVENT_WAIT_US)
+        {
+            m_isSpEffectEventWaitLogged = true;
+            m_log.Warning(
+                std::format(
+                    "No events from '{}' SpEffect event source after {} s. Is anything calling "
+                    "DSREquipmentSwap_PushSpEffectApplied()? Still polling active SpEffects.",
+                    m_spEffectEventSource->GetName(),
+                    SPEFFECT_EVENT_WAIT_US / 1'000'000));
+        }
+        return;
+    }
+
+    // Switch to events for good. This update's events are used right away; polling state is no longer needed.
+    m_hasSpEffectEvents = true;
+    m_isSpEffectRisingEdge = false;
+    m_slotSwapper.SetTriggerCooldownMs(m_hookConfig.spEffectTriggerCooldownMs);
+    m_spEffectDeltas.ResetAll();
+    for (PlayerSnapshot& snapshot : m_playerSnapshots)
+        snapshot.heldSpEffects.clear(); // last polled list, no longer updated
+    m_log.Info(
+        std::format(
+            "Received first event from '{}' SpEffect event source. No longer polling active SpEffects.",
+            m_spEffectEventSource->GetName()));
+}
+
+void EquipmentSwapper::StartFrameSource()
+{
+    if (!m_hookConfig.frameHookMode)
+    {
+        m_frameSource.reset();
+        return;
+    }
+
+    if (!m_frameSource)
+    {
+        Warning("Frame-hook mode is enabled, but no frame source is available. Updating on the swapper thread instead.");
+        return;
+    }
+
+    if (!m_frameSource->Start([this] { OnFrame(); }))
+    {
+        Warning(
+            std::format(
+                "Failed to start '{}' frame source. Updating on the swapper thread instead.", m_frameSource->GetName()));
+        m_frameSource.reset();
+        return;
+    }
 
-    std::ifstream ifs(jsonConfigPath);
-    const nlohmann::json configJson = nlohmann::json::parse(ifs);
+    Info(
+        std::format(
+            "Using '{}' frame source for swap updates ({} us budget per frame).",
+            m_frameSource->GetName(),
+            m_frameScheduler.GetBudgetUs()));
+}
 
-    try
+bool EquipmentSwapper::LoadConfig(const path& jsonConfigPath, EquipmentSwapConfig& config)
+{
+
+    // Binary, so stream positions are byte offsets for progress.
+    std::ifstream ifs(jsonConfigPath, std::ios::binary);
+    if (!ifs)
     {
-        DSREquipmentSwap::from_json(configJson, config);
+        Error(std::format("Failed to open JSON file: {}", jsonConfigPath.string()));
+        return false;
     }
-    catch (nlohmann::json::exception& e)
+
+    // Progress of large (e.g. generated) files is logged every 10%.
+    std::error_code sizeError;
+    const std::uintmax_t fileSize = std::filesystem::file_size(jsonConfigPath, sizeError);
+    const bool isProgressLogged = !sizeError && fileSize >= CONFIG_PROGRESS_MIN_BYTES;
+    std::uint64_t loggedPercent = 0;
+    const auto progress = [&](const std::uint64_t bytesRead)
+    {
+        const std::uint64_t percent = bytesRead * 100 / fileSize / 10 * 10;
+        if (percent <= loggedPercent)
+            return;
+        loggedPercent = percent;
+        Info(std::format("Reading config: {}% ({} of {} KiB)", percent, bytesRead / 1024, fileSize / 1024));
+    };
+
+    // Streamed: invalid triggers, chains and loadouts are dropped (with an error each) rather than failing the whole
+    // config.
+    const auto start = std::chrono::steady_clock::now();
+    ConfigReadStats stats;
+    std::string error;
+    if (!ReadConfig(ifs, config, stats, error, isProgressLogged ? ConfigReadProgress(progress) : ConfigReadProgress()))
     {
-        Error(std::format("Failed to parse JSON file: {}. Error: {}", jsonConfigPath.string(), e.what()));
+        Error(std::format("Failed to parse JSON file: {}. Error: {}", jsonConfigPath.string(), error));
         return false;
     }
-    Info(std::format("Loaded settings and weapon swap triggers from file: {}", jsonConfigPath.string()));
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    Info(
+        std::format(
+            "Read {} triggers, {} swap chains and {} loadouts in {} ms ({} invalid entries dropped).",
+            stats.triggerCount,
+            stats.chainCount,
+            stats.loadoutCount,
+            elapsed.count(),
+            stats.droppedCount));
+
+    LogConfig(config, std::format("file: {}", jsonConfigPath.string()));
+    return true;
+}
+
+void EquipmentSwapper::LogConfig(const EquipmentSwapConfig& config, const std::string& source)
+{
+    Info(std::format("Loaded settings and weapon swap triggers from {}", source));
     Info(std::format("Process search timeout: {} ms", config.hookConfig.processSearchTimeoutMs));
     Info(std::format("Process search interval: {} ms", config.hookConfig.processSearchIntervalMs));
+    Info(
+        std::format(
+            "Max processes: {} ({} worker threads, 0 == auto)",
+            config.hookConfig.maxProcesses,
+            config.hookConfig.workerThreads));
     Info(std::format("Monitor interval: {} ms", config.hookConfig.monitorIntervalMs));
     Info(std::format("Game loaded interval: {} ms", config.hookConfig.gameLoadedIntervalMs));
     Info(std::format("SpEffect trigger cooldown: {} ms", config.hookConfig.spEffectTriggerCooldownMs));
-    LogTriggers(config.leftWeaponTriggers, "Left-Hand Weapon Trigger");
-    LogTriggers(config.rightWeaponTriggers, "Right-Hand Weapon Trigger");
-    LogTriggers(config.headArmorTriggers, "Head Armor Trigger");
-    LogTriggers(config.bodyArmorTriggers, "Body Armor Trigger");
-    LogTriggers(config.armsArmorTriggers, "Arms Armor Trigger");
-    LogTriggers(config.legsArmorTriggers, "Legs Armor Trigger");
-    LogTriggers(config.ringTriggers, "Ring Trigger");
-
-    return true;
+    Info(std::format("Rising-edge SpEffects: {}", config.hookConfig.spEffectRisingEdge));
+    Info(std::format("Event-driven SpEffects: {}", config.hookConfig.eventDrivenSpEffects));
+    Info(
+        std::format(
+            "Frame-hook mode: {} ({} us budget)", config.hookConfig.frameHookMode, config.hookConfig.frameBudgetUs));
+    Info(std::format("Page-aligned reads: {}", config.hookConfig.pageAlignedReads));
+    Info(std::format("Direct equip block access: {}", config.hookConfig.equipBlock.IsEnabled()));
+    Info(
+        std::format(
+            "Swap journal: '{}' (character names: {})",
+            config.hookConfig.swapJournalPath,
+            config.hookConfig.equipBlock.IsEnabled() && config.hookConfig.equipBlock.nameOffset >= 0));
+    for (const TriggerCategory& category : TRIGGER_CATEGORIES)
+        LogTriggers(config.*category.triggers, std::string(category.logPrefix));
+    for (const SwapChainConfig& chain : config.swapChains)
+        Info(std::format("Swap Chain ({}) -- {}", chain.category, chain.ToString()));
+    for (const LoadoutConfig& loadout : config.loadouts)
+        Info(std::format("Loadout -- {}", loadout.ToString()));
 }
\ No newline at end of file
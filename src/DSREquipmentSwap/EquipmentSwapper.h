@@ -1,18 +1,38 @@
 #pragma once
 
-#include <DSREquipmentSwap/Armor.h>
 #include <DSREquipmentSwap/Config.h>
-#include <DSREquipmentSwap/Ring.h>
-#include <DSREquipmentSwap/SwapTrigger.h>
-#include <DSREquipmentSwap/Weapon.h>
+#include <DSREquipmentSwap/DeferredLog.h>
+#include <DSREquipmentSwap/FrameSource.h>
+#include <DSREquipmentSwap/LoadoutTable.h>
+#include <DSREquipmentSwap/MemoryBackend.h>
+#include <DSREquipmentSwap/MpscQueue.h>
+#include <DSREquipmentSwap/ProcessDiscovery.h>
+#include <DSREquipmentSwap/ReadPlanner.h>
+#include <DSREquipmentSwap/Slots.h>
+#include <DSREquipmentSwap/SlotSwapper.h>
+#include <DSREquipmentSwap/SpEffectDeltas.h>
+#include <DSREquipmentSwap/SpEffectEvents.h>
+#include <DSREquipmentSwap/SpEffectListReader.h>
+#include <DSREquipmentSwap/StatusPage.h>
+#include <DSREquipmentSwap/SwapJournal.h>
+#include <DSREquipmentSwap/SwapperCommands.h>
+#include <DSREquipmentSwap/SwapperMetrics.h>
+#include <DSREquipmentSwap/TriggerTable.h>
+#include <DSREquipmentSwap/WakeSignal.h>
 
 #include <FirelinkDSRHook/DSRHook.h>
 #include <FirelinkDSRHook/DSRPlayer.h>
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
 #include <thread>
 #include <utility>
 
@@ -34,45 +54,214 @@ namespace DSREquipmentSwap
         /// @brief Enable thread-stopping flag and join (wait for) thread.
         void StopThreaded();
 
-        /// @brief Main loop of equipment swapper.
+        /// @brief Enable thread-stopping flag without waiting, so `Run()` returns soon. Safe to call from any thread.
+        void RequestStop();
+
+        /// @brief Main loop of equipment swapper: finds the DSR process, then calls `Tick()` until stopped, finding the
+        /// process again whenever it is lost.
         void Run();
 
+        /// @brief Hook `process`, which the caller found (e.g. one of several game instances). Also starts monitoring on
+        /// the first call. Must not be called while `Tick()` is running.
+        void Attach(std::unique_ptr<Firelink::ManagedProcess> process);
+
+        /// @brief Run one update of the swapper loop without waiting: commands, hook and load state, connected players
+        /// and triggers. Returns how long to wait before the next update, or nullopt if the process was lost (call
+        /// `Attach()` with a new one before the next update).
+        std::optional<std::chrono::milliseconds> Tick();
+
+        /// @brief Provide a source of SpEffect application events, used instead of polling when
+        /// `hookConfig.eventDrivenSpEffects` is enabled. Must be called before `Run()`/`StartThreaded()`.
+        void SetSpEffectEventSource(std::unique_ptr<SpEffectEventSource> source);
+
+        /// @brief Provide a source of game frames, used to evaluate swaps on the game's frame tick when
+        /// `hookConfig.frameHookMode` is enabled. Must be called before `Run()`/`StartThreaded()`.
+        void SetFrameSource(std::unique_ptr<FrameSource> source);
+
+        /// @brief Call `callback` (on the updating thread) at the first update that checks triggers, e.g. to measure
+        /// startup time. Must be called before `Run()`/`StartThreaded()`.
+        void SetFirstTickCallback(std::function<void()> callback) { m_onFirstTick = std::move(callback); }
+
+        /// @brief Post a runtime command. Safe to call from any thread; the command is applied at the top of the next
+        /// loop iteration (which it also wakes). Returns false if the command queue is full.
+        bool PostCommand(SwapperCommand command);
+
         /// @brief Read and return config from JSON.
         static bool LoadConfig(const std::filesystem::path& jsonConfigPath, EquipmentSwapConfig& config);
 
+        /// @brief Log settings and all triggers of `config`, which was loaded from `source`.
+        static void LogConfig(const EquipmentSwapConfig& config, const std::string& source);
+
     private:
         /// @brief List of connected players (`PlayerIns` wrappers) in the game. Updated on every loop iteration.
         std::vector<std::pair<int, FirelinkDSR::DSRPlayer>> m_connectedPlayers;
 
-        const EquipmentSwapConfig m_config;
+        const HookConfig m_hookConfig; // triggers and loadouts are only kept by their tables
         std::optional<std::thread> m_thread = std::nullopt;
         std::atomic<bool> m_stopFlag = false;
         std::unique_ptr<FirelinkDSR::DSRHook> m_dsrHook; // owns the process hook
+        std::optional<MemoryBackend> m_memory; // direct reads of hooked process (reset with `m_dsrHook`)
+        std::unique_ptr<ProcessDiscovery> m_processDiscovery; // cheap `WaitForProcess()` attempts (kept across searches)
+
+        // PlayerIns address in each ChrSlot at last `UpdateConnectedPlayers()`. Players are only rebuilt on change.
+        std::array<std::uint64_t, DSR_MAX_PLAYERS> m_chrSlotPlayerIns = {};
+
+        // Event-driven SpEffect detection (optional). `m_spEffectEventSource` is only kept once it has started, and
+        // SpEffects are still polled until it delivers its first event (an installed source may never be called).
+        WakeSignal m_wakeSignal;
+        SpEffectEventQueue m_spEffectEvents{m_wakeSignal};
+        std::unique_ptr<SpEffectEventSource> m_spEffectEventSource;
+        std::array<std::vector<int>, DSR_MAX_PLAYERS> m_eventSpEffects = {}; // drained once per loop iteration
+        bool m_hasSpEffectEvents = false;             // first event received: polling stopped
+        std::uint64_t m_spEffectEventWaitStartUs = 0; // first update without events (0 before)
+        bool m_isSpEffectEventWaitLogged = false;
 
-        WeaponSwapper m_weaponSwapper;
-        ArmorSwapper m_armorSwapper;
-        RingSwapper m_ringSwapper;
+        // Direct slot reads and writes (optional), if `hookConfig.equipBlock` is configured and valid.
+        bool m_hasEquipBlock = false;
+        std::array<std::uintptr_t, DSR_MAX_PLAYERS> m_equipBlocks = {}; // found by each update (0 == none)
+        std::array<bool, DSR_MAX_PLAYERS> m_isEquipBlockChecked = {};   // matched DSRPlayer (reset per PlayerIns)
+        std::array<PlannedSnapshotRead, DSR_MAX_PLAYERS> m_snapshotReads = {};
 
-        // Lists of configured state-managed swap triggers.
-        std::vector<SwapTrigger> m_leftWeaponTriggers = {};
-        std::vector<SwapTrigger> m_rightWeaponTriggers = {};
-        std::vector<SwapTrigger> m_headArmorTriggers = {};
-        std::vector<SwapTrigger> m_bodyArmorTriggers = {};
-        std::vector<SwapTrigger> m_armsArmorTriggers = {};
-        std::vector<SwapTrigger> m_legsArmorTriggers = {};
-        std::vector<SwapTrigger> m_ringTriggers = {};
+        // Direct SpEffect list reads (optional). Used when polling, if `hookConfig.spEffectList` is configured.
+        std::optional<SpEffectListReader> m_spEffectListReader;
 
-        bool m_gameLoaded = true; // assume true to start
+        // Rising-edge SpEffect detection (polling mode with `hookConfig.spEffectRisingEdge`). Replaces cooldowns.
+        bool m_isSpEffectRisingEdge = false; // until the event source (if any) delivers its first event
+        SpEffectDeltaTracker m_spEffectDeltas;
+        std::vector<int> m_risingSpEffects;  // reused each update
+        std::vector<int> m_fallingSpEffects; // reused each update
+
+        // SpEffects whose swap or loadout was not written this update (reused), and, in event-driven mode, those to
+        // check once more on the next update (an event is not repeated, unlike a polled SpEffect that is still active).
+        std::vector<int> m_abortedSpEffects;
+        std::array<std::vector<int>, DSR_MAX_PLAYERS> m_retrySpEffects = {};
+        std::array<std::vector<int>, DSR_MAX_PLAYERS> m_retriedSpEffects = {}; // retried this update (only once)
+
+        // Frame-hook mode (optional). `m_frameSource` is only kept once it has started. Updates run on the game's frame
+        // tick while `m_frameScheduler` allows it, and on the swapper thread otherwise.
+        std::unique_ptr<FrameSource> m_frameSource;
+        FrameScheduler m_frameScheduler;
+        bool m_wasFrameFallback = false;                 // last fallback state logged by the swapper thread
+        std::atomic<std::uint64_t> m_framesSkipped = 0; // counted without the update lock
+
+        // Held for each swapper loop iteration and each frame update, so the two never overlap. The game thread only
+        // ever tries to take it, and skips the frame if the swapper thread has it.
+        std::mutex m_updateMutex;
+
+        // Runtime control channel. Any thread may post; only the swapper thread drains.
+        MpscQueue<SwapperCommand, 64> m_commands;
+        std::atomic<std::uint64_t> m_commandsDroppedFull = 0;
+        SwapperMetrics m_metrics;
+        int m_monitorIntervalMs; // initialized from config; may be changed by command
+        bool m_paused = false;
+        std::function<void()> m_onFirstTick; // optional
+
+        // Shared-memory status page for external tools (optional).
+        std::unique_ptr<SharedStatusPage> m_statusPage;
+        SwapperStatus m_status = {}; // reused staging copy
+
+        // Log of swap updates, queued while an update runs on the game's frame tick. Declared before `m_slotSwapper`,
+        // which writes to it.
+        DeferredLog m_log;
+
+        // Crash-safe record of temporary swaps (optional). Declared before `m_slotSwapper`, which writes to it.
+        std::unique_ptr<SwapJournal> m_journal;
+
+        // All configured state-managed swap triggers, grouped by equipment slot.
+        TriggerTable m_triggers;
+        LoadoutTable m_loadouts;
+        SlotMask m_triggeredSlots; // slots with at least one trigger or loadout target (read every update)
+        SlotMask m_readSlots;      // `m_triggeredSlots` plus the slots that trigger conditions read
+        ReadPlanner m_readPlanner; // direct reads of one update (reused)
+        SlotSwapper m_slotSwapper;
+        std::array<PlayerSnapshot, DSR_MAX_PLAYERS> m_playerSnapshots = {}; // reused each update
+
+        bool m_isInitialized = false; // status page and journal opened (once)
+        bool m_isMonitoring = false;  // first process attached
+        bool m_gameLoaded = true;     // assume true to start
         bool m_requestTempSwapForceRevert = false; // executed when 1+ connected players are next detected
 
-        /// @brief Called on each loop update to ensure the hooked process is still valid and running.
+        /// @brief Called on each update to ensure the hooked process is still valid and running, and the game loaded.
+        /// Returns false if triggers should not be checked this update. If the process is lost, also drops the hook.
         bool ValidateHook();
 
+        /// @brief Search for the DSR process every `processSearchIntervalMs` until found, `processSearchTimeoutMs`
+        /// elapses, or a stop is requested. Returns nullptr in the latter two cases.
+        ///
+        /// @details Each attempt is a `m_processDiscovery` check. The full Firelink search (which opens the handle) only
+        /// runs once discovery has seen the process.
+        std::unique_ptr<Firelink::ManagedProcess> WaitForProcess();
+
         /// @brief Collect all connected players' `PlayerIns` pointers (up to 4).
         /// Of course, the first will point right back to the parent host PlayerIns.
         void UpdateConnectedPlayers();
 
-        /// @brief Decrement trigger cooldown timers.
-        void DecrementTriggerCooldowns();
+        /// @brief Replace the hooked process (sole owner) and the memory backend that reads it.
+        void ResetHook(std::unique_ptr<Firelink::ManagedProcess> process);
+
+        /// @brief Check the triggers of every connected player once: SpEffects, snapshots, temporary swap expiry,
+        /// loadouts and triggers. Called by the swapper loop, or by `OnFrame()` in frame-hook mode.
+        void UpdatePlayers();
+
+        /// @brief Frame callback (game thread): run one update within the frame budget, unless the swapper thread is
+        /// updating, the game is not ready, or updates are falling back to the thread.
+        void OnFrame();
+
+        /// @brief Start `m_frameSource` if frame-hook mode is enabled. Drops the source if it fails.
+        void StartFrameSource();
+
+        /// @brief True if the swapper loop must run the update itself this iteration (no frame updates happening).
+        [[nodiscard]] bool ShouldThreadUpdate();
+
+        /// @brief Expire trigger and loadout cooldowns and timed temporary swaps that are due.
+        void AdvanceTimers();
+
+        /// @brief Replace `snapshot.activeSpEffects` with the current active SpEffects of `player` (polling mode).
+        /// Returns false if the list was cut short.
+        bool ReadActiveSpEffects(int playerIndex, const FirelinkDSR::DSRPlayer& player, PlayerSnapshot& snapshot);
+
+        /// @brief Read the slots of every connected player into its snapshot (see `ReadPlayerSnapshot()`), with
+        /// the direct reads of all players made together through `m_readPlanner`. Sets `m_equipBlocks`.
+        void ReadPlayerSnapshots();
+
+        /// @brief Address of the equip block of the player in ChrSlot `playerIndex`, or 0 if there is none (or
+        /// `hookConfig.equipBlock` is not configured).
+        [[nodiscard]] std::uintptr_t FindPlayerEquipBlock(int playerIndex) const;
+
+        /// @brief Check the equip block of a player whose block has not been checked yet against `player` (see
+        /// `CheckEquipBlock()`). On a mismatch, turn direct slot access off for the rest of the session.
+        void CheckPlayerEquipBlock(int playerIndex, const FirelinkDSR::DSRPlayer& player);
+
+        /// @brief Slot access for `player`: direct, in `equipBlock`, unless it is 0; through `player` otherwise.
+        [[nodiscard]] PlayerSlots GetPlayerSlots(const FirelinkDSR::DSRPlayer& player, std::uintptr_t equipBlock) const;
+
+        /// @brief Let the SpEffects in `m_abortedSpEffects` fire the triggers and loadouts of `playerIndex` again on
+        /// the next update (their cooldowns were already cancelled).
+        void RetryAbortedSpEffects(int playerIndex);
+
+        /// @brief Start `m_spEffectEventSource` if event-driven mode is enabled. Drops the source if it fails.
+        void StartSpEffectEventSource();
+
+        /// @brief While polling for lack of SpEffect events, switch to events once `eventCount` (drained this update)
+        /// is non-zero. Logs a warning once if none have arrived for a while.
+        void CheckSpEffectEvents(std::size_t eventCount);
+
+        /// @brief Create the status page and open the swap journal, once, before the first process is attached.
+        void Initialize();
+
+        /// @brief Create the shared-memory status page if `hookConfig.statusPageName` is set.
+        void CreateStatusPage();
+
+        /// @brief Open the swap journal if `hookConfig.swapJournalPath` is set, and hand it to `m_slotSwapper`.
+        void OpenSwapJournal();
+
+        /// @brief Publish current state to the status page (if any). Called once per loop iteration.
+        void PublishStatus();
+
+        /// @brief Apply all posted commands. Called at the top of each loop iteration.
+        void ProcessCommands();
+
+        /// @brief Enable or disable every trigger, chain and loadout in the given group.
+        void SetTriggerGroupEnabled(int group, bool enabled);
     };
 } // namespace DSREquipmentSwap
@@ -0,0 +1,85 @@
+#include "FrameSource.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace DSREquipmentSwap;
+
+FrameScheduler::FrameScheduler(
+    const std::uint64_t budgetUs,
+    const std::uint32_t overrunLimit,
+    const std::uint64_t initialBackoffUs,
+    const std::uint64_t maxBackoffUs,
+    const std::uint64_t stallUs)
+    : m_budgetUs(budgetUs)
+    , m_overrunLimit(std::max<std::uint32_t>(overrunLimit, 1))
+    , m_initialBackoffUs(initialBackoffUs)
+    , m_maxBackoffUs(std::max(maxBackoffUs, initialBackoffUs))
+    , m_stallUs(stallUs)
+    , m_nextBackoffUs(initialBackoffUs)
+    , m_lastBackoffUs(initialBackoffUs)
+{}
+
+void FrameScheduler::RecordFrame(const std::uint64_t startUs, const std::uint64_t elapsedUs)
+{
+    ++m_frameCount;
+    m_hasFrame = true;
+    m_lastFrameUs = startUs + elapsedUs;
+    m_maxElapsedUs = std::max(m_maxElapsedUs, elapsedUs);
+
+    if (elapsedUs <= m_budgetUs)
+    {
+        m_overrunsInRow = 0;
+        if (++m_framesWithinBudget >= BACKOFF_RESET_FRAMES)
+            m_nextBackoffUs = m_initialBackoffUs; // healthy again: forget past fallbacks
+        return;
+    }
+
+    ++m_overrunCount;
+    m_framesWithinBudget = 0;
+    if (++m_overrunsInRow < m_overrunLimit)
+        return; // a single slow frame (e.g. a hitch in the game itself) is not enough
+
+    // Over budget too often: hand evaluation to the thread, and wait longer each time before trying frames again.
+    m_overrunsInRow = 0;
+    ++m_fallbackCount;
+    m_lastBackoffUs = m_nextBackoffUs;
+    m_fallbackEndUs = m_lastFrameUs + m_nextBackoffUs;
+    m_nextBackoffUs = std::min(m_nextBackoffUs * 2, m_maxBackoffUs);
+}
+
+bool FrameScheduler::ShouldThreadUpdate(const std::uint64_t nowUs) const
+{
+    if (IsFallingBack(nowUs))
+        return true;
+    // Frames that would run by now but did not: the game is not calling us (the thread must not wait on it).
+    return !m_hasFrame || nowUs - std::min(nowUs, m_lastFrameUs) > m_stallUs;
+}
+
+std::atomic<ExternalFrameSource*> ExternalFrameSource::s_activeSource = nullptr;
+std::atomic<int> ExternalFrameSource::s_framesInFlight = 0;
+
+bool ExternalFrameSource::Start(std::function<void()> onFrame)
+{
+    m_onFrame = std::move(onFrame);
+    ExternalFrameSource* expected = nullptr;
+    return s_activeSource.compare_exchange_strong(expected, this);
+}
+
+void ExternalFrameSource::Stop()
+{
+    ExternalFrameSource* expected = this;
+    s_activeSource.compare_exchange_strong(expected, nullptr);
+    while (s_framesInFlight.load() > 0)
+        std::this_thread::yield();
+}
+
+bool ExternalFrameSource::NotifyFrame()
+{
+    s_framesInFlight.fetch_add(1);
+    ExternalFrameSource* source = s_activeSource.load();
+    if (source != nullptr)
+        source->m_onFrame();
+    s_framesInFlight.fetch_sub(1);
+    return source != nullptr;
+}
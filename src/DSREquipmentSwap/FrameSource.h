@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Decides, frame by frame, whether swaps are evaluated on the game's frame tick or on the swapper thread,
+    /// and enforces the per-frame time budget.
+    ///
+    /// @details Pure bookkeeping over times passed in by the caller (in microseconds of any monotonic clock), so every
+    /// decision can be stepped through without a game or a real clock. A frame update cannot be interrupted, so the
+    /// budget is enforced after the fact: `overrunLimit` frames in a row over `budgetUs` switch evaluation to the
+    /// thread for a backoff period, which doubles (up to `maxBackoffUs`) each time frame updates go over budget again
+    /// and is reset by `BACKOFF_RESET_FRAMES` frames in a row within budget. The thread also takes over whenever no
+    /// frame has been run for `stallUs` (e.g. on a loading screen, or if the frame source is never called).
+    class FrameScheduler
+    {
+    public:
+        /// @brief Frames in a row within budget that reset the backoff to its initial length.
+        static constexpr std::uint32_t BACKOFF_RESET_FRAMES = 600;
+
+        explicit FrameScheduler(
+            std::uint64_t budgetUs = 1000,
+            std::uint32_t overrunLimit = 3,
+            std::uint64_t initialBackoffUs = 5'000'000,
+            std::uint64_t maxBackoffUs = 300'000'000,
+            std::uint64_t stallUs = 500'000);
+
+        /// @brief True if a frame starting at `nowUs` should run an update (false while falling back to the thread).
+        [[nodiscard]] bool ShouldRunFrame(std::uint64_t nowUs) const { return !IsFallingBack(nowUs); }
+
+        /// @brief Record a frame update that started at `startUs` and took `elapsedUs`.
+        void RecordFrame(std::uint64_t startUs, std::uint64_t elapsedUs);
+
+        /// @brief True if the swapper thread should run the update at `nowUs`: frame updates are over budget, or
+        /// frames have stalled (or never started).
+        [[nodiscard]] bool ShouldThreadUpdate(std::uint64_t nowUs) const;
+
+        /// @brief True if frame updates are suspended at `nowUs` because they went over budget.
+        [[nodiscard]] bool IsFallingBack(const std::uint64_t nowUs) const { return nowUs < m_fallbackEndUs; }
+
+        [[nodiscard]] std::uint64_t GetBudgetUs() const { return m_budgetUs; }
+
+        /// @brief Length of the last fallback period (or of the next one, if there has been none yet).
+        [[nodiscard]] std::uint64_t GetLastBackoffUs() const { return m_lastBackoffUs; }
+
+        [[nodiscard]] std::uint64_t GetFrameCount() const { return m_frameCount; }
+        [[nodiscard]] std::uint64_t GetOverrunCount() const { return m_overrunCount; }
+        [[nodiscard]] std::uint64_t GetFallbackCount() const { return m_fallbackCount; }
+        [[nodiscard]] std::uint64_t GetMaxElapsedUs() const { return m_maxElapsedUs; }
+
+    private:
+        std::uint64_t m_budgetUs;
+        std::uint32_t m_overrunLimit;
+        std::uint64_t m_initialBackoffUs;
+        std::uint64_t m_maxBackoffUs;
+        std::uint64_t m_stallUs;
+
+        std::uint64_t m_nextBackoffUs;
+        std::uint64_t m_lastBackoffUs;
+        std::uint64_t m_fallbackEndUs = 0;
+        bool m_hasFrame = false;
+        std::uint64_t m_lastFrameUs = 0;
+        std::uint32_t m_overrunsInRow = 0;
+        std::uint32_t m_framesWithinBudget = 0;
+
+        std::uint64_t m_frameCount = 0;
+        std::uint64_t m_overrunCount = 0;
+        std::uint64_t m_fallbackCount = 0;
+        std::uint64_t m_maxElapsedUs = 0;
+    };
+
+    /// @brief Interface for anything that can call the swapper once per game frame, on the game's own thread, instead
+    /// of the swapper sampling the game from its own thread at any point of a frame.
+    class FrameSource
+    {
+    public:
+        virtual ~FrameSource() = default;
+
+        /// @brief Begin calling `onFrame` once per frame. Returns false if the source could not be installed, in which
+        /// case the swapper keeps updating on its own thread.
+        virtual bool Start(std::function<void()> onFrame) = 0;
+
+        /// @brief Stop calling `onFrame`. No call is in progress, and none is made, after this returns.
+        virtual void Stop() = 0;
+
+        [[nodiscard]] virtual std::string GetName() const = 0;
+    };
+
+    /// @brief Frame source fed through a single process-wide entry point, `NotifyFrame()`.
+    ///
+    /// @details The DLL exports this entry point so that a detour on the game's main update (or another mod that
+    /// already has one) can forward each frame to us. Only one instance may be started at a time.
+    class ExternalFrameSource final : public FrameSource
+    {
+    public:
+        bool Start(std::function<void()> onFrame) override;
+        void Stop() override;
+        [[nodiscard]] std::string GetName() const override { return "External"; }
+
+        /// @brief Run the started source's frame callback, if any, on the calling thread. Returns false if nothing is
+        /// listening.
+        static bool NotifyFrame();
+
+    private:
+        std::function<void()> m_onFrame;
+
+        static std::atomic<ExternalFrameSource*> s_activeSource;
+        static std::atomic<int> s_framesInFlight; // lets `Stop()` wait out a frame still running the callback
+    };
+} // namespace DSREquipmentSwap
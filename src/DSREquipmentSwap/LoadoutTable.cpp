@@ -0,0 +1,84 @@
+#include "LoadoutTable.h"
+
+#include <algorithm>
+
+using namespace DSREquipmentSwap;
+
+LoadoutTable::LoadoutTable(const EquipmentSwapConfig& config, const TimerClock& clock)
+{
+    for (const LoadoutConfig& loadoutConfig : config.loadouts)
+    {
+        if (!loadoutConfig.Validate())
+            continue;
+
+        Loadout loadout;
+        for (const LoadoutTargetConfig& target : loadoutConfig.targets)
+        {
+            const auto slotIndex = static_cast<int>(*FindEquipSlot(target.slot));
+            loadout.slots.set(slotIndex);
+            loadout.paramIDs[slotIndex] = target.paramID;
+        }
+        m_loadouts.push_back(loadout);
+        m_configs.push_back(loadoutConfig);
+        m_disabled.push_back(false);
+    }
+    m_cooldowns = TimerWheel(m_loadouts.size() * DSR_MAX_PLAYERS, clock);
+}
+
+SlotMask LoadoutTable::GetTargetSlots() const
+{
+    SlotMask slots;
+    for (const Loadout& loadout : m_loadouts)
+        slots |= loadout.slots;
+    return slots;
+}
+
+void LoadoutTable::AppendSpEffectIDs(std::vector<int>& ids) const
+{
+    for (const LoadoutConfig& config : m_configs)
+        ids.push_back(config.spEffectIDTrigger);
+}
+
+int LoadoutTable::SetGroupEnabled(const int group, const bool enabled)
+{
+    int count = 0;
+    for (std::uint32_t i = 0; i < GetCount(); ++i)
+    {
+        if (m_configs[i].group != group)
+            continue;
+        m_disabled[i] = !enabled;
+        ++count;
+    }
+    return count;
+}
+
+void LoadoutTable::Evaluate(
+    const int playerIndex, const PlayerSnapshot& snapshot, const int cooldownMs, std::vector<std::uint32_t>& fired)
+{
+    fired.clear();
+
+    // Loadouts are few (a handful per mod), so a linear check of the active SpEffects is enough.
+    for (std::uint32_t i = 0; i < GetCount(); ++i)
+    {
+        const std::uint32_t cooldownKey = i * DSR_MAX_PLAYERS + static_cast<std::uint32_t>(playerIndex);
+        if (m_disabled[i] || m_cooldowns.IsScheduled(cooldownKey))
+            continue;
+        if (std::ranges::find(snapshot.activeSpEffects, m_configs[i].spEffectIDTrigger)
+            == snapshot.activeSpEffects.end())
+            continue;
+
+        const Loadout& loadout = m_loadouts[i];
+        bool isEquipped = true;
+        for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+        {
+            if (loadout.slots.test(slotIndex) && snapshot.paramIDs[slotIndex] != loadout.paramIDs[slotIndex])
+                isEquipped = false;
+        }
+        if (isEquipped)
+            continue; // nothing to write
+
+        if (cooldownMs > 0)
+            m_cooldowns.Schedule(cooldownKey, static_cast<std::uint64_t>(cooldownMs));
+        fired.push_back(i);
+    }
+}
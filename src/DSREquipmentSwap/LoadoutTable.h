@@ -0,0 +1,70 @@
+#pragma once
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/Slots.h>
+#include <DSREquipmentSwap/TimerWheel.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief A loadout resolved to slots: `paramIDs[slot]` is only meaningful for slots in `slots`.
+    struct Loadout
+    {
+        SlotMask slots;
+        std::array<int, EQUIP_SLOT_COUNT> paramIDs = {};
+    };
+
+    /// @brief All configured loadouts (`LoadoutConfig`), with per-player cooldowns and runtime group state.
+    ///
+    /// @details Kept separate from `TriggerTable`, which evaluates slots one at a time: a loadout has one condition for
+    /// many slots and must be checked (and written) as a unit.
+    class LoadoutTable
+    {
+    public:
+        LoadoutTable() = default;
+
+        /// @brief Build from `config.loadouts`. Loadouts that fail validation are skipped. Cooldowns run on `clock`.
+        explicit LoadoutTable(const EquipmentSwapConfig& config, const TimerClock& clock = SteadyTimerClock::Get());
+
+        [[nodiscard]] std::uint32_t GetCount() const { return static_cast<std::uint32_t>(m_loadouts.size()); }
+
+        [[nodiscard]] const Loadout& GetLoadout(const std::uint32_t index) const { return m_loadouts[index]; }
+
+        /// @brief Get the original config of loadout `index` (for logging).
+        [[nodiscard]] const LoadoutConfig& GetConfig(const std::uint32_t index) const { return m_configs[index]; }
+
+        /// @brief Get the set of slots targeted by any loadout.
+        [[nodiscard]] SlotMask GetTargetSlots() const;
+
+        /// @brief Append the SpEffect ID of every loadout (unsorted, with repeats and "no SpEffect" values) to `ids`.
+        void AppendSpEffectIDs(std::vector<int>& ids) const;
+
+        /// @brief End every loadout cooldown that has run out (by the clock given at construction).
+        void ExpireCooldowns() { m_cooldowns.Advance(m_expiredCooldowns); }
+
+        /// @brief End the cooldown that `Evaluate()` started for loadout `index` and `playerIndex`, e.g. because the
+        /// loadout was not written, so it can fire again on the next update.
+        void CancelCooldown(const std::uint32_t index, const int playerIndex)
+        {
+            m_cooldowns.Cancel(index * DSR_MAX_PLAYERS + static_cast<std::uint32_t>(playerIndex));
+        }
+
+        /// @brief Enable or disable all loadouts in `group`. Returns the number changed.
+        int SetGroupEnabled(int group, bool enabled);
+
+        /// @brief Find every enabled loadout whose SpEffect is active in `snapshot` and that is not already fully
+        /// equipped, put it on cooldown for `playerIndex`, and append its index to `fired` (cleared first).
+        void Evaluate(
+            int playerIndex, const PlayerSnapshot& snapshot, int cooldownMs, std::vector<std::uint32_t>& fired);
+
+    private:
+        std::vector<Loadout> m_loadouts;
+        std::vector<LoadoutConfig> m_configs;
+        std::vector<bool> m_disabled;
+        TimerWheel m_cooldowns; // key: loadout index * `DSR_MAX_PLAYERS` + player index
+        std::vector<std::uint32_t> m_expiredCooldowns; // reused by `ExpireCooldowns()`
+    };
+} // namespace DSREquipmentSwap
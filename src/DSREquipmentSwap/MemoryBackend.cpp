@@ -0,0 +1,112 @@
+#include "MemoryBackend.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/uio.h>
+#endif
+
+using namespace DSREquipmentSwap;
+
+namespace
+{
+#if defined(_WIN32) && !defined(_MSC_VER)
+    /// @brief Check that every page in `[address, address + size)` is committed with the given protection flags.
+    bool IsRangeAccessible(const std::uintptr_t address, const std::size_t size, const DWORD protectMask)
+    {
+        std::uintptr_t current = address;
+        const std::uintptr_t end = address + size;
+        while (current < end)
+        {
+            MEMORY_BASIC_INFORMATION info;
+            if (VirtualQuery(reinterpret_cast<LPCVOID>(current), &info, sizeof(info)) == 0)
+                return false;
+            if (info.State != MEM_COMMIT || (info.Protect & protectMask) == 0 || (info.Protect & PAGE_GUARD) != 0)
+                return false;
+            current = reinterpret_cast<std::uintptr_t>(info.BaseAddress) + info.RegionSize;
+        }
+        return true;
+    }
+
+    constexpr DWORD READABLE = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ
+                               | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+    constexpr DWORD WRITABLE = PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+#endif
+
+    /// @brief Guarded copy. SEH blocks cannot live in functions with unwindable objects, hence the separate function.
+    bool GuardedCopy(void* dest, const void* source, const std::size_t size)
+    {
+#if defined(_MSC_VER)
+        __try
+        {
+            std::memcpy(dest, source, size);
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER)
+        {
+            return false;
+        }
+        return true;
+#else
+        std::memcpy(dest, source, size);
+        return true;
+#endif
+    }
+} // namespace
+
+bool InProcessMemory::Read(const std::uintptr_t address, void* buffer, const std::size_t size) const
+{
+    if (address == 0)
+        return false;
+#if defined(_WIN32) && !defined(_MSC_VER)
+    if (!IsRangeAccessible(address, size, READABLE))
+        return false;
+#endif
+    return GuardedCopy(buffer, reinterpret_cast<const void*>(address), size);
+}
+
+bool InProcessMemory::Write(const std::uintptr_t address, const void* buffer, const std::size_t size) const
+{
+    if (address == 0)
+        return false;
+#if defined(_WIN32) && !defined(_MSC_VER)
+    if (!IsRangeAccessible(address, size, WRITABLE))
+        return false;
+#endif
+    return GuardedCopy(reinterpret_cast<void*>(address), buffer, size);
+}
+
+bool RemoteMemory::Read(const std::uintptr_t address, void* buffer, const std::size_t size) const
+{
+    if (address == 0)
+        return false;
+#ifdef _WIN32
+    SIZE_T bytesRead = 0;
+    return ReadProcessMemory(m_processHandle, reinterpret_cast<LPCVOID>(address), buffer, size, &bytesRead)
+           && bytesRead == size;
+#else
+    const iovec local{buffer, size};
+    const iovec remote{reinterpret_cast<void*>(address), size};
+    const auto pid = static_cast<pid_t>(reinterpret_cast<std::intptr_t>(m_processHandle));
+    return process_vm_readv(pid, &local, 1, &remote, 1, 0) == static_cast<ssize_t>(size);
+#endif
+}
+
+bool RemoteMemory::Write(const std::uintptr_t address, const void* buffer, const std::size_t size) const
+{
+    if (address == 0)
+        return false;
+#ifdef _WIN32
+    SIZE_T bytesWritten = 0;
+    return WriteProcessMemory(m_processHandle, reinterpret_cast<LPVOID>(address), buffer, size, &bytesWritten)
+           && bytesWritten == size;
+#else
+    const iovec local{const_cast<void*>(buffer), size};
+    const iovec remote{reinterpret_cast<void*>(address), size};
+    const auto pid = static_cast<pid_t>(reinterpret_cast<std::intptr_t>(m_processHandle));
+    return process_vm_writev(pid, &local, 1, &remote, 1, 0) == static_cast<ssize_t>(size);
+#endif
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Reads and writes game memory directly, from inside the game process (DLL build).
+    ///
+    /// @details Every access is a plain copy guarded by SEH (MSVC) or a page protection check, so a stale pointer
+    /// returns false instead of crashing the game. The process handle is ignored; it is only accepted so that both
+    /// backends can be constructed the same way.
+    class InProcessMemory
+    {
+    public:
+        explicit InProcessMemory(void* /* processHandle */) {}
+
+        /// @brief Copy `size` bytes at `address` into `buffer`. Returns false if the memory is not readable.
+        bool Read(std::uintptr_t address, void* buffer, std::size_t size) const;
+
+        /// @brief Copy `size` bytes from `buffer` to `address`. Returns false if the memory is not writable.
+        bool Write(std::uintptr_t address, const void* buffer, std::size_t size) const;
+
+        template <typename T>
+        bool Read(const std::uintptr_t address, T& value) const
+        {
+            return Read(address, &value, sizeof(T));
+        }
+
+        template <typename T>
+        bool Write(const std::uintptr_t address, const T& value) const
+        {
+            return Write(address, &value, sizeof(T));
+        }
+    };
+
+    /// @brief Reads and writes memory of another process through its handle (EXE build).
+    class RemoteMemory
+    {
+    public:
+        explicit RemoteMemory(void* processHandle)
+            : m_processHandle(processHandle)
+        {}
+
+        /// @brief Copy `size` bytes at remote `address` into `buffer`. Returns false on a failed or partial read.
+        bool Read(std::uintptr_t address, void* buffer, std::size_t size) const;
+
+        /// @brief Copy `size` bytes from `buffer` to remote `address`. Returns false on a failed or partial write.
+        bool Write(std::uintptr_t address, const void* buffer, std::size_t size) const;
+
+        template <typename T>
+        bool Read(const std::uintptr_t address, T& value) const
+        {
+            return Read(address, &value, sizeof(T));
+        }
+
+        template <typename T>
+        bool Write(const std::uintptr_t address, const T& value) const
+        {
+            return Write(address, &value, sizeof(T));
+        }
+
+    private:
+        void* m_processHandle; // `HANDLE` on Windows; process ID elsewhere (for testing)
+    };
+
+    // Memory access backend is chosen at compile time: the DLL lives inside the game and never needs a syscall.
+#ifdef DSR_EQUIPMENT_SWAP_IN_PROCESS
+    using MemoryBackend = InProcessMemory;
+#else
+    using MemoryBackend = RemoteMemory;
+#endif
+} // namespace DSREquipmentSwap
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Bounded lock-free queue with any number of producers and exactly one consumer.
+    ///
+    /// @details Each cell carries a sequence number (Vyukov-style bounded queue). Producers claim a cell with a CAS on
+    /// the tail and publish it by advancing the cell's sequence. Only one thread may call `TryPop()`, so the head needs
+    /// no atomics. `TryPush()` never blocks or allocates and simply fails when the queue is full, which makes it safe to
+    /// call from game threads. `Capacity` must be a power of two.
+    template <typename T, std::size_t Capacity>
+    class MpscQueue
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MpscQueue capacity must be a power of two.");
+
+    public:
+        MpscQueue()
+        {
+            for (std::size_t i = 0; i < Capacity; ++i)
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        /// @brief Push `item` if there is room. Safe to call from any thread. Returns false if the queue is full.
+        bool TryPush(T item)
+        {
+            std::size_t position = m_tail.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Cell& cell = m_cells[position & MASK];
+                const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+                if (difference == 0)
+                {
+                    if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        cell.value = std::move(item);
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                    // CAS failure reloaded `position`; try again.
+                }
+                else if (difference < 0)
+                {
+                    return false; // full
+                }
+                else
+                {
+                    position = m_tail.load(std::memory_order_relaxed); // another producer claimed this cell
+                }
+            }
+        }
+
+        /// @brief Pop the oldest item, if any. Must only be called from the single consumer thread.
+        std::optional<T> TryPop()
+        {
+            Cell& cell = m_cells[m_head & MASK];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(m_head + 1) < 0)
+                return std::nullopt; // empty (or next cell not yet published)
+
+            T item = std::move(cell.value);
+            cell.sequence.store(m_head + Capacity, std::memory_order_release);
+            ++m_head;
+            return item;
+        }
+
+        [[nodiscard]] static constexpr std::size_t GetCapacity() { return Capacity; }
+
+    private:
+        static constexpr std::size_t MASK = Capacity - 1;
+
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence;
+            T value{};
+        };
+
+        std::array<Cell, Capacity> m_cells;
+        alignas(64) std::atomic<std::size_t> m_tail = 0;
+        alignas(64) std::size_t m_head = 0; // consumer only
+    };
+} // namespace DSREquipmentSwap
@@ -0,0 +1,219 @@
+#include "MultiProcessSwapper.h"
+
+#include <Firelink/Logging.h>
+#include <Firelink/Process.h>
+#include <FirelinkDSRHook/DSRHook.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+using namespace Firelink;
+using namespace DSREquipmentSwap;
+
+namespace
+{
+    /// @brief Open process `processID` for a hook. Firelink's own search only ever finds the first process by name.
+    std::unique_ptr<ManagedProcess> OpenProcessByID(const std::uint32_t processID)
+    {
+#ifdef _WIN32
+        const HANDLE handle = OpenProcess(PROCESS_ALL_ACCESS, FALSE, processID);
+        if (handle == nullptr)
+            return nullptr;
+        return std::make_unique<ManagedProcess>(processID, handle);
+#else
+        // No process handles: `RemoteMemory` takes the process ID in its place.
+        return std::make_unique<ManagedProcess>(processID, reinterpret_cast<HANDLE>(std::uintptr_t{processID}));
+#endif
+    }
+
+    /// @brief `hookConfig.workerThreads`, or one per process up to the number of hardware threads if 0.
+    int GetPoolWorkerCount(const HookConfig& hookConfig)
+    {
+        if (hookConfig.workerThreads > 0)
+            return hookConfig.workerThreads;
+        const int hardwareThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+        return std::clamp(hookConfig.maxProcesses, 1, hardwareThreads);
+    }
+} // namespace
+
+MultiProcessSwapper::MultiProcessSwapper(EquipmentSwapConfig config)
+    : m_config(std::move(config))
+    , m_processDiscovery(CreateProcessDiscovery(DSR_PROCESS_NAME))
+    , m_openProcess(OpenProcessByID)
+    , m_pool(GetPoolWorkerCount(m_config.hookConfig))
+{}
+
+MultiProcessSwapper::~MultiProcessSwapper()
+{
+    m_pool.Stop();
+}
+
+void MultiProcessSwapper::RequestStop()
+{
+    m_stopFlag = true;
+    m_wakeSignal.Notify();
+}
+
+void MultiProcessSwapper::SetProcessDiscovery(std::unique_ptr<ProcessDiscovery> discovery)
+{
+    m_processDiscovery = std::move(discovery);
+}
+
+void MultiProcessSwapper::SetProcessOpener(ProcessOpener opener)
+{
+    m_openProcess = std::move(opener);
+}
+
+void MultiProcessSwapper::Run()
+{
+    Info(
+        std::format(
+            "Multi-process mode: hooking up to {} DSR processes, updated by {} worker threads.",
+            m_config.hookConfig.maxProcesses,
+            m_pool.GetWorkerCount()));
+
+    const auto interval = std::chrono::milliseconds(m_config.hookConfig.processSearchIntervalMs);
+    const auto timeout = std::chrono::milliseconds(m_config.hookConfig.processSearchTimeoutMs);
+    auto lastAttachedTime = std::chrono::steady_clock::now();
+    while (!m_stopFlag.load())
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (AttachNewProcesses() > 0)
+            lastAttachedTime = now;
+        else if (now - lastAttachedTime >= timeout)
+        {
+            Error(
+                std::format("No DSR process hooked for {} ms. Exiting...", m_config.hookConfig.processSearchTimeoutMs));
+            break;
+        }
+        m_wakeSignal.WaitFor(interval);
+    }
+
+    m_pool.Stop();
+    const TickPoolStats stats = m_pool.GetStats();
+    Info(
+        std::format(
+            "Stopped {} swapper instances ({} updates, scheduling delay {} us on average, {} us at most).",
+            m_instances.size(),
+            stats.ticks,
+            stats.ticks > 0 ? stats.totalLatenessUs / stats.ticks : 0,
+            stats.maxLatenessUs));
+}
+
+int MultiProcessSwapper::AttachNewProcesses()
+{
+    m_processDiscovery->FindProcesses(m_foundProcessIDs);
+    const auto isFound = [this](const std::uint32_t processID)
+    { return std::ranges::find(m_foundProcessIDs, processID) != m_foundProcessIDs.end(); };
+
+    // A lost process is not attached again while it is still listed (e.g. still shutting down). Once it is gone, its
+    // process ID may be reused by a new game instance.
+    for (const std::unique_ptr<Instance>& instance : m_instances)
+    {
+        if (!instance->isAttached.load() && instance->processID && !isFound(*instance->processID))
+            instance->processID.reset();
+    }
+
+    std::size_t ignoredCount = 0;
+    for (const std::uint32_t processID : m_foundProcessIDs)
+    {
+        if (std::ranges::any_of(m_instances, [processID](const std::unique_ptr<Instance>& instance)
+                                { return instance->processID == processID; }))
+            continue;
+
+        Instance* instance = GetFreeInstance();
+        if (!instance)
+        {
+            ++ignoredCount;
+            continue;
+        }
+
+        // Claimed even if it cannot be opened, so a process we may not open is not retried (and logged) every search.
+        instance->processID = processID;
+        std::unique_ptr<ManagedProcess> process = m_openProcess(processID);
+        if (!process)
+        {
+            Error(std::format("Could not open DSR process {} for instance {}.", processID, instance->index));
+            continue;
+        }
+
+        instance->swapper->Attach(std::move(process));
+        instance->isAttached.store(true);
+        Info(std::format("Instance {} hooked DSR process {}.", instance->index, processID));
+
+        m_pool.Add(
+            [instance]() -> std::optional<std::chrono::milliseconds>
+            {
+                const std::optional<std::chrono::milliseconds> delay = instance->swapper->Tick();
+                if (!delay)
+                {
+                    // Hand the instance back to `AttachNewProcesses()`. Nothing else touches it until then.
+                    Warning(
+                        std::format(
+                            "Instance {} lost DSR process {}. Waiting for a new process.",
+                            instance->index,
+                            *instance->processID));
+                    instance->isAttached.store(false);
+                }
+                return delay;
+            });
+    }
+
+    if (ignoredCount != m_ignoredProcessCount)
+    {
+        m_ignoredProcessCount = ignoredCount;
+        if (ignoredCount > 0)
+            Warning(
+                std::format(
+                    "All {} instances are in use. Not hooking {} more DSR processes.",
+                    m_instances.size(),
+                    ignoredCount));
+    }
+
+    return static_cast<int>(std::ranges::count_if(
+        m_instances, [](const std::unique_ptr<Instance>& instance) { return instance->isAttached.load(); }));
+}
+
+MultiProcessSwapper::Instance* MultiProcessSwapper::GetFreeInstance()
+{
+    for (const std::unique_ptr<Instance>& instance : m_instances)
+    {
+        if (!instance->isAttached.load() && !instance->processID)
+            return instance.get();
+    }
+    if (static_cast<int>(m_instances.size()) >= std::max(m_config.hookConfig.maxProcesses, 1))
+        return nullptr;
+
+    const auto index = static_cast<int>(m_instances.size());
+    const std::unique_ptr<Instance>& instance = m_instances.emplace_back(std::make_unique<Instance>());
+    instance->index = index;
+    instance->swapper = std::make_unique<EquipmentSwapper>(GetInstanceConfig(index));
+    return instance.get();
+}
+
+EquipmentSwapConfig MultiProcessSwapper::GetInstanceConfig(const int index) const
+{
+    EquipmentSwapConfig config = m_config;
+    if (index == 0)
+        return config; // same names as single-process mode
+
+    HookConfig& hook = config.hookConfig;
+    if (!hook.statusPageName.empty())
+        hook.statusPageName += std::format("-{}", index);
+    if (!hook.swapJournalPath.empty())
+    {
+        // "DSREquipmentSwap.journal" -> "DSREquipmentSwap-1.journal"
+        std::filesystem::path path(hook.swapJournalPath);
+        path.replace_filename(
+            std::format("{}-{}{}", path.stem().string(), index, path.extension().string()));
+        hook.swapJournalPath = path.string();
+    }
+    return config;
+}
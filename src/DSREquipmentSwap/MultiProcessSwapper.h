@@ -0,0 +1,84 @@
+#pragma once
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/EquipmentSwapper.h>
+#include <DSREquipmentSwap/ProcessDiscovery.h>
+#include <DSREquipmentSwap/TickPool.h>
+#include <DSREquipmentSwap/WakeSignal.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Hooks every running DSR process (up to `hookConfig.maxProcesses`) with its own `EquipmentSwapper`, for
+    /// test rigs that run several game instances on one machine (EXE build only).
+    ///
+    /// @details Each instance has its own swapper, hook and state (status page and swap journal names get the
+    /// instance index appended). Instead of one thread per swapper, all of them are updated by a shared `TickPool`,
+    /// each on its own schedule (`monitorIntervalMs`, or `gameLoadedIntervalMs` while its game is not loaded).
+    ///
+    /// `Run()` searches for processes every `processSearchIntervalMs`. A process that has no instance yet is attached to
+    /// the first instance that lost its own process (keeping that instance's temporary swaps and journal), or to a new
+    /// instance. When an instance's process is lost, only that instance stops updating until it is given a new process.
+    class MultiProcessSwapper
+    {
+    public:
+        /// @brief Opens a found process for a hook. Returns nullptr if it cannot be opened.
+        using ProcessOpener = std::function<std::unique_ptr<Firelink::ManagedProcess>(std::uint32_t processID)>;
+
+        explicit MultiProcessSwapper(EquipmentSwapConfig config);
+
+        /// @brief Stops the worker pool before the swappers it updates are destroyed.
+        ~MultiProcessSwapper();
+
+        /// @brief Discover and attach processes until stopped, or until no process has been hooked for
+        /// `processSearchTimeoutMs`.
+        void Run();
+
+        /// @brief Make `Run()` return soon. Safe to call from any thread.
+        void RequestStop();
+
+        /// @brief Replace how processes are found (default: `CreateProcessDiscovery()`). Call before `Run()`.
+        void SetProcessDiscovery(std::unique_ptr<ProcessDiscovery> discovery);
+
+        /// @brief Replace how found processes are opened (default: `OpenProcess()` on Windows; elsewhere, the process
+        /// ID stands in for the handle, as `RemoteMemory` expects). Call before `Run()`.
+        void SetProcessOpener(ProcessOpener opener);
+
+    private:
+        /// @brief One game process and its swapper.
+        struct Instance
+        {
+            int index;
+            std::unique_ptr<EquipmentSwapper> swapper;
+            std::optional<std::uint32_t> processID; // last process attached; kept after it is lost until it exits
+            std::atomic<bool> isAttached = false;   // cleared by the worker whose update found the process lost
+        };
+
+        const EquipmentSwapConfig m_config;
+        std::unique_ptr<ProcessDiscovery> m_processDiscovery;
+        ProcessOpener m_openProcess;
+        std::vector<std::unique_ptr<Instance>> m_instances; // never shrinks; instances are reused
+        std::vector<std::uint32_t> m_foundProcessIDs;       // reused by `AttachNewProcesses()`
+        std::size_t m_ignoredProcessCount = 0;              // processes without a free instance at the last search
+        std::atomic<bool> m_stopFlag = false;
+        WakeSignal m_wakeSignal;
+        TickPool m_pool; // declared last, so it is stopped before anything its ticks use is destroyed
+
+        /// @brief Find all running processes once and attach each one that has no instance yet. Returns the number of
+        /// instances attached after this.
+        int AttachNewProcesses();
+
+        /// @brief Get an instance for a new process: the first one without a process, or a new one if there is still
+        /// room. Returns nullptr if all `maxProcesses` instances are attached.
+        Instance* GetFreeInstance();
+
+        /// @brief Copy of the config for instance `index`, with its own status page and swap journal.
+        [[nodiscard]] EquipmentSwapConfig GetInstanceConfig(int index) const;
+    };
+} // namespace DSREquipmentSwap
@@ -0,0 +1,77 @@
+#include "ParamIDMatch.h"
+
+#if defined(__AVX2__)
+#define DSR_PARAM_ID_MATCH_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DSR_PARAM_ID_MATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+#include <bit>
+
+using namespace DSREquipmentSwap;
+
+namespace
+{
+    std::size_t FindParamIDMatchScalar(
+        const std::int32_t* mins,
+        const std::int32_t* maxes,
+        std::size_t start,
+        const std::size_t count,
+        const std::int32_t paramID)
+    {
+        for (; start < count; ++start)
+        {
+            if (mins[start] <= paramID && paramID <= maxes[start])
+                return start;
+        }
+        return count;
+    }
+}
+
+std::size_t DSREquipmentSwap::FindParamIDMatch(
+    const std::int32_t* mins, const std::int32_t* maxes, const std::size_t count, const std::int32_t paramID)
+{
+    std::size_t i = 0;
+
+    // A lane matches unless `min > paramID` or `paramID > max`. Signed compares are fine: IDs and the open-range
+    // sentinels (INT32_MIN/INT32_MAX) are all ordinary int32 values.
+#if defined(DSR_PARAM_ID_MATCH_AVX2)
+    const __m256i value = _mm256_set1_epi32(paramID);
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i min = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mins + i));
+        const __m256i max = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(maxes + i));
+        const __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(min, value), _mm256_cmpgt_epi32(value, max));
+        const auto insideMask = static_cast<unsigned>(~_mm256_movemask_ps(_mm256_castsi256_ps(outside)) & 0xFF);
+        if (insideMask != 0)
+            return i + std::countr_zero(insideMask);
+    }
+#elif defined(DSR_PARAM_ID_MATCH_SSE2)
+    const __m128i value = _mm_set1_epi32(paramID);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i min = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mins + i));
+        const __m128i max = _mm_loadu_si128(reinterpret_cast<const __m128i*>(maxes + i));
+        const __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(min, value), _mm_cmpgt_epi32(value, max));
+        const auto insideMask = static_cast<unsigned>(~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF);
+        if (insideMask != 0)
+            return i + std::countr_zero(insideMask);
+    }
+#endif
+
+    // Remaining tail (or everything, without SIMD).
+    return FindParamIDMatchScalar(mins, maxes, i, count, paramID);
+}
+
+const char* DSREquipmentSwap::GetParamIDMatchPath()
+{
+#if defined(DSR_PARAM_ID_MATCH_AVX2)
+    return "AVX2";
+#elif defined(DSR_PARAM_ID_MATCH_SSE2)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Find the first index `i` in `[0, count)` with `mins[i] <= paramID <= maxes[i]`. Returns `count` if there
+    /// is no match.
+    ///
+    /// @details This is the inner loop of trigger evaluation for configs with many range triggers per slot. Compares
+    /// eight ranges at a time with AVX2 (when built with `DSR_EQUIPMENT_SWAP_AVX2`), four at a time with SSE2 on any
+    /// other x86 target, and one at a time otherwise. All paths return the same result.
+    [[nodiscard]] std::size_t FindParamIDMatch(
+        const std::int32_t* mins, const std::int32_t* maxes, std::size_t count, std::int32_t paramID);
+
+    /// @brief Name of the compare path selected at build time ("AVX2", "SSE2" or "Scalar"), for logging.
+    [[nodiscard]] const char* GetParamIDMatchPath();
+} // namespace DSREquipmentSwap
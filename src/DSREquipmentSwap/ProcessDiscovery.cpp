@@ -0,0 +1,208 @@
+#include "ProcessDiscovery.h"
+
+#include <algorithm>
+#include <cwctype>
+#include <string_view>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <dirent.h>
+#include <fstream>
+#include <unistd.h>
+#endif
+
+using namespace DSREquipmentSwap;
+
+namespace
+{
+    /// @brief Get the file name part of `path`, which may use either separator (Wine paths use backslashes).
+    std::wstring_view GetFileName(const std::wstring_view path)
+    {
+        const std::size_t separator = path.find_last_of(L"/\\");
+        return separator == std::wstring_view::npos ? path : path.substr(separator + 1);
+    }
+
+    bool EqualsIgnoreCase(const std::wstring_view a, const std::wstring_view b)
+    {
+        return std::ranges::equal(a, b, [](const wchar_t x, const wchar_t y)
+        {
+            return std::towlower(static_cast<wint_t>(x)) == std::towlower(static_cast<wint_t>(y));
+        });
+    }
+
+#ifdef _WIN32
+    /// @brief Get the full executable path of process `processID`, or an empty string if it cannot be queried.
+    std::wstring GetExecutablePath(const std::uint32_t processID)
+    {
+        const HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, processID);
+        if (process == nullptr)
+            return {};
+        wchar_t buffer[MAX_PATH];
+        DWORD size = MAX_PATH;
+        const BOOL succeeded = QueryFullProcessImageNameW(process, 0, buffer, &size);
+        CloseHandle(process);
+        return succeeded ? std::wstring(buffer, size) : std::wstring();
+    }
+
+    /// @brief Get the creation time of process `processID`, which tells a reused process ID from the process that had
+    /// it before. 0 if the process cannot be queried (it then keeps 0, so it is still only looked up once).
+    std::uint64_t GetProcessIdentity(const std::uint32_t processID)
+    {
+        const HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, processID);
+        if (process == nullptr)
+            return 0;
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        const BOOL succeeded = GetProcessTimes(process, &creationTime, &exitTime, &kernelTime, &userTime);
+        CloseHandle(process);
+        if (!succeeded)
+            return 0;
+        return (static_cast<std::uint64_t>(creationTime.dwHighDateTime) << 32) | creationTime.dwLowDateTime;
+    }
+#else
+    /// @brief Get the first command line argument of process `processID` (its executable path, as started), falling
+    /// back to its (truncated) `comm` name. Empty if the process has exited. Bytes are widened as-is.
+    std::wstring GetExecutablePath(const std::uint32_t processID)
+    {
+        const std::string directory = "/proc/" + std::to_string(processID);
+        std::string path;
+        if (std::ifstream cmdline(directory + "/cmdline"); cmdline)
+            std::getline(cmdline, path, '\0');
+        if (path.empty())
+        {
+            if (std::ifstream comm(directory + "/comm"); comm)
+                std::getline(comm, path);
+        }
+        return {path.begin(), path.end()};
+    }
+#endif
+} // namespace
+
+std::optional<std::uint32_t> CurrentProcessDiscovery::FindProcess()
+{
+#ifdef _WIN32
+    return static_cast<std::uint32_t>(GetCurrentProcessId());
+#else
+    return static_cast<std::uint32_t>(getpid());
+#endif
+}
+
+void CurrentProcessDiscovery::FindProcesses(std::vector<std::uint32_t>& processIDs)
+{
+    processIDs.assign(1, *FindProcess());
+}
+
+std::optional<std::uint32_t> IncrementalProcessDiscovery::FindProcess()
+{
+    m_matches.clear();
+    Scan(true, m_matches);
+    if (m_matches.empty())
+        return std::nullopt;
+    return m_matches.front();
+}
+
+void IncrementalProcessDiscovery::FindProcesses(std::vector<std::uint32_t>& processIDs)
+{
+    processIDs.clear();
+    Scan(false, processIDs);
+}
+
+void IncrementalProcessDiscovery::Scan(const bool isFirstOnly, std::vector<std::uint32_t>& processIDs)
+{
+    // Recheck everything now and then: a rejected process can still become the game by `exec()`ing it.
+    if (++m_scan % FULL_RECHECK_INTERVAL == 0)
+        m_rejected.clear();
+
+#ifdef _WIN32
+    // Grow the buffer until the whole list fits (`EnumProcesses()` does not report the required size).
+    if (m_processIDs.empty())
+        m_processIDs.resize(1024);
+    DWORD bytesReturned = 0;
+    while (true)
+    {
+        const auto bufferBytes = static_cast<DWORD>(m_processIDs.size() * sizeof(DWORD));
+        if (!EnumProcesses(reinterpret_cast<DWORD*>(m_processIDs.data()), bufferBytes, &bytesReturned))
+            return;
+        if (bytesReturned < bufferBytes)
+            break;
+        m_processIDs.resize(m_processIDs.size() * 2);
+    }
+
+    const std::size_t processCount = bytesReturned / sizeof(DWORD);
+    for (std::size_t i = 0; i < processCount; ++i)
+    {
+        const std::uint32_t processID = m_processIDs[i];
+        if (processID != 0 && CheckProcess(processID, GetProcessIdentity(processID))) // 0 == System Idle Process
+        {
+            processIDs.push_back(processID);
+            if (isFirstOnly)
+                return;
+        }
+    }
+#else
+    DIR* proc = opendir("/proc");
+    if (proc == nullptr)
+        return;
+    while (const dirent* entry = readdir(proc))
+    {
+        // Process directories are the all-digit entries.
+        std::uint32_t processID = 0;
+        const char* c = entry->d_name;
+        for (; *c >= '0' && *c <= '9'; ++c)
+            processID = processID * 10 + static_cast<std::uint32_t>(*c - '0');
+        if (*c != '\0' || c == entry->d_name)
+            continue;
+
+        if (CheckProcess(processID, entry->d_ino))
+        {
+            processIDs.push_back(processID);
+            if (isFirstOnly)
+            {
+                closedir(proc);
+                return;
+            }
+        }
+    }
+    closedir(proc);
+#endif
+
+    // Did not stop early, so every live process was listed by this scan.
+    ForgetExitedProcesses();
+}
+
+bool IncrementalProcessDiscovery::CheckProcess(const std::uint32_t processID, const std::uint64_t identity)
+{
+    if (const auto it = m_rejected.find(processID); it != m_rejected.end() && it->second.identity == identity)
+    {
+        it->second.scan = m_scan;
+        return false;
+    }
+
+    ++m_nameLookupCount;
+    if (EqualsIgnoreCase(GetFileName(GetExecutablePath(processID)), m_executableName))
+    {
+        m_rejected.erase(processID);
+        return true;
+    }
+
+    // Also rejects processes we may not query. They will not become queryable later.
+    m_rejected.insert_or_assign(processID, RejectedProcess{identity, m_scan});
+    return false;
+}
+
+void IncrementalProcessDiscovery::ForgetExitedProcesses()
+{
+    std::erase_if(m_rejected, [this](const auto& entry) { return entry.second.scan != m_scan; });
+}
+
+std::unique_ptr<ProcessDiscovery> DSREquipmentSwap::CreateProcessDiscovery(const std::wstring& executableName)
+{
+#ifdef DSR_EQUIPMENT_SWAP_IN_PROCESS
+    (void)executableName;
+    return std::make_unique<CurrentProcessDiscovery>();
+#else
+    return std::make_unique<IncrementalProcessDiscovery>(executableName);
+#endif
+}
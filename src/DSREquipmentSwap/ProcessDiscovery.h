@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Interface for finding a running process by executable name, one cheap, non-blocking attempt at a time.
+    ///
+    /// @details Used to decide *when* the (expensive, full snapshot) `Firelink::ManagedProcess` search is worth
+    /// running: the swapper polls `FindProcess()` while waiting and only asks Firelink for a handle once it reports a
+    /// match. Implementations may keep state between attempts; a single instance is meant to be reused for every search.
+    class ProcessDiscovery
+    {
+    public:
+        virtual ~ProcessDiscovery() = default;
+
+        /// @brief Look for the process once. Returns its process ID if it is running.
+        virtual std::optional<std::uint32_t> FindProcess() = 0;
+
+        /// @brief Look for every running instance of the process once (multi-process mode). Replaces the contents of
+        /// `processIDs` with their process IDs.
+        virtual void FindProcesses(std::vector<std::uint32_t>& processIDs) = 0;
+
+        /// @brief Number of processes whose executable name had to be looked up, over all `FindProcess()` calls.
+        [[nodiscard]] virtual std::uint64_t GetNameLookupCount() const = 0;
+
+        [[nodiscard]] virtual std::string GetName() const = 0;
+    };
+
+    /// @brief "Discovers" the current process (DLL build: the game is the process we are loaded into).
+    class CurrentProcessDiscovery final : public ProcessDiscovery
+    {
+    public:
+        std::optional<std::uint32_t> FindProcess() override;
+        void FindProcesses(std::vector<std::uint32_t>& processIDs) override;
+        [[nodiscard]] std::uint64_t GetNameLookupCount() const override { return 0; }
+        [[nodiscard]] std::string GetName() const override { return "CurrentProcess"; }
+    };
+
+    /// @brief Incremental scan of the process list.
+    ///
+    /// @details Listing process IDs is cheap; looking up each process's executable name is what makes a full snapshot
+    /// expensive. Every attempt lists the IDs, but only looks up the names of processes it has not already rejected.
+    /// On Windows, IDs come from `EnumProcesses()`, names from `QueryFullProcessImageNameW()`, and the creation time
+    /// (`GetProcessTimes()`) tells a reused process ID from the process that was rejected. Elsewhere, IDs and names
+    /// come from `/proc/<pid>` and `/proc/<pid>/cmdline` (first argument's file name, so Wine processes match too), and
+    /// the entry's inode does.
+    ///
+    /// Processes that disappear from the list are forgotten, so the rejection cache never outgrows the process list.
+    /// Every `FULL_RECHECK_INTERVAL`th scan looks up all names again, so a process that turns into the game later
+    /// (by `exec()`ing it in place) is still found. Matching processes are never cached: their names are looked up on
+    /// every scan, so a reused process ID is never taken for a game instance.
+    class IncrementalProcessDiscovery final : public ProcessDiscovery
+    {
+    public:
+        /// @brief Find processes whose executable file name is `executableName` (case-insensitive).
+        explicit IncrementalProcessDiscovery(std::wstring executableName)
+            : m_executableName(std::move(executableName))
+        {}
+
+        std::optional<std::uint32_t> FindProcess() override;
+        void FindProcesses(std::vector<std::uint32_t>& processIDs) override;
+        [[nodiscard]] std::uint64_t GetNameLookupCount() const override { return m_nameLookupCount; }
+        [[nodiscard]] std::string GetName() const override { return "IncrementalScan"; }
+
+    private:
+        // Every Nth scan forgets all rejections and looks up every name again.
+        static constexpr std::uint32_t FULL_RECHECK_INTERVAL = 32;
+
+        struct RejectedProcess
+        {
+            std::uint64_t identity; // creation time (Windows) or `/proc` entry inode
+            std::uint32_t scan;     // last scan that listed this process
+        };
+
+        std::wstring m_executableName;
+        std::unordered_map<std::uint32_t, RejectedProcess> m_rejected; // by process ID
+        std::uint32_t m_scan = 0;
+        std::uint64_t m_nameLookupCount = 0;
+        std::vector<std::uint32_t> m_processIDs; // reused listing buffer (Windows)
+        std::vector<std::uint32_t> m_matches;    // reused by `FindProcess()`
+
+        /// @brief List all processes once, adding matches to `processIDs`. Stops at the first match if `isFirstOnly`.
+        void Scan(bool isFirstOnly, std::vector<std::uint32_t>& processIDs);
+
+        /// @brief Check process `processID` (listed with `identity`) against the rejection cache, looking up its name
+        /// if needed. Returns true if it is the process we are looking for.
+        bool CheckProcess(std::uint32_t processID, std::uint64_t identity);
+
+        /// @brief Forget rejected processes that were not listed by the current scan.
+        void ForgetExitedProcesses();
+    };
+
+    /// @brief Create the discovery for this build: the current process in the DLL, an incremental scan otherwise.
+    std::unique_ptr<ProcessDiscovery> CreateProcessDiscovery(const std::wstring& executableName);
+} // namespace DSREquipmentSwap
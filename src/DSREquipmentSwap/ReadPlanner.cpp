@@ -0,0 +1,98 @@
+#include "ReadPlanner.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace DSREquipmentSwap;
+
+std::size_t ReadPlanner::Add(const std::uintptr_t address, void* dest, const std::size_t size)
+{
+    m_requests.push_back(Request{address, dest, size, false});
+    return m_requests.size() - 1;
+}
+
+bool ReadPlanner::Execute(const MemoryBackend& memory)
+{
+    m_lastReadCount = 0;
+
+    m_order.resize(m_requests.size());
+    for (std::size_t i = 0; i < m_order.size(); ++i)
+        m_order[i] = i;
+    std::ranges::sort(m_order, [this](const std::size_t a, const std::size_t b)
+    {
+        return m_requests[a].address < m_requests[b].address;
+    });
+
+    // Walk the sorted requests, extending the current run while the next one starts within the gap of its end.
+    std::size_t readCount = 0;
+    std::size_t first = 0;
+    while (first < m_order.size())
+    {
+        const Request& firstRequest = m_requests[m_order[first]];
+        std::uintptr_t runEnd = firstRequest.address + firstRequest.size;
+        if (m_isPageAligned)
+            runEnd = (runEnd + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+
+        std::size_t last = first + 1;
+        for (; last < m_order.size(); ++last)
+        {
+            const Request& request = m_requests[m_order[last]];
+            if (request.address > runEnd + m_mergeGap)
+                break;
+            std::uintptr_t requestEnd = request.address + request.size;
+            if (m_isPageAligned)
+                requestEnd = (requestEnd + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+            runEnd = std::max(runEnd, requestEnd);
+        }
+
+        readCount += ExecuteRun(memory, first, last);
+        first = last;
+    }
+    return readCount == m_requests.size();
+}
+
+std::size_t ReadPlanner::ExecuteRun(const MemoryBackend& memory, const std::size_t first, const std::size_t last)
+{
+    std::uintptr_t start = m_requests[m_order[first]].address;
+    std::uintptr_t end = start;
+    for (std::size_t i = first; i < last; ++i)
+        end = std::max(end, m_requests[m_order[i]].address + m_requests[m_order[i]].size);
+    if (m_isPageAligned)
+    {
+        start &= ~(PAGE_SIZE - 1);
+        end = (end + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    }
+
+    if (last - first == 1 && !m_isPageAligned)
+    {
+        // Lone region: read straight into its destination.
+        Request& request = m_requests[m_order[first]];
+        ++m_lastReadCount;
+        request.succeeded = memory.Read(request.address, request.dest, request.size);
+        return request.succeeded ? 1 : 0;
+    }
+
+    m_buffer.resize(end - start);
+    ++m_lastReadCount;
+    if (memory.Read(start, m_buffer.data(), m_buffer.size()))
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            Request& request = m_requests[m_order[i]];
+            std::memcpy(request.dest, m_buffer.data() + (request.address - start), request.size);
+            request.succeeded = true;
+        }
+        return last - first;
+    }
+
+    // Fall back to one read per region.
+    std::size_t readCount = 0;
+    for (std::size_t i = first; i < last; ++i)
+    {
+        Request& request = m_requests[m_order[i]];
+        ++m_lastReadCount;
+        request.succeeded = memory.Read(request.address, request.dest, request.size);
+        readCount += request.succeeded ? 1 : 0;
+    }
+    return readCount;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <DSREquipmentSwap/MemoryBackend.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Collects the memory regions needed for one update and reads them with as few backend reads as possible.
+    ///
+    /// @details Regions are declared with `Add()` and read by `Execute()`, which sorts them by address and merges any
+    /// that overlap or are separated by at most `mergeGap` bytes into one read (gap bytes are read and discarded). In
+    /// page-aligned mode, each merged read is widened to whole pages first, so regions on the same page always share a
+    /// read. If a merged read fails (e.g. the gap crosses an unmapped page), its regions are retried one by one, so a
+    /// bad gap never fails a region that is readable on its own.
+    ///
+    /// Reuses its buffers, so a planner kept across updates does not allocate once warmed up.
+    class ReadPlanner
+    {
+    public:
+        static constexpr std::size_t PAGE_SIZE = 0x1000;
+
+        explicit ReadPlanner(const std::size_t mergeGap = 64, const bool isPageAligned = false)
+            : m_mergeGap(mergeGap)
+            , m_isPageAligned(isPageAligned)
+        {}
+
+        /// @brief Declare a read of `size` bytes at `address` into `dest`, which must stay valid until `Execute()`.
+        /// Returns the request index, for `Succeeded()`.
+        std::size_t Add(std::uintptr_t address, void* dest, std::size_t size);
+
+        template <typename T>
+        std::size_t Add(const std::uintptr_t address, T& dest)
+        {
+            return Add(address, &dest, sizeof(T));
+        }
+
+        /// @brief Read every declared region into its destination. Returns true if all of them were read.
+        bool Execute(const MemoryBackend& memory);
+
+        /// @brief True if request `index` was read by the last `Execute()`.
+        [[nodiscard]] bool Succeeded(const std::size_t index) const { return m_requests[index].succeeded; }
+
+        /// @brief Number of backend reads issued by the last `Execute()` (including fallback reads).
+        [[nodiscard]] std::size_t GetLastReadCount() const { return m_lastReadCount; }
+
+        /// @brief Number of regions declared since the last `Clear()`.
+        [[nodiscard]] std::size_t GetRequestCount() const { return m_requests.size(); }
+
+        /// @brief Forget all declared regions (keeps buffers).
+        void Clear() { m_requests.clear(); }
+
+    private:
+        struct Request
+        {
+            std::uintptr_t address;
+            void* dest;
+            std::size_t size;
+            bool succeeded;
+        };
+
+        std::size_t m_mergeGap;
+        bool m_isPageAligned;
+        std::vector<Request> m_requests;
+        std::vector<std::size_t> m_order; // request indices sorted by address
+        std::vector<std::byte> m_buffer;  // one merged read
+        std::size_t m_lastReadCount = 0;
+
+        /// @brief Read the merged region covering sorted requests `[first, last)`. Returns the number of requests read.
+        std::size_t ExecuteRun(const MemoryBackend& memory, std::size_t first, std::size_t last);
+    };
+} // namespace DSREquipmentSwap
@@ -0,0 +1,241 @@
+#include "SlotAccess.h"
+
+#include <format>
+
+using namespace FirelinkDSR;
+using namespace DSREquipmentSwap;
+
+namespace
+{
+    /// @brief How to read and write one slot through `DSRPlayer`. Indexed by `EquipSlot`, like `SLOT_TABLE`.
+    struct SlotAccessor
+    {
+        int (*read)(const DSRPlayer& player);
+        bool (*write)(const DSRPlayer& player, int paramID);
+    };
+
+    constexpr std::array<SlotAccessor, EQUIP_SLOT_COUNT> SLOT_ACCESSORS = {{
+        {
+            [](const DSRPlayer& p) { return p.GetWeapon(WeaponSlot::PRIMARY, true); },
+            [](const DSRPlayer& p, const int id) { return p.SetWeapon(WeaponSlot::PRIMARY, id, true); },
+        },
+        {
+            [](const DSRPlayer& p) { return p.GetWeapon(WeaponSlot::SECONDARY, true); },
+            [](const DSRPlayer& p, const int id) { return p.SetWeapon(WeaponSlot::SECONDARY, id, true); },
+        },
+        {
+            [](const DSRPlayer& p) { return p.GetWeapon(WeaponSlot::PRIMARY, false); },
+            [](const DSRPlayer& p, const int id) { return p.SetWeapon(WeaponSlot::PRIMARY, id, false); },
+        },
+        {
+            [](const DSRPlayer& p) { return p.GetWeapon(WeaponSlot::SECONDARY, false); },
+            [](const DSRPlayer& p, const int id) { return p.SetWeapon(WeaponSlot::SECONDARY, id, false); },
+        },
+        {
+            [](const DSRPlayer& p) { return p.GetArmor(ArmorType::HEAD); },
+            [](const DSRPlayer& p, const int id) { return p.SetArmor(ArmorType::HEAD, id); },
+        },
+        {
+            [](const DSRPlayer& p) { return p.GetArmor(ArmorType::BODY); },
+            [](const DSRPlayer& p, const int id) { return p.SetArmor(ArmorType::BODY, id); },
+        },
+        {
+            [](const DSRPlayer& p) { return p.GetArmor(ArmorType::ARMS); },
+            [](const DSRPlayer& p, const int id) { return p.SetArmor(ArmorType::ARMS, id); },
+        },
+        {
+            [](const DSRPlayer& p) { return p.GetArmor(ArmorType::LEGS); },
+            [](const DSRPlayer& p, const int id) { return p.SetArmor(ArmorType::LEGS, id); },
+        },
+        {
+            [](const DSRPlayer& p) { return p.GetRing(0); },
+            [](const DSRPlayer& p, const int id) { return p.SetRing(0, id); },
+        },
+        {
+            [](const DSRPlayer& p) { return p.GetRing(1); },
+            [](const DSRPlayer& p, const int id) { return p.SetRing(1, id); },
+        },
+    }};
+} // namespace
+
+std::uint64_t DSREquipmentSwap::GetCharacterID(const CharacterName& name)
+{
+    // FNV-1a over the characters before the first null.
+    std::uint64_t hash = 14695981039346656037ull;
+    int length = 0;
+    for (; length < CHARACTER_NAME_LENGTH && name[length] != u'\0'; ++length)
+    {
+        for (int byte = 0; byte < 2; ++byte)
+        {
+            hash ^= (static_cast<std::uint32_t>(name[length]) >> (8 * byte)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    }
+    if (length == 0)
+        return 0;
+    return hash == 0 ? 1 : hash; // 0 == no character
+}
+
+std::uintptr_t DSREquipmentSwap::FindEquipBlock(
+    const MemoryBackend& memory, const EquipBlockConfig& config, const std::uintptr_t playerInsAddress)
+{
+    std::uintptr_t address = playerInsAddress;
+    for (const int offset : config.pointerPath)
+    {
+        std::uint64_t next = 0;
+        if (address == 0 || !memory.Read(address + offset, next))
+            return 0;
+        address = static_cast<std::uintptr_t>(next);
+    }
+    return address;
+}
+
+int PlayerSlots::Read(const EquipSlot slot) const
+{
+    std::int32_t paramID;
+    if (m_memory && m_memory->Read(GetSlotAddress(slot), paramID))
+        return paramID;
+    return SLOT_ACCESSORS[static_cast<int>(slot)].read(m_player);
+}
+
+bool PlayerSlots::Write(const EquipSlot slot, const int paramID) const
+{
+    if (m_memory && m_memory->Write(GetSlotAddress(slot), static_cast<std::int32_t>(paramID)))
+        return true;
+    return SLOT_ACCESSORS[static_cast<int>(slot)].write(m_player, paramID);
+}
+
+std::uint64_t PlayerSlots::ReadCharacterID() const
+{
+    CharacterName name;
+    if (!HasCharacterName() || !m_memory->Read(GetNameAddress(), name))
+        return 0;
+    return GetCharacterID(name);
+}
+
+bool PlayerSlots::IsSecondaryActive(const int hand) const
+{
+    std::int32_t weaponSlot;
+    if (m_memory && m_memory->Read(GetWeaponSlotAddress(hand), weaponSlot))
+        return weaponSlot == 1; // as documented for `EquipBlockConfig::weaponSlotOffsets`
+    return m_player.GetWeaponSlot(hand == 0) == WeaponSlot::SECONDARY;
+}
+
+bool DSREquipmentSwap::CheckEquipBlock(const PlayerSlots& player, std::string& mismatch)
+{
+    const PlayerSlots& fallback = player.GetPlayer(); // through `DSRPlayer` only
+    for (int i = 0; i < EQUIP_SLOT_COUNT; ++i)
+    {
+        const auto slot = static_cast<EquipSlot>(i);
+        std::int32_t blockParamID;
+        if (!player.ReadDirect(player.GetSlotAddress(slot), blockParamID))
+        {
+            mismatch = std::format("{} cannot be read", GetSlotInfo(slot).name);
+            return false;
+        }
+        if (const int gameParamID = fallback.Read(slot); blockParamID != gameParamID)
+        {
+            mismatch = std::format(
+                "{} is {} in the block, {} in the game", GetSlotInfo(slot).name, blockParamID, gameParamID);
+            return false;
+        }
+    }
+    for (int hand = 0; hand < 2; ++hand)
+    {
+        std::int32_t weaponSlot;
+        if (!player.ReadDirect(player.GetWeaponSlotAddress(hand), weaponSlot)
+            || (weaponSlot == 1) != fallback.IsSecondaryActive(hand))
+        {
+            mismatch = std::format("{} hand weapon slot differs", hand == 0 ? "Left" : "Right");
+            return false;
+        }
+    }
+    return true;
+}
+
+int DSREquipmentSwap::ReadSlot(const PlayerSlots& player, const EquipSlot slot)
+{
+    return player.Read(slot);
+}
+
+bool DSREquipmentSwap::WriteSlot(const PlayerSlots& player, const EquipSlot slot, const int paramID)
+{
+    return player.Write(slot, paramID);
+}
+
+SlotWriteResult DSREquipmentSwap::WriteSlotChecked(
+    const PlayerSlots& player,
+    const EquipSlot slot,
+    const int expectedParamID,
+    const int paramID,
+    SlotWriteRaceStats& stats)
+{
+    for (int attempt = 0; attempt < SLOT_WRITE_MAX_ATTEMPTS; ++attempt)
+    {
+        if (attempt > 0)
+            ++stats.retries;
+        if (player.Read(slot) != expectedParamID)
+        {
+            // Only the first check guards our own read; later ones see what the game did after our write.
+            ++(attempt == 0 ? stats.preWriteRaces : stats.postWriteRaces);
+            return SlotWriteResult::RACED;
+        }
+        if (!player.Write(slot, paramID))
+            return SlotWriteResult::FAILED;
+        if (player.Read(slot) == paramID)
+            return SlotWriteResult::WRITTEN;
+    }
+    ++stats.postWriteRaces; // the game kept undoing the write
+    return SlotWriteResult::RACED;
+}
+
+void DSREquipmentSwap::ReadPlayerSnapshot(const PlayerSlots& player, const SlotMask& slots, PlayerSnapshot& snapshot)
+{
+    snapshot.isSecondaryActive[0] = player.IsSecondaryActive(0);
+    snapshot.isSecondaryActive[1] = player.IsSecondaryActive(1);
+    for (int i = 0; i < EQUIP_SLOT_COUNT; ++i)
+    {
+        if (slots.test(i))
+            snapshot.paramIDs[i] = player.Read(static_cast<EquipSlot>(i));
+    }
+    snapshot.characterID = player.ReadCharacterID();
+}
+
+void PlannedSnapshotRead::Plan(
+    ReadPlanner& planner, const PlayerSlots& player, const SlotMask& slots, PlayerSnapshot& snapshot)
+{
+    static_assert(sizeof(snapshot.paramIDs[0]) == sizeof(std::int32_t), "Param IDs are read straight into snapshots.");
+
+    m_slots = slots;
+    m_firstRequest = planner.Add(player.GetWeaponSlotAddress(0), m_weaponSlots[0]);
+    planner.Add(player.GetWeaponSlotAddress(1), m_weaponSlots[1]);
+    for (int i = 0; i < EQUIP_SLOT_COUNT; ++i)
+    {
+        if (slots.test(i))
+            planner.Add(player.GetSlotAddress(static_cast<EquipSlot>(i)), snapshot.paramIDs[i]);
+    }
+    m_hasName = player.HasCharacterName();
+    if (m_hasName)
+        planner.Add(player.GetNameAddress(), m_name); // same block, so usually in the same read
+}
+
+void PlannedSnapshotRead::Finish(const ReadPlanner& planner, const PlayerSlots& player, PlayerSnapshot& snapshot) const
+{
+    std::size_t request = m_firstRequest;
+    for (int hand = 0; hand < 2; ++hand, ++request)
+    {
+        snapshot.isSecondaryActive[hand] =
+            planner.Succeeded(request) ? m_weaponSlots[hand] == 1 : player.IsSecondaryActive(hand);
+    }
+    for (int i = 0; i < EQUIP_SLOT_COUNT; ++i)
+    {
+        if (!m_slots.test(i))
+            continue;
+        if (!planner.Succeeded(request++))
+            snapshot.paramIDs[i] = player.Read(static_cast<EquipSlot>(i));
+    }
+    if (!m_hasName)
+        snapshot.characterID = 0;
+    else
+        snapshot.characterID = planner.Succeeded(request) ? GetCharacterID(m_name) : player.ReadCharacterID();
+}
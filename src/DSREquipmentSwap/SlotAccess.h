@@ -0,0 +1,171 @@
+#pragma once
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/MemoryBackend.h>
+#include <DSREquipmentSwap/ReadPlanner.h>
+#include <DSREquipmentSwap/Slots.h>
+
+#include <FirelinkDSRHook/DSRPlayer.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Follow `config.pointerPath` from the PlayerIns at `playerInsAddress` to the player's equip block.
+    /// Returns 0 if the path cannot be read.
+    [[nodiscard]] std::uintptr_t FindEquipBlock(
+        const MemoryBackend& memory, const EquipBlockConfig& config, std::uintptr_t playerInsAddress);
+
+    /// @brief Wide characters of a character name read by `PlayerSlots::ReadCharacterID()` (the game allows fewer).
+    constexpr int CHARACTER_NAME_LENGTH = 16;
+
+    using CharacterName = std::array<char16_t, CHARACTER_NAME_LENGTH>;
+
+    /// @brief Identity of the character named `name` (up to its first null), for the swap journal. 0 for an empty name
+    /// (e.g. no character loaded yet).
+    [[nodiscard]] std::uint64_t GetCharacterID(const CharacterName& name);
+
+    /// @brief Equipment slots of one player: read and written directly in the player's equip block if there is one,
+    /// and through `DSRPlayer` otherwise (or whenever a direct access fails, e.g. on a stale block).
+    class PlayerSlots
+    {
+    public:
+        /// @brief Through `player` only. Implicit, so that anything with just a `DSRPlayer` can still pass one.
+        PlayerSlots(const FirelinkDSR::DSRPlayer& player)
+            : m_player(player)
+        {}
+
+        /// @brief Directly in the block at `blockAddress` (see `FindEquipBlock()`), laid out as `config`. Both must
+        /// outlive this object. A null `blockAddress` goes through `player` only.
+        PlayerSlots(
+            const FirelinkDSR::DSRPlayer& player,
+            const MemoryBackend& memory,
+            const EquipBlockConfig& config,
+            const std::uintptr_t blockAddress)
+            : m_player(player)
+            , m_memory(blockAddress != 0 ? &memory : nullptr)
+            , m_config(&config)
+            , m_blockAddress(blockAddress)
+        {}
+
+        [[nodiscard]] const FirelinkDSR::DSRPlayer& GetPlayer() const { return m_player; }
+
+        /// @brief True if slots are accessed directly.
+        [[nodiscard]] bool IsDirect() const { return m_memory != nullptr; }
+
+        /// @brief Address of `slot`'s param ID in the block (only if `IsDirect()`).
+        [[nodiscard]] std::uintptr_t GetSlotAddress(const EquipSlot slot) const
+        {
+            return m_blockAddress + m_config->slotOffsets[static_cast<int>(slot)];
+        }
+
+        /// @brief Address of `hand`'s active weapon slot in the block (only if `IsDirect()`).
+        [[nodiscard]] std::uintptr_t GetWeaponSlotAddress(const int hand) const
+        {
+            return m_blockAddress + m_config->weaponSlotOffsets[hand];
+        }
+
+        /// @brief True if the character's name can be read from the block (direct, and `nameOffset` is set).
+        [[nodiscard]] bool HasCharacterName() const { return IsDirect() && m_config->nameOffset >= 0; }
+
+        /// @brief Address of the character's name in the block (only if `HasCharacterName()`).
+        [[nodiscard]] std::uintptr_t GetNameAddress() const { return m_blockAddress + m_config->nameOffset; }
+
+        /// @brief Read the identity of the player's character (see `GetCharacterID()`). 0 if the name cannot be read.
+        [[nodiscard]] std::uint64_t ReadCharacterID() const;
+
+        /// @brief Read `value` at `address` in the block, with no fallback (only if `IsDirect()`).
+        template <typename T>
+        bool ReadDirect(const std::uintptr_t address, T& value) const
+        {
+            return m_memory->Read(address, value);
+        }
+
+        /// @brief Read the current param ID equipped in `slot`.
+        [[nodiscard]] int Read(EquipSlot slot) const;
+
+        /// @brief Write `paramID` into `slot`. Returns false if the write failed.
+        bool Write(EquipSlot slot, int paramID) const;
+
+        /// @brief True if the secondary weapon of `hand` (0 = left, 1 = right) is active.
+        [[nodiscard]] bool IsSecondaryActive(int hand) const;
+
+    private:
+        const FirelinkDSR::DSRPlayer& m_player;
+        const MemoryBackend* m_memory = nullptr; // null == through `m_player`
+        const EquipBlockConfig* m_config = nullptr;
+        std::uintptr_t m_blockAddress = 0;
+    };
+
+    /// @brief Check that the equip block of direct `player` holds the same param IDs and weapon slots that `DSRPlayer`
+    /// reports, i.e. that `EquipBlockConfig` matches the running game version. Returns false and describes the first
+    /// difference in `mismatch` if not (or if the block cannot be read).
+    [[nodiscard]] bool CheckEquipBlock(const PlayerSlots& player, std::string& mismatch);
+
+    /// @brief Read the current param ID equipped in `slot`.
+    [[nodiscard]] int ReadSlot(const PlayerSlots& player, EquipSlot slot);
+
+    /// @brief Write `paramID` into `slot`. Returns false if the write failed.
+    bool WriteSlot(const PlayerSlots& player, EquipSlot slot, int paramID);
+
+    /// @brief Attempts `WriteSlotChecked()` makes before giving up on a write the game keeps undoing.
+    constexpr int SLOT_WRITE_MAX_ATTEMPTS = 3;
+
+    /// @brief Outcome of `WriteSlotChecked()`.
+    enum class SlotWriteResult
+    {
+        WRITTEN, // the slot holds the new ID
+        FAILED,  // the write itself failed
+        RACED,   // the game changed the slot; it holds whatever the game put there
+    };
+
+    /// @brief Running counters of `WriteSlotChecked()`.
+    struct SlotWriteRaceStats
+    {
+        std::uint64_t preWriteRaces = 0;  // slot changed between our read and our write; nothing written
+        std::uint64_t postWriteRaces = 0; // slot changed (or kept being undone) after our write
+        std::uint64_t retries = 0;        // writes repeated because the game undid them
+    };
+
+    /// @brief Write `paramID` into `slot` only if it still holds `expectedParamID`, and verify it afterwards.
+    ///
+    /// @details The game can change a slot at any point of its frame (equip menu, forced unequip), so a blind write
+    /// can overwrite an ID we never saw. The slot is re-read immediately before the write, and the write is aborted if
+    /// it no longer holds `expectedParamID`. After the write the slot is read back: if the game put the old ID back,
+    /// the write is repeated (up to `SLOT_WRITE_MAX_ATTEMPTS` in all); if it holds anything else, the game's ID is
+    /// kept.
+    SlotWriteResult WriteSlotChecked(
+        const PlayerSlots& player,
+        EquipSlot slot,
+        int expectedParamID,
+        int paramID,
+        SlotWriteRaceStats& stats);
+
+    /// @brief Fill `snapshot` with the current weapon slot of each hand, the param IDs of the slots in `slots` and the
+    /// character's identity. Other param IDs are left untouched. Active SpEffects are not read here.
+    void ReadPlayerSnapshot(const PlayerSlots& player, const SlotMask& slots, PlayerSnapshot& snapshot);
+
+    /// @brief `ReadPlayerSnapshot()` in two halves around a `ReadPlanner::Execute()`, so that the direct reads of all
+    /// players are declared first and then made in as few reads as possible.
+    class PlannedSnapshotRead
+    {
+    public:
+        /// @brief Declare the reads of `ReadPlayerSnapshot(player, slots, snapshot)` to `planner`. `player` must be
+        /// direct, and `snapshot` (and this object) must stay where they are until `Finish()`.
+        void Plan(ReadPlanner& planner, const PlayerSlots& player, const SlotMask& slots, PlayerSnapshot& snapshot);
+
+        /// @brief After `planner` has executed: complete `snapshot`, reading anything the planner could not read
+        /// through `player` on its own.
+        void Finish(const ReadPlanner& planner, const PlayerSlots& player, PlayerSnapshot& snapshot) const;
+
+    private:
+        SlotMask m_slots;
+        std::size_t m_firstRequest = 0; // weapon slots, each slot in `m_slots` in index order, then the name (if any)
+        std::array<std::int32_t, 2> m_weaponSlots = {}; // left hand first
+        bool m_hasName = false;
+        CharacterName m_name = {};
+    };
+} // namespace DSREquipmentSwap
@@ -0,0 +1,458 @@
+#include "SlotSwapper.h"
+
+#include <DSREquipmentSwap/SlotAccess.h>
+
+#include <format>
+
+using namespace DSREquipmentSwap;
+
+int SlotSwapper::CheckSwapTriggers(
+    const int playerIndex,
+    const PlayerSlots& player,
+    PlayerSnapshot& snapshot,
+    TriggerTable& triggers,
+    std::vector<int>& abortedSpEffects)
+{
+    triggers.Evaluate(playerIndex, snapshot, m_triggerCooldownMs, m_pendingSwaps);
+
+    // `Evaluate()` returns at most one swap per slot (first match wins), so each swap is a single write.
+    int swapsApplied = 0;
+    for (const PendingSwap& swap : m_pendingSwaps)
+    {
+        const std::string_view slotName = GetSlotInfo(swap.slot).name;
+        const SlotWriteResult result =
+            WriteSlotChecked(player, swap.slot, swap.sourceParamID, swap.destParamID, m_writeRaces);
+        if (result != SlotWriteResult::WRITTEN)
+        {
+            if (result == SlotWriteResult::RACED)
+            {
+                m_log.Warning(
+                    std::format(
+                        "{} ID trigger skipped (slot changed by the game): {}",
+                        slotName,
+                        triggers.DescribeRule(swap.ruleIndex)));
+            }
+            else
+                m_log.Error(std::format("{} ID trigger failed: {}", slotName, triggers.DescribeRule(swap.ruleIndex)));
+
+            // `Evaluate()` already counted the swap as made. Undo that, so the trigger is checked again next update.
+            triggers.CancelCooldown(swap.ruleIndex, playerIndex);
+            snapshot.paramIDs[static_cast<int>(swap.slot)] = swap.sourceParamID;
+            if (const std::int32_t spEffectID = triggers.GetRuleSpEffectID(swap.ruleIndex); spEffectID > 0)
+                abortedSpEffects.push_back(spEffectID);
+            continue;
+        }
+
+        ++swapsApplied;
+        m_log.Info(std::format("{} ID trigger succeeded: {}", slotName, triggers.DescribeRule(swap.ruleIndex)));
+
+        if (!triggers.IsRulePermanent(swap.ruleIndex))
+        {
+            // Record new to old ID mapping. This may replace an existing temporary swap, which we discard.
+            const auto slotIndex = static_cast<int>(swap.slot);
+            ClearTempSwap(playerIndex, slotIndex);
+            m_tempSwaps[playerIndex][slotIndex] = TempSwap{swap.sourceParamID, swap.destParamID};
+            if (m_journal && snapshot.characterID != 0)
+            {
+                m_journal->Set(
+                    JournaledSwap{
+                        playerIndex,
+                        swap.slot,
+                        SwapJournalLayer::SWAP,
+                        swap.sourceParamID,
+                        swap.destParamID,
+                        snapshot.characterID});
+            }
+            m_log.Info(
+                std::format("Recording temporary {} swap: {} -> {}", slotName, swap.sourceParamID, swap.destParamID));
+
+            if (const int durationMs = triggers.GetRuleDurationMs(swap.ruleIndex); durationMs > 0)
+            {
+                m_tempSwapTimers.Schedule(
+                    playerIndex * EQUIP_SLOT_COUNT + slotIndex, static_cast<std::uint64_t>(durationMs));
+            }
+        }
+    }
+    return swapsApplied;
+}
+
+int SlotSwapper::ApplyLoadouts(
+    const int playerIndex,
+    const PlayerSlots& player,
+    PlayerSnapshot& snapshot,
+    LoadoutTable& loadouts,
+    std::vector<int>& abortedSpEffects)
+{
+    loadouts.Evaluate(playerIndex, snapshot, m_triggerCooldownMs, m_pendingLoadouts);
+
+    int loadoutsApplied = 0;
+    for (const std::uint32_t loadoutIndex : m_pendingLoadouts)
+    {
+        const Loadout& loadout = loadouts.GetLoadout(loadoutIndex);
+        const LoadoutConfig& config = loadouts.GetConfig(loadoutIndex);
+
+        // The snapshot holds every loadout slot (see `LoadoutTable::GetTargetSlots()`).
+        const SlotWriteResult result = WriteSlotsAtomic(player, loadout.slots, loadout.paramIDs, snapshot.paramIDs);
+        if (result != SlotWriteResult::WRITTEN)
+        {
+            if (result == SlotWriteResult::RACED)
+            {
+                m_log.Warning(
+                    std::format(
+                        "Loadout skipped (slot changed by the game, all slots rolled back): {}", config.ToString()));
+            }
+            else
+                m_log.Error(std::format("Loadout failed (all slots rolled back): {}", config.ToString()));
+
+            // Rolled back, so the loadout is checked again next update (`snapshot` was never changed).
+            loadouts.CancelCooldown(loadoutIndex, playerIndex);
+            abortedSpEffects.push_back(config.spEffectIDTrigger);
+            continue;
+        }
+        ++loadoutsApplied;
+        m_log.Info(std::format("Loadout succeeded: {}", config.ToString()));
+
+        if (!config.isPermanent)
+        {
+            // Absorb earlier temporary swaps of these slots, so the revert goes back to their pre-swap IDs.
+            std::optional<TempLoadout>& record = m_tempLoadouts[playerIndex];
+            if (!record)
+                record = TempLoadout{};
+            for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+            {
+                if (!loadout.slots.test(slotIndex))
+                    continue;
+                std::optional<TempSwap>& slotSwap = m_tempSwaps[playerIndex][slotIndex];
+                if (!record->slots.test(slotIndex))
+                {
+                    record->slots.set(slotIndex);
+                    record->sourceParamIDs[slotIndex] =
+                        slotSwap ? slotSwap->sourceParamID : snapshot.paramIDs[slotIndex];
+                }
+                record->destParamIDs[slotIndex] = loadout.paramIDs[slotIndex];
+                if (m_journal && snapshot.characterID != 0)
+                {
+                    // Before the absorbed swap is cleared, so the slot is always covered.
+                    m_journal->Set(
+                        JournaledSwap{
+                            playerIndex,
+                            static_cast<EquipSlot>(slotIndex),
+                            SwapJournalLayer::LOADOUT,
+                            record->sourceParamIDs[slotIndex],
+                            record->destParamIDs[slotIndex],
+                            snapshot.characterID});
+                }
+                ClearTempSwap(playerIndex, slotIndex);
+            }
+            m_log.Info(std::format("Recording temporary loadout '{}'.", config.name));
+        }
+
+        for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+        {
+            if (loadout.slots.test(slotIndex))
+                snapshot.paramIDs[slotIndex] = loadout.paramIDs[slotIndex];
+        }
+    }
+    return loadoutsApplied;
+}
+
+void SlotSwapper::SetJournal(SwapJournal* journal)
+{
+    m_journal = journal;
+    m_recoveredSwaps.clear();
+    m_recoveryCharacterID = 0;
+    if (!m_journal)
+        return;
+
+    for (const JournaledSwap& swap : m_journal->GetRecovered())
+    {
+        if (swap.playerIndex == 0)
+            m_recoveredSwaps.push_back(swap);
+        else
+            m_journal->Release(swap);
+    }
+    if (m_journal->GetDroppedCount() > 0)
+    {
+        m_log.Warning(
+            std::format(
+                "Swap journal dropped its {} oldest swaps of characters that were not loaded for a long time.",
+                m_journal->GetDroppedCount()));
+    }
+    if (!m_recoveredSwaps.empty())
+    {
+        m_log.Warning(
+            std::format(
+                "Swap journal has {} temporary swaps that were never reverted. Reverting them once their character "
+                "is loaded.",
+                m_recoveredSwaps.size()));
+    }
+}
+
+int SlotSwapper::RecoverJournaledSwaps(const PlayerSlots& player, PlayerSnapshot& snapshot)
+{
+    if (snapshot.characterID == 0 || snapshot.characterID == m_recoveryCharacterID)
+        return 0; // unknown character, or already checked against this one
+    m_recoveryCharacterID = snapshot.characterID;
+
+    // Recovered in journal order: per-slot swaps before the loadouts underneath them.
+    int reverted = 0;
+    std::vector<JournaledSwap> otherSwaps; // of other characters: kept in the journal for them
+    for (const JournaledSwap& swap : m_recoveredSwaps)
+    {
+        if (swap.characterID != snapshot.characterID)
+        {
+            otherSwaps.push_back(swap);
+            continue;
+        }
+
+        const std::string_view slotName = GetSlotInfo(swap.slot).name;
+        if (const int currentParamID = ReadSlot(player, swap.slot); currentParamID != swap.destParamID)
+        {
+            m_log.Info(
+                std::format(
+                    "Journaled {} swap {} -> {} is gone (slot holds {}).",
+                    slotName,
+                    swap.sourceParamID,
+                    swap.destParamID,
+                    currentParamID));
+        }
+        else if (const SlotWriteResult result =
+                     WriteSlotChecked(player, swap.slot, swap.destParamID, swap.sourceParamID, m_writeRaces);
+                 result != SlotWriteResult::WRITTEN)
+        {
+            m_log.Error(
+                std::format(
+                    "Failed to revert journaled {} {} to {}{}.",
+                    slotName,
+                    swap.destParamID,
+                    swap.sourceParamID,
+                    result == SlotWriteResult::RACED ? " (slot changed by the game)" : ""));
+        }
+        else
+        {
+            m_log.Info(std::format("Reverted journaled {} {} to {}.", slotName, swap.destParamID, swap.sourceParamID));
+            snapshot.SetParamID(swap.slot, swap.sourceParamID);
+            ++reverted;
+        }
+        m_journal->Release(swap);
+    }
+    if (!otherSwaps.empty())
+    {
+        m_log.Info(
+            std::format(
+                "Keeping {} journaled swaps of other characters until one of them is loaded.", otherSwaps.size()));
+    }
+    m_recoveredSwaps.swap(otherSwaps);
+    return reverted;
+}
+
+void SlotSwapper::ExpireTimedSwaps()
+{
+    m_tempSwapTimers.Advance(m_expiredTimers);
+    for (const std::uint32_t key : m_expiredTimers)
+        m_timedOutSlots[key / EQUIP_SLOT_COUNT].set(key % EQUIP_SLOT_COUNT);
+}
+
+void SlotSwapper::RevertExpiredTempSwaps(const int playerIndex, const PlayerSlots& player, PlayerSnapshot& snapshot)
+{
+    for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+    {
+        const auto slot = static_cast<EquipSlot>(slotIndex);
+        const std::optional<TempSwap>& swap = m_tempSwaps[playerIndex][slotIndex];
+        const bool isTimedOut = m_timedOutSlots[playerIndex].test(slotIndex);
+        if (!swap || (snapshot.IsSlotActive(slot) && !isTimedOut))
+            continue; // NOTE: Armor and ring slots are always active, so only their timed swaps can "expire".
+
+        m_log.Info(
+            std::format(
+                "Reverting {} {} to {} ({}).",
+                GetSlotInfo(slot).name,
+                swap->destParamID,
+                swap->sourceParamID,
+                isTimedOut ? "duration is up" : "current weapon changed"));
+        const int sourceParamID = swap->sourceParamID;
+        if (RevertTempSwap(playerIndex, player, slot, snapshot.GetParamID(slot)))
+            snapshot.SetParamID(slot, sourceParamID);
+    }
+}
+
+void SlotSwapper::RevertTempSwaps(const int playerIndex, const PlayerSlots& player)
+{
+    if (GetTempSwapSlots(playerIndex).none())
+    {
+        // Report that we're forcing a revert but there are no temporary swaps to revert, for clarity.
+        m_log.Info(std::format("No temporary swaps to force-revert for player {}.", playerIndex));
+        return;
+    }
+
+    for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+    {
+        const auto slot = static_cast<EquipSlot>(slotIndex);
+        const std::optional<TempSwap>& swap = m_tempSwaps[playerIndex][slotIndex];
+        if (!swap)
+            continue;
+
+        m_log.Info(
+            std::format(
+                "Reverting {} {} to {} (forced).", GetSlotInfo(slot).name, swap->destParamID, swap->sourceParamID));
+        RevertTempSwap(playerIndex, player, slot, ReadSlot(player, slot));
+    }
+
+    // Last, as per-slot swaps may have been made on top of the loadout.
+    if (m_tempLoadouts[playerIndex])
+        RevertTempLoadout(playerIndex, player);
+}
+
+SlotMask SlotSwapper::GetTempSwapSlots(const int playerIndex) const
+{
+    SlotMask slots;
+    for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+        slots.set(slotIndex, m_tempSwaps[playerIndex][slotIndex].has_value());
+    if (m_tempLoadouts[playerIndex])
+        slots |= m_tempLoadouts[playerIndex]->slots;
+    return slots;
+}
+
+void SlotSwapper::ClearTempSwap(const int playerIndex, const int slotIndex)
+{
+    m_tempSwaps[playerIndex][slotIndex].reset();
+    m_tempSwapTimers.Cancel(playerIndex * EQUIP_SLOT_COUNT + slotIndex);
+    m_timedOutSlots[playerIndex].reset(slotIndex);
+    if (m_journal)
+        m_journal->Clear(playerIndex, static_cast<EquipSlot>(slotIndex), SwapJournalLayer::SWAP);
+}
+
+bool SlotSwapper::RevertTempSwap(
+    const int playerIndex, const PlayerSlots& player, const EquipSlot slot, const int currentParamID)
+{
+    std::optional<TempSwap>& record = m_tempSwaps[playerIndex][static_cast<int>(slot)];
+    if (!record)
+    {
+        m_log.Error(std::format("Tried to revert temporary {} swap that does not exist.", GetSlotInfo(slot).name));
+        return false;
+    }
+
+    const TempSwap swap = *record;
+    ClearTempSwap(playerIndex, static_cast<int>(slot)); // cleared whether or not the revert succeeds
+    const std::string_view slotName = GetSlotInfo(slot).name;
+
+    // Check that the expected temporary ID is still in the slot.
+    if (currentParamID != swap.destParamID)
+    {
+        m_log.Error(
+            std::format(
+                "{} is not the expected temporary ID {}. Cannot revert swap.", slotName, swap.destParamID));
+        return false;
+    }
+
+    if (const SlotWriteResult result =
+            WriteSlotChecked(player, slot, swap.destParamID, swap.sourceParamID, m_writeRaces);
+        result != SlotWriteResult::WRITTEN)
+    {
+        m_log.Error(
+            std::format(
+                "Failed to revert temporary {} {} to {}{}.",
+                slotName,
+                swap.destParamID,
+                swap.sourceParamID,
+                result == SlotWriteResult::RACED ? " (slot changed by the game)" : ""));
+        return false;
+    }
+
+    m_log.Info(std::format("Reverted temporary {} {} to {}.", slotName, swap.destParamID, swap.sourceParamID));
+    return true;
+}
+
+SlotWriteResult SlotSwapper::WriteSlotsAtomic(
+    const PlayerSlots& player,
+    const SlotMask& slots,
+    const std::array<int, EQUIP_SLOT_COUNT>& paramIDs,
+    const std::array<int, EQUIP_SLOT_COUNT>& rollbackParamIDs)
+{
+    // All writes first, with nothing else in between, to keep the half-written window as short as possible.
+    SlotMask written;
+    for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+    {
+        if (!slots.test(slotIndex))
+            continue;
+        const SlotWriteResult result = WriteSlotChecked(
+            player, static_cast<EquipSlot>(slotIndex), rollbackParamIDs[slotIndex], paramIDs[slotIndex], m_writeRaces);
+        if (result != SlotWriteResult::WRITTEN)
+        {
+            // Rolled back with checked writes too, so a slot the game changed in the meantime keeps the game's ID.
+            for (int rollbackIndex = 0; rollbackIndex < slotIndex; ++rollbackIndex)
+            {
+                if (written.test(rollbackIndex)
+                    && WriteSlotChecked(
+                           player,
+                           static_cast<EquipSlot>(rollbackIndex),
+                           paramIDs[rollbackIndex],
+                           rollbackParamIDs[rollbackIndex],
+                           m_writeRaces)
+                           != SlotWriteResult::WRITTEN)
+                {
+                    m_log.Error(
+                        std::format(
+                            "Failed to roll back {} to {}.",
+                            GetSlotInfo(static_cast<EquipSlot>(rollbackIndex)).name,
+                            rollbackParamIDs[rollbackIndex]));
+                }
+            }
+            return result;
+        }
+        written.set(slotIndex);
+    }
+    return SlotWriteResult::WRITTEN;
+}
+
+bool SlotSwapper::RevertTempLoadout(const int playerIndex, const PlayerSlots& player)
+{
+    std::optional<TempLoadout>& record = m_tempLoadouts[playerIndex];
+    if (!record)
+    {
+        m_log.Error("Tried to revert temporary loadout that does not exist.");
+        return false;
+    }
+
+    const TempLoadout loadout = *record;
+    record.reset(); // cleared whether or not the revert succeeds
+    if (m_journal)
+    {
+        for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+        {
+            if (loadout.slots.test(slotIndex))
+                m_journal->Clear(playerIndex, static_cast<EquipSlot>(slotIndex), SwapJournalLayer::LOADOUT);
+        }
+    }
+
+    // All or nothing: every slot must still hold the loadout's ID.
+    for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+    {
+        if (!loadout.slots.test(slotIndex))
+            continue;
+        const auto slot = static_cast<EquipSlot>(slotIndex);
+        if (ReadSlot(player, slot) != loadout.destParamIDs[slotIndex])
+        {
+            m_log.Error(
+                std::format(
+                    "{} is not the expected loadout ID {}. Cannot revert loadout.",
+                    GetSlotInfo(slot).name,
+                    loadout.destParamIDs[slotIndex]));
+            return false;
+        }
+    }
+
+    if (const SlotWriteResult result =
+            WriteSlotsAtomic(player, loadout.slots, loadout.sourceParamIDs, loadout.destParamIDs);
+        result != SlotWriteResult::WRITTEN)
+    {
+        m_log.Error(
+            std::format(
+                "Failed to revert temporary loadout{} (all slots kept).",
+                result == SlotWriteResult::RACED ? " (slot changed by the game)" : ""));
+        return false;
+    }
+
+    m_log.Info(std::format("Reverted temporary loadout ({} slots).", loadout.slots.count()));
+    return true;
+}
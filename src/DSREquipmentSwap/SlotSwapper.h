@@ -0,0 +1,171 @@
+#pragma once
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/DeferredLog.h>
+#include <DSREquipmentSwap/LoadoutTable.h>
+#include <DSREquipmentSwap/SlotAccess.h>
+#include <DSREquipmentSwap/Slots.h>
+#include <DSREquipmentSwap/SwapJournal.h>
+#include <DSREquipmentSwap/TimerWheel.h>
+#include <DSREquipmentSwap/TriggerTable.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief A single temporary swap record.
+    struct TempSwap
+    {
+        int sourceParamID;
+        int destParamID;
+    };
+
+    /// @brief A temporary loadout record: every slot in `slots` goes back from `destParamIDs` to `sourceParamIDs`.
+    struct TempLoadout
+    {
+        SlotMask slots;
+        std::array<int, EQUIP_SLOT_COUNT> sourceParamIDs;
+        std::array<int, EQUIP_SLOT_COUNT> destParamIDs;
+    };
+
+    /// @brief Writes the swaps chosen by `TriggerTable` and tracks temporary swaps per player and slot, so they can be
+    /// reverted later.
+    ///
+    /// @details A temporary weapon swap is reverted as soon as its slot is no longer the current weapon of its hand.
+    /// Armor and ring slots have no "current slot", so their temporary swaps are only reverted when the game is
+    /// (re)loaded (which reverts all temporary swaps). If one temporary swap overrides another in the same slot, the
+    /// original pre-swap ID is discarded; only the latest swap is reverted. A swap made by a trigger with a
+    /// `durationMs` is also reverted once that time is up, driven by a timer wheel, so an update only touches the
+    /// timed swaps that actually expired.
+    ///
+    /// Loadouts are written and reverted all-or-nothing (see `LoadoutConfig`). A temporary loadout is only reverted on
+    /// (re)load, after the per-slot temporary swaps made on top of it. Applying a loadout absorbs the per-slot
+    /// temporary swaps of its slots (and any earlier temporary loadout), so the revert restores the pre-swap IDs.
+    ///
+    /// Every write is compare-and-verify (see `WriteSlotChecked()`): a swap or revert is dropped, and nothing is
+    /// recorded for it, if the game changed the slot since it was read.
+    ///
+    /// With a `SwapJournal`, every temporary record is mirrored into it as it changes, so the swaps a crash leaves in
+    /// the game can be reverted on the next run (see `RecoverJournaledSwaps()`).
+    class SlotSwapper
+    {
+    public:
+        /// @brief Swaps are logged to `log`. Timed temporary swaps run on `clock`.
+        SlotSwapper(DeferredLog& log, const int triggerCooldownMs, const TimerClock& clock = SteadyTimerClock::Get())
+            : m_log(log)
+            , m_triggerCooldownMs(triggerCooldownMs)
+            , m_tempSwapTimers(DSR_MAX_PLAYERS * EQUIP_SLOT_COUNT, clock)
+        {}
+
+        /// @brief Mirror temporary records into `journal` (not owned; may be null), for players whose character is
+        /// known (`PlayerSnapshot::characterID`). Takes the host's recovered swaps for `RecoverJournaledSwaps()` and
+        /// releases those of other players, whose equipment is not in our save.
+        void SetJournal(SwapJournal* journal);
+
+        /// @brief True while there are recovered swaps that `RecoverJournaledSwaps()` has not handled yet.
+        [[nodiscard]] bool HasJournalRecovery() const { return !m_recoveredSwaps.empty(); }
+
+        /// @brief Revert the host's swaps recovered from the journal that were applied to `snapshot.characterID`, if
+        /// the slot still holds the swapped ID. Call on every host update before any of its triggers are checked; only
+        /// does something when a known character other than the last one checked is loaded. Each swap of that
+        /// character is then released from the journal, reverted or not. Swaps of other characters stay in the
+        /// journal until their character is loaded (in this run or a later one). Returns the number of swaps reverted.
+        /// `snapshot` is updated with reverted IDs.
+        int RecoverJournaledSwaps(const PlayerSlots& player, PlayerSnapshot& snapshot);
+
+        /// @brief Set the SpEffect trigger and loadout cooldown (0 == none, for edge-triggered SpEffects).
+        void SetTriggerCooldownMs(const int triggerCooldownMs) { m_triggerCooldownMs = triggerCooldownMs; }
+
+        /// @brief Evaluate all triggers for one player and write the resulting swaps. Returns the number of swaps
+        /// applied successfully.
+        ///
+        /// @details A swap that is not written (raced or failed) does not use up its trigger: its cooldown is cancelled,
+        /// its slot in `snapshot` keeps the old ID, and the trigger's SpEffect (if any) is appended to
+        /// `abortedSpEffects`, so the caller can let it fire again on the next update.
+        int CheckSwapTriggers(
+            int playerIndex,
+            const PlayerSlots& player,
+            PlayerSnapshot& snapshot,
+            TriggerTable& triggers,
+            std::vector<int>& abortedSpEffects);
+
+        /// @brief Evaluate all loadouts for one player and write each one that fires as a single batch. Returns the
+        /// number of loadouts applied. Called before `CheckSwapTriggers()`, whose triggers then see the new IDs. A
+        /// loadout that is not written is handled as an unwritten swap is by `CheckSwapTriggers()`.
+        int ApplyLoadouts(
+            int playerIndex,
+            const PlayerSlots& player,
+            PlayerSnapshot& snapshot,
+            LoadoutTable& loadouts,
+            std::vector<int>& abortedSpEffects);
+
+        /// @brief Collect the timed temporary swaps (of all players) whose duration is up, for the next
+        /// `RevertExpiredTempSwaps()` of their player. Call once per update.
+        void ExpireTimedSwaps();
+
+        /// @brief Revert temporary weapon swaps whose slot is no longer the current weapon of its hand, and timed
+        /// temporary swaps whose duration is up. `snapshot` must contain all slots with temporary swaps and is updated
+        /// with reverted IDs.
+        void RevertExpiredTempSwaps(int playerIndex, const PlayerSlots& player, PlayerSnapshot& snapshot);
+
+        /// @brief Force-revert all temporary swaps (and the temporary loadout) of one player. Called when the game is
+        /// (re)loaded.
+        void RevertTempSwaps(int playerIndex, const PlayerSlots& player);
+
+        /// @brief Get the active temporary swap of a player's slot, if any.
+        [[nodiscard]] const std::optional<TempSwap>& GetTempSwap(int playerIndex, EquipSlot slot) const
+        {
+            return m_tempSwaps[playerIndex][static_cast<int>(slot)];
+        }
+
+        /// @brief Get the active temporary loadout of a player, if any.
+        [[nodiscard]] const std::optional<TempLoadout>& GetTempLoadout(const int playerIndex) const
+        {
+            return m_tempLoadouts[playerIndex];
+        }
+
+        /// @brief Get the set of a player's slots that currently have a temporary swap or temporary loadout.
+        [[nodiscard]] SlotMask GetTempSwapSlots(int playerIndex) const;
+
+        /// @brief Get the counters of writes that raced with the game changing the same slot.
+        [[nodiscard]] const SlotWriteRaceStats& GetWriteRaceStats() const { return m_writeRaces; }
+
+    private:
+        DeferredLog& m_log;
+        int m_triggerCooldownMs;
+        std::array<std::array<std::optional<TempSwap>, EQUIP_SLOT_COUNT>, DSR_MAX_PLAYERS> m_tempSwaps = {};
+        std::array<std::optional<TempLoadout>, DSR_MAX_PLAYERS> m_tempLoadouts = {};
+        TimerWheel m_tempSwapTimers; // key: player index * `EQUIP_SLOT_COUNT` + slot; only for timed temporary swaps
+        std::array<SlotMask, DSR_MAX_PLAYERS> m_timedOutSlots = {}; // timed swaps due for revert
+        std::vector<std::uint32_t> m_expiredTimers; // reused by `ExpireTimedSwaps()`
+        std::vector<PendingSwap> m_pendingSwaps;      // reused by `CheckSwapTriggers()`
+        std::vector<std::uint32_t> m_pendingLoadouts; // reused by `ApplyLoadouts()`
+        SwapJournal* m_journal = nullptr;
+        std::vector<JournaledSwap> m_recoveredSwaps; // host swaps left by the last run, until recovered
+        std::uint64_t m_recoveryCharacterID = 0;     // character `m_recoveredSwaps` were last checked against
+        SlotWriteRaceStats m_writeRaces;
+
+        /// @brief Write `paramIDs` into every slot in `slots`, back to back. Each slot must still hold its
+        /// `rollbackParamIDs` entry. If a write fails or races, write `rollbackParamIDs` back into the slots already
+        /// written and return why.
+        SlotWriteResult WriteSlotsAtomic(
+            const PlayerSlots& player,
+            const SlotMask& slots,
+            const std::array<int, EQUIP_SLOT_COUNT>& paramIDs,
+            const std::array<int, EQUIP_SLOT_COUNT>& rollbackParamIDs);
+
+        /// @brief Revert the temporary loadout of a player if every one of its slots still holds the loadout's ID.
+        /// Clears the record either way. Returns true if the revert was written.
+        bool RevertTempLoadout(int playerIndex, const PlayerSlots& player);
+
+        /// @brief Forget the temporary swap of a player's slot (and its timer), without writing anything.
+        void ClearTempSwap(int playerIndex, int slotIndex);
+
+        /// @brief Check that the temporary ID is still in the slot and write back the pre-swap ID. Clears the record
+        /// either way. Returns true if the revert was written.
+        bool RevertTempSwap(int playerIndex, const PlayerSlots& player, EquipSlot slot, int currentParamID);
+    };
+} // namespace DSREquipmentSwap
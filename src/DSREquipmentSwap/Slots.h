@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Every swappable equipment slot. Triggers, snapshots and temporary swap state are all indexed by this.
+    enum class EquipSlot : std::uint8_t
+    {
+        LEFT_PRIMARY,
+        LEFT_SECONDARY,
+        RIGHT_PRIMARY,
+        RIGHT_SECONDARY,
+        HEAD,
+        BODY,
+        ARMS,
+        LEGS,
+        RING_0,
+        RING_1,
+    };
+
+    constexpr int EQUIP_SLOT_COUNT = 10;
+
+    /// @brief Set of slots, indexed by `EquipSlot`.
+    using SlotMask = std::bitset<EQUIP_SLOT_COUNT>;
+
+    /// @brief Static description of one equipment slot.
+    struct SlotInfo
+    {
+        EquipSlot slot;
+        std::string_view key;  // config name
+        std::string_view name; // for logging
+        int hand;              // 0 = left, 1 = right, -1 = not a weapon slot
+        bool isSecondary;      // weapon slots only
+    };
+
+    /// @brief Slot table, indexed by `EquipSlot`.
+    inline constexpr std::array<SlotInfo, EQUIP_SLOT_COUNT> SLOT_TABLE = {{
+        {EquipSlot::LEFT_PRIMARY, "leftPrimaryWeapon", "Left-Hand Primary Weapon", 0, false},
+        {EquipSlot::LEFT_SECONDARY, "leftSecondaryWeapon", "Left-Hand Secondary Weapon", 0, true},
+        {EquipSlot::RIGHT_PRIMARY, "rightPrimaryWeapon", "Right-Hand Primary Weapon", 1, false},
+        {EquipSlot::RIGHT_SECONDARY, "rightSecondaryWeapon", "Right-Hand Secondary Weapon", 1, true},
+        {EquipSlot::HEAD, "headArmor", "Head Armor", -1, false},
+        {EquipSlot::BODY, "bodyArmor", "Body Armor", -1, false},
+        {EquipSlot::ARMS, "armsArmor", "Arms Armor", -1, false},
+        {EquipSlot::LEGS, "legsArmor", "Legs Armor", -1, false},
+        {EquipSlot::RING_0, "ring0", "Ring Slot 0", -1, false},
+        {EquipSlot::RING_1, "ring1", "Ring Slot 1", -1, false},
+    }};
+
+    [[nodiscard]] constexpr const SlotInfo& GetSlotInfo(const EquipSlot slot)
+    {
+        return SLOT_TABLE[static_cast<int>(slot)];
+    }
+
+    /// @brief Find a slot by config name (`SlotInfo::key`). Returns nullopt if there is none.
+    [[nodiscard]] constexpr std::optional<EquipSlot> FindEquipSlot(const std::string_view key)
+    {
+        for (const SlotInfo& info : SLOT_TABLE)
+        {
+            if (info.key == key)
+                return info.slot;
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] constexpr bool IsWeaponSlot(const EquipSlot slot)
+    {
+        return GetSlotInfo(slot).hand >= 0;
+    }
+
+    /// @brief Equipment state of one player, read once per update and then evaluated locally.
+    struct PlayerSnapshot
+    {
+        std::array<int, EQUIP_SLOT_COUNT> paramIDs = {};
+        std::array<bool, 2> isSecondaryActive = {}; // current weapon slot per hand (left, right)
+        std::vector<int> activeSpEffects;
+        std::vector<int> heldSpEffects; // all active SpEffects, if `activeSpEffects` only has new ones (else empty)
+        std::uint64_t characterID = 0; // identity of the player's character, from its name (0 == unknown)
+
+        [[nodiscard]] int GetParamID(const EquipSlot slot) const { return paramIDs[static_cast<int>(slot)]; }
+
+        void SetParamID(const EquipSlot slot, const int paramID) { paramIDs[static_cast<int>(slot)] = paramID; }
+
+        /// @brief True if `slot` is the current weapon of its hand. Non-weapon slots are always active.
+        [[nodiscard]] bool IsSlotActive(const EquipSlot slot) const
+        {
+            const SlotInfo& info = GetSlotInfo(slot);
+            return info.hand < 0 || isSecondaryActive[info.hand] == info.isSecondary;
+        }
+    };
+} // namespace DSREquipmentSwap
@@ -0,0 +1,66 @@
+#include "SpEffectDeltas.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace DSREquipmentSwap;
+
+SpEffectDeltaTracker::SpEffectDeltaTracker(std::vector<int> relevantSpEffectIDs)
+    : m_relevantSpEffectIDs(std::move(relevantSpEffectIDs))
+    , m_isActive(m_relevantSpEffectIDs.size(), 0)
+{
+    for (std::vector<std::uint8_t>& wasActive : m_wasActive)
+        wasActive.assign(m_relevantSpEffectIDs.size(), 0);
+}
+
+void SpEffectDeltaTracker::Update(
+    const int playerIndex,
+    const std::span<const int> activeSpEffects,
+    const bool isPartial,
+    std::vector<int>& rising,
+    std::vector<int>& falling)
+{
+    rising.clear();
+    falling.clear();
+
+    std::ranges::fill(m_isActive, 0);
+    for (const int spEffectID : activeSpEffects)
+    {
+        const auto relevant = std::ranges::lower_bound(m_relevantSpEffectIDs, spEffectID);
+        if (relevant != m_relevantSpEffectIDs.end() && *relevant == spEffectID)
+            m_isActive[relevant - m_relevantSpEffectIDs.begin()] = 1;
+    }
+
+    std::vector<std::uint8_t>& wasActive = m_wasActive[playerIndex];
+    for (std::size_t i = 0; i < m_relevantSpEffectIDs.size(); ++i)
+    {
+        if (m_isActive[i] && !wasActive[i])
+        {
+            rising.push_back(m_relevantSpEffectIDs[i]);
+            wasActive[i] = 1;
+        }
+        else if (!m_isActive[i] && wasActive[i] && !isPartial)
+        {
+            falling.push_back(m_relevantSpEffectIDs[i]);
+            wasActive[i] = 0;
+        }
+    }
+}
+
+void SpEffectDeltaTracker::Reset(const int playerIndex)
+{
+    std::ranges::fill(m_wasActive[playerIndex], 0);
+}
+
+void SpEffectDeltaTracker::Forget(const int playerIndex, const int spEffectID)
+{
+    const auto relevant = std::ranges::lower_bound(m_relevantSpEffectIDs, spEffectID);
+    if (relevant != m_relevantSpEffectIDs.end() && *relevant == spEffectID)
+        m_wasActive[playerIndex][relevant - m_relevantSpEffectIDs.begin()] = 0;
+}
+
+void SpEffectDeltaTracker::ResetAll()
+{
+    for (int playerIndex = 0; playerIndex < DSR_MAX_PLAYERS; ++playerIndex)
+        Reset(playerIndex);
+}
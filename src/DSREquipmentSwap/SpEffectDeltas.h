@@ -0,0 +1,53 @@
+#pragma once
+
+#include <DSREquipmentSwap/Config.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Tracks which trigger-relevant SpEffects each player had on the previous update, and turns each new
+    /// active SpEffect list into rising (newly active) and falling (no longer active) edges.
+    ///
+    /// @details Only SpEffect IDs that some trigger, chain or loadout uses are tracked, as a bitmap per player that is
+    /// parallel to the sorted ID list. An update costs one binary search per active SpEffect plus one pass over the
+    /// bitmap, and never allocates.
+    class SpEffectDeltaTracker
+    {
+    public:
+        /// @brief Tracks nothing until it is replaced by a tracker of some IDs.
+        SpEffectDeltaTracker() = default;
+
+        /// @brief `relevantSpEffectIDs` must be sorted, without duplicates.
+        explicit SpEffectDeltaTracker(std::vector<int> relevantSpEffectIDs);
+
+        /// @brief Compare `activeSpEffects` with the player's previous set, replace `rising` and `falling` with the
+        /// relevant IDs that became active and inactive (sorted), and remember the new set. If `isPartial` (the list
+        /// was cut short), SpEffects missing from it are assumed to still be active, so nothing falls.
+        void Update(
+            int playerIndex,
+            std::span<const int> activeSpEffects,
+            bool isPartial,
+            std::vector<int>& rising,
+            std::vector<int>& falling);
+
+        /// @brief Forget the previous set of one player (e.g. a different player in that slot), so that every
+        /// relevant SpEffect active on the next update is a rising edge.
+        void Reset(int playerIndex);
+
+        /// @brief Forget the previous sets of all players (e.g. on game load).
+        void ResetAll();
+
+        /// @brief Forget that `spEffectID` was active for one player (e.g. its trigger's swap was not written), so that
+        /// it is a rising edge again on the next update if it is still active.
+        void Forget(int playerIndex, int spEffectID);
+
+    private:
+        std::vector<int> m_relevantSpEffectIDs;
+        std::array<std::vector<std::uint8_t>, DSR_MAX_PLAYERS> m_wasActive; // parallel to `m_relevantSpEffectIDs`
+        std::vector<std::uint8_t> m_isActive;                               // scratch for `Update()`
+    };
+} // namespace DSREquipmentSwap
@@ -0,0 +1,76 @@
+#include "SpEffectEvents.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace DSREquipmentSwap;
+
+bool SpEffectEventQueue::Push(const int playerIndex, const int spEffectID)
+{
+    if (!m_queue.TryPush(SpEffectEvent{playerIndex, spEffectID, std::chrono::steady_clock::now()}))
+    {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_wakeSignal.Notify();
+    return true;
+}
+
+std::size_t SpEffectEventQueue::DrainByPlayer(const std::span<std::vector<int>> spEffectsByPlayer)
+{
+    for (std::vector<int>& spEffects : spEffectsByPlayer)
+        spEffects.clear();
+
+    const auto now = std::chrono::steady_clock::now();
+    std::size_t drained = 0;
+    while (const std::optional<SpEffectEvent> event = m_queue.TryPop())
+    {
+        ++drained;
+        if (event->playerIndex < 0 || event->playerIndex >= static_cast<int>(spEffectsByPlayer.size()))
+        {
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        const auto latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(now - event->timestamp).count();
+        m_maxLatencyUs = std::max(m_maxLatencyUs, static_cast<std::int64_t>(latencyUs));
+
+        // The same SpEffect may be (re)applied several times between drains. Triggers only need to see it once.
+        std::vector<int>& spEffects = spEffectsByPlayer[event->playerIndex];
+        if (std::ranges::find(spEffects, event->spEffectID) == spEffects.end())
+            spEffects.push_back(event->spEffectID);
+    }
+    return drained;
+}
+
+void SpEffectEventQueue::Clear()
+{
+    while (m_queue.TryPop())
+    {
+    }
+}
+
+std::atomic<SpEffectEventQueue*> ExternalSpEffectEventSource::s_activeQueue = nullptr;
+std::atomic<int> ExternalSpEffectEventSource::s_pushesInFlight = 0;
+
+bool ExternalSpEffectEventSource::Start(SpEffectEventQueue& queue)
+{
+    SpEffectEventQueue* expected = nullptr;
+    return s_activeQueue.compare_exchange_strong(expected, &queue);
+}
+
+void ExternalSpEffectEventSource::Stop()
+{
+    s_activeQueue.store(nullptr);
+    while (s_pushesInFlight.load() > 0)
+        std::this_thread::yield();
+}
+
+bool ExternalSpEffectEventSource::PushSpEffectApplied(const int playerIndex, const int spEffectID)
+{
+    s_pushesInFlight.fetch_add(1);
+    SpEffectEventQueue* queue = s_activeQueue.load();
+    const bool pushed = queue != nullptr && queue->Push(playerIndex, spEffectID);
+    s_pushesInFlight.fetch_sub(1);
+    return pushed;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <DSREquipmentSwap/MpscQueue.h>
+#include <DSREquipmentSwap/WakeSignal.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief A single "SpEffect was applied to player" notification.
+    struct SpEffectEvent
+    {
+        int playerIndex = -1; // ChrSlot index of the player (0 to DSR_MAX_PLAYERS - 1)
+        int spEffectID = -1;
+        std::chrono::steady_clock::time_point timestamp{};
+    };
+
+    /// @brief Lock-free queue of `SpEffectEvent`s, filled by a `SpEffectEventSource` and drained by the swapper thread.
+    class SpEffectEventQueue
+    {
+    public:
+        explicit SpEffectEventQueue(WakeSignal& wakeSignal)
+            : m_wakeSignal(wakeSignal)
+        {}
+
+        /// @brief Record that `spEffectID` was applied to `playerIndex` and wake the swapper thread.
+        /// Safe to call from any thread (e.g. a game-thread detour). Returns false if the event had to be dropped.
+        bool Push(int playerIndex, int spEffectID);
+
+        /// @brief Drain all queued events into per-player SpEffect ID lists (deduplicated, oldest first).
+        /// Lists are cleared first. Events for player indices outside `spEffectsByPlayer` are discarded.
+        /// Returns the number of events drained. Must only be called from the swapper thread.
+        std::size_t DrainByPlayer(std::span<std::vector<int>> spEffectsByPlayer);
+
+        /// @brief Discard all queued events (e.g. while the game is not loaded).
+        void Clear();
+
+        /// @brief Number of events dropped because the queue was full or the player index was invalid.
+        [[nodiscard]] std::uint64_t GetDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+        /// @brief Largest push-to-drain latency seen by `DrainByPlayer()`, in microseconds.
+        [[nodiscard]] std::int64_t GetMaxLatencyUs() const { return m_maxLatencyUs; }
+
+    private:
+        static constexpr std::size_t QUEUE_CAPACITY = 1024;
+
+        WakeSignal& m_wakeSignal;
+        MpscQueue<SpEffectEvent, QUEUE_CAPACITY> m_queue;
+        std::atomic<std::uint64_t> m_droppedCount = 0;
+        std::int64_t m_maxLatencyUs = 0; // consumer only
+    };
+
+    /// @brief Interface for anything that can report SpEffect applications as they happen, instead of the swapper
+    /// polling each player's active SpEffect list on every tick.
+    class SpEffectEventSource
+    {
+    public:
+        virtual ~SpEffectEventSource() = default;
+
+        /// @brief Begin pushing events into `queue`. Returns false if the source could not be installed, in which case
+        /// the swapper falls back to polling.
+        virtual bool Start(SpEffectEventQueue& queue) = 0;
+
+        /// @brief Stop pushing events. The queue passed to `Start()` must not be touched after this returns.
+        virtual void Stop() = 0;
+
+        [[nodiscard]] virtual std::string GetName() const = 0;
+    };
+
+    /// @brief Event source fed through a single process-wide entry point, `PushSpEffectApplied()`.
+    ///
+    /// @details The DLL exports this entry point so that a detour on the game's SpEffect-apply routine (or another mod
+    /// that already has one) can forward applications to us. Only one instance may be started at a time.
+    class ExternalSpEffectEventSource final : public SpEffectEventSource
+    {
+    public:
+        bool Start(SpEffectEventQueue& queue) override;
+        void Stop() override;
+        [[nodiscard]] std::string GetName() const override { return "External"; }
+
+        /// @brief Forward a SpEffect application to the started source, if any. Returns false if nothing is listening
+        /// or the event was dropped.
+        static bool PushSpEffectApplied(int playerIndex, int spEffectID);
+
+    private:
+        static std::atomic<SpEffectEventQueue*> s_activeQueue;
+        static std::atomic<int> s_pushesInFlight; // lets `Stop()` wait out producers still holding the old queue
+    };
+} // namespace DSREquipmentSwap
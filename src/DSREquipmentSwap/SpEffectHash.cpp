@@ -0,0 +1,143 @@
+#include "SpEffectHash.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace DSREquipmentSwap;
+
+namespace
+{
+    // Average keys per bucket. Smaller buckets make pilots easier to find but need more of them.
+    constexpr std::size_t KEYS_PER_BUCKET = 3;
+
+    // Pilots tried per bucket before the multiplier is abandoned.
+    constexpr std::uint32_t MAX_PILOT = 1 << 20;
+
+    /// @brief SplitMix64 step, used as a fixed (reproducible) source of multipliers.
+    std::uint64_t NextRandom(std::uint64_t& state)
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /// @brief Try to find a pilot for every bucket with the given `multiplier`. Returns false if some bucket has no
+    /// pilot (or two keys share a hash), in which case the caller should try another multiplier.
+    bool SearchPilots(
+        const std::vector<std::int32_t>& keys,
+        const std::uint64_t multiplier,
+        std::vector<std::uint32_t>& pilots,
+        std::vector<std::int32_t>& cellKeys)
+    {
+        const std::size_t bucketCount = pilots.size();
+        std::vector<std::vector<std::uint32_t>> buckets(bucketCount); // key hashes
+        for (const std::int32_t key : keys)
+        {
+            const std::uint32_t hash = SpEffectHashView::Hash(key, multiplier);
+            buckets[SpEffectHashView::Reduce(hash, bucketCount)].push_back(hash);
+        }
+
+        // Place the largest buckets first, while the table is still empty.
+        std::vector<std::size_t> order(bucketCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::stable_sort(order, [&buckets](const std::size_t a, const std::size_t b)
+        {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        std::vector<bool> taken(keys.size(), false);
+        std::vector<std::uint32_t> cells;
+        for (const std::size_t bucket : order)
+        {
+            const std::vector<std::uint32_t>& hashes = buckets[bucket];
+            if (hashes.empty())
+                break; // all remaining buckets are empty
+
+            std::uint32_t pilot = 0;
+            for (; pilot < MAX_PILOT; ++pilot)
+            {
+                cells.clear();
+                bool fits = true;
+                for (const std::uint32_t hash : hashes)
+                {
+                    const std::uint32_t cell = SpEffectHashView::GetCell(hash, pilot, keys.size());
+                    if (taken[cell] || std::ranges::find(cells, cell) != cells.end())
+                    {
+                        fits = false;
+                        break;
+                    }
+                    cells.push_back(cell);
+                }
+                if (fits)
+                    break;
+            }
+            if (pilot == MAX_PILOT)
+                return false;
+
+            pilots[bucket] = pilot;
+            for (const std::uint32_t cell : cells)
+                taken[cell] = true;
+        }
+
+        // Every key now has its own cell. Record which key is where, for the lookup compare.
+        for (const std::int32_t key : keys)
+        {
+            const std::uint32_t hash = SpEffectHashView::Hash(key, multiplier);
+            const std::uint32_t pilot = pilots[SpEffectHashView::Reduce(hash, bucketCount)];
+            cellKeys[SpEffectHashView::GetCell(hash, pilot, keys.size())] = key;
+        }
+        return true;
+    }
+}
+
+SpEffectHash SpEffectHash::Build(const std::span<const std::int32_t> triggerSpEffectIDs)
+{
+    std::vector<std::int32_t> keys;
+    for (const std::int32_t spEffectID : triggerSpEffectIDs)
+    {
+        if (spEffectID > 0) // "no SpEffect"
+            keys.push_back(spEffectID);
+    }
+    std::ranges::sort(keys);
+    keys.erase(std::ranges::unique(keys).begin(), keys.end());
+
+    SpEffectHash hash;
+    if (keys.empty())
+        return hash;
+
+    hash.m_pilots.resize(keys.size() / KEYS_PER_BUCKET + 1);
+    hash.m_keys.resize(keys.size());
+    std::uint64_t state = 0;
+    do
+    {
+        hash.m_multiplier = NextRandom(state) | 1;
+    } while (!SearchPilots(keys, hash.m_multiplier, hash.m_pilots, hash.m_keys));
+
+    // Group trigger indices by cell (counting sort), keeping trigger order within each list.
+    const SpEffectHashView view = {hash.m_multiplier, hash.m_pilots, hash.m_keys, {}, {}};
+    auto getCell = [&view](const std::int32_t key)
+    {
+        const std::uint32_t keyHash = SpEffectHashView::Hash(key, view.multiplier);
+        return SpEffectHashView::GetCell(
+            keyHash, view.pilots[SpEffectHashView::Reduce(keyHash, view.pilots.size())], view.keys.size());
+    };
+
+    hash.m_listStarts.assign(keys.size() + 1, 0);
+    for (const std::int32_t spEffectID : triggerSpEffectIDs)
+    {
+        if (spEffectID > 0)
+            ++hash.m_listStarts[getCell(spEffectID) + 1];
+    }
+    std::partial_sum(hash.m_listStarts.begin(), hash.m_listStarts.end(), hash.m_listStarts.begin());
+
+    hash.m_triggerIndices.resize(hash.m_listStarts.back());
+    std::vector<std::uint32_t> next(hash.m_listStarts.begin(), hash.m_listStarts.end() - 1);
+    for (std::uint32_t triggerIndex = 0; triggerIndex < triggerSpEffectIDs.size(); ++triggerIndex)
+    {
+        const std::int32_t spEffectID = triggerSpEffectIDs[triggerIndex];
+        if (spEffectID > 0)
+            hash.m_triggerIndices[next[getCell(spEffectID)]++] = triggerIndex;
+    }
+    return hash;
+}
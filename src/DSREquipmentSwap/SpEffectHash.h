@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Read-only minimal perfect hash from SpEffect ID to the indices of the triggers that react to it.
+    ///
+    /// @details Hash-and-displace (CHD/PTHash style): a key's bucket is chosen by one multiply-shift, and each bucket
+    /// has a "pilot" that was searched at build time so that every key of every bucket lands in its own cell. There are
+    /// exactly as many cells as keys. A lookup is one multiply, one pilot load, a few integer ops and one key compare,
+    /// with no chaining or probing, so the (common) miss costs the same as a hit.
+    ///
+    /// Only holds spans, so a view can be `constexpr` (see the generated `EmbeddedConfigData.h`).
+    struct SpEffectHashView
+    {
+        std::uint64_t multiplier = 1;
+        std::span<const std::uint32_t> pilots;         // one per bucket
+        std::span<const std::int32_t> keys;            // one per cell (SpEffect ID)
+        std::span<const std::uint32_t> listStarts;     // one per cell, plus end: cell N is [start[N], start[N + 1])
+        std::span<const std::uint32_t> triggerIndices; // trigger lists, in cell order
+
+        /// @brief Top 32 bits of the key hash. Picks the bucket and (mixed with its pilot) the cell.
+        [[nodiscard]] static constexpr std::uint32_t Hash(const std::int32_t key, const std::uint64_t multiplier)
+        {
+            const auto unsignedKey = static_cast<std::uint64_t>(static_cast<std::uint32_t>(key));
+            return static_cast<std::uint32_t>((unsignedKey * multiplier) >> 32);
+        }
+
+        /// @brief Map a uniform 32-bit value onto `[0, range)` without a division.
+        [[nodiscard]] static constexpr std::uint32_t Reduce(const std::uint32_t x, const std::size_t range)
+        {
+            return static_cast<std::uint32_t>((static_cast<std::uint64_t>(x) * range) >> 32);
+        }
+
+        /// @brief Cell of a key with `hash` in a bucket with `pilot`.
+        [[nodiscard]] static constexpr std::uint32_t GetCell(
+            const std::uint32_t hash, const std::uint32_t pilot, const std::size_t cellCount)
+        {
+            std::uint32_t x = hash ^ (pilot * 0x9E3779B9u);
+            x ^= x >> 16;
+            x *= 0x85EBCA6Bu;
+            x ^= x >> 13;
+            return Reduce(x, cellCount);
+        }
+
+        /// @brief Get the indices of all triggers with SpEffect `spEffectID` (empty if there are none).
+        [[nodiscard]] constexpr std::span<const std::uint32_t> Find(const std::int32_t spEffectID) const
+        {
+            if (keys.empty())
+                return {};
+            const std::uint32_t hash = Hash(spEffectID, multiplier);
+            const std::uint32_t cell = GetCell(hash, pilots[Reduce(hash, pilots.size())], keys.size());
+            if (keys[cell] != spEffectID)
+                return {};
+            return triggerIndices.subspan(listStarts[cell], listStarts[cell + 1] - listStarts[cell]);
+        }
+    };
+
+    /// @brief Owning builder and storage for a `SpEffectHashView`, built once at config load.
+    class SpEffectHash
+    {
+    public:
+        /// @brief Empty hash (finds nothing).
+        SpEffectHash() = default;
+
+        /// @brief Build from the SpEffect ID of every trigger, indexed by trigger index. IDs of 0 or less mean "no
+        /// SpEffect" and are skipped. Deterministic: the same IDs always give the same tables.
+        [[nodiscard]] static SpEffectHash Build(std::span<const std::int32_t> triggerSpEffectIDs);
+
+        [[nodiscard]] SpEffectHashView GetView() const
+        {
+            return {m_multiplier, m_pilots, m_keys, m_listStarts, m_triggerIndices};
+        }
+
+        [[nodiscard]] std::span<const std::uint32_t> Find(const std::int32_t spEffectID) const
+        {
+            return GetView().Find(spEffectID);
+        }
+
+        /// @brief Get the heap memory held by the tables, in bytes.
+        [[nodiscard]] std::size_t GetMemoryBytes() const
+        {
+            return m_pilots.capacity() * sizeof(std::uint32_t) + m_keys.capacity() * sizeof(std::int32_t)
+                + m_listStarts.capacity() * sizeof(std::uint32_t) + m_triggerIndices.capacity() * sizeof(std::uint32_t);
+        }
+
+    private:
+        std::uint64_t m_multiplier = 1;
+        std::vector<std::uint32_t> m_pilots;
+        std::vector<std::int32_t> m_keys;
+        std::vector<std::uint32_t> m_listStarts;
+        std::vector<std::uint32_t> m_triggerIndices;
+    };
+} // namespace DSREquipmentSwap
@@ -0,0 +1,103 @@
+#include "SpEffectListReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+using namespace DSREquipmentSwap;
+
+SpEffectListReader::SpEffectListReader(SpEffectListConfig config, std::vector<int> relevantSpEffectIDs)
+    : m_config(std::move(config))
+    , m_relevantSpEffectIDs(std::move(relevantSpEffectIDs))
+    , m_relevantSeen(m_relevantSpEffectIDs.size(), 0)
+{
+}
+
+bool SpEffectListReader::Read(
+    const MemoryBackend& memory, const std::uintptr_t playerInsAddress, std::vector<int>& spEffectIDs)
+{
+    spEffectIDs.clear();
+    m_lastNodeCount = 0;
+    m_lastReadCount = 0;
+    m_wasLastTruncated = false;
+    for (CachedPages& pages : m_cachedPages)
+        pages.size = 0; // the game may have changed the list since the last read
+
+    if (m_relevantSpEffectIDs.empty())
+        return true; // no SpEffect triggers; nothing in the list matters
+
+    // Follow the pointer path to the first node.
+    std::uintptr_t node = playerInsAddress;
+    for (const int offset : m_config.headPointerPath)
+    {
+        std::uint64_t next = 0;
+        ++m_lastReadCount;
+        if (!memory.Read(node + offset, next))
+            return false;
+        node = static_cast<std::uintptr_t>(next);
+        if (node == 0)
+            return true; // no list (yet)
+    }
+
+    std::ranges::fill(m_relevantSeen, 0);
+    std::size_t relevantSeenCount = 0;
+    while (node != 0)
+    {
+        if (m_lastNodeCount == m_config.maxNodesPerUpdate)
+        {
+            m_wasLastTruncated = true;
+            break;
+        }
+
+        const std::byte* data = GetNode(memory, node);
+        if (data == nullptr)
+            return false;
+        std::int32_t spEffectID;
+        std::uint64_t next;
+        std::memcpy(&spEffectID, data + m_config.nodeIDOffset, sizeof(spEffectID));
+        std::memcpy(&next, data + m_config.nodeNextOffset, sizeof(next));
+        spEffectIDs.push_back(spEffectID);
+        ++m_lastNodeCount;
+
+        const auto relevant = std::ranges::lower_bound(m_relevantSpEffectIDs, spEffectID);
+        if (relevant != m_relevantSpEffectIDs.end() && *relevant == spEffectID)
+        {
+            std::uint8_t& seen = m_relevantSeen[relevant - m_relevantSpEffectIDs.begin()];
+            if (!seen)
+            {
+                seen = 1;
+                if (++relevantSeenCount == m_relevantSpEffectIDs.size())
+                    break; // every trigger SpEffect is active; the rest of the list cannot matter
+            }
+        }
+        node = static_cast<std::uintptr_t>(next);
+    }
+    return true;
+}
+
+const std::byte* SpEffectListReader::GetNode(const MemoryBackend& memory, const std::uintptr_t address)
+{
+    const auto nodeSize = static_cast<std::uintptr_t>(m_config.nodeSize);
+    for (const CachedPages& pages : m_cachedPages)
+    {
+        if (address >= pages.start && address + nodeSize <= pages.start + pages.size)
+            return pages.data.data() + (address - pages.start);
+    }
+
+    // Whole pages: readable if the node is, and later nodes from the same pool page are free.
+    const std::uintptr_t start = address & ~(PAGE_SIZE - 1);
+    const std::uintptr_t end = ((address + nodeSize - 1) | (PAGE_SIZE - 1)) + 1;
+    CachedPages& pages = m_cachedPages[m_nextCacheSlot];
+    m_nextCacheSlot = (m_nextCacheSlot + 1) % m_cachedPages.size();
+    pages.data.resize(end - start);
+
+    ++m_lastReadCount;
+    if (!memory.Read(start, pages.data.data(), pages.data.size()))
+    {
+        pages.size = 0;
+        return nullptr;
+    }
+    pages.start = start;
+    pages.size = pages.data.size();
+    return pages.data.data() + (address - start);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/MemoryBackend.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Reads a player's active SpEffect list (a linked list in game memory) without one read per node.
+    ///
+    /// @details List nodes come from a pool, so nodes are usually on a few shared pages. Instead of reading each node
+    /// on its own, the reader copies the whole page of the first node it has not got yet, and walks as many nodes as
+    /// it can from its local page copies (up to `CACHED_PAGE_COUNT` per read, reused round-robin).
+    ///
+    /// Two limits keep the cost per update bounded: the walk stops as soon as every SpEffect ID that some trigger reacts
+    /// to has been seen (the rest of the list cannot change any trigger), and after `maxNodesPerUpdate` nodes. With no
+    /// SpEffect triggers at all, nothing is read.
+    class SpEffectListReader
+    {
+    public:
+        static constexpr std::uintptr_t PAGE_SIZE = 0x1000;
+        static constexpr std::size_t CACHED_PAGE_COUNT = 16;
+
+        /// @brief `relevantSpEffectIDs` must be sorted, without duplicates.
+        SpEffectListReader(SpEffectListConfig config, std::vector<int> relevantSpEffectIDs);
+
+        /// @brief Replace `spEffectIDs` with the active SpEffect IDs of the player whose PlayerIns is at
+        /// `playerInsAddress`, in list order. Returns false if the list could not be read (`spEffectIDs` then holds
+        /// the IDs read before the failure).
+        bool Read(const MemoryBackend& memory, std::uintptr_t playerInsAddress, std::vector<int>& spEffectIDs);
+
+        /// @brief Number of list nodes walked by the last `Read()`.
+        [[nodiscard]] int GetLastNodeCount() const { return m_lastNodeCount; }
+
+        /// @brief Number of backend reads issued by the last `Read()`.
+        [[nodiscard]] int GetLastReadCount() const { return m_lastReadCount; }
+
+        /// @brief True if the last `Read()` hit `maxNodesPerUpdate` before the end of the list.
+        [[nodiscard]] bool WasLastTruncated() const { return m_wasLastTruncated; }
+
+    private:
+        SpEffectListConfig m_config;
+        std::vector<int> m_relevantSpEffectIDs;
+        std::vector<std::uint8_t> m_relevantSeen; // parallel to `m_relevantSpEffectIDs`, reset by each `Read()`
+
+        // Local copy of `[start, start + size)` (one page, or two for a node that crosses a page end).
+        struct CachedPages
+        {
+            std::uintptr_t start = 0;
+            std::size_t size = 0; // 0 == empty
+            std::vector<std::byte> data;
+        };
+
+        std::array<CachedPages, CACHED_PAGE_COUNT> m_cachedPages;
+        std::size_t m_nextCacheSlot = 0;
+
+        int m_lastNodeCount = 0;
+        int m_lastReadCount = 0;
+        bool m_wasLastTruncated = false;
+
+        /// @brief Get the node at `address` from the page cache, reading its page(s) first if needed.
+        /// Returns nullptr if the node is not readable.
+        const std::byte* GetNode(const MemoryBackend& memory, std::uintptr_t address);
+    };
+} // namespace DSREquipmentSwap
@@ -0,0 +1,123 @@
+#include "StatusPage.h"
+
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace DSREquipmentSwap;
+
+static_assert(std::is_trivially_copyable_v<SwapperStatus>, "SwapperStatus must be copyable as raw memory.");
+
+SharedStatusPage::~SharedStatusPage()
+{
+    if (m_block == nullptr)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_block);
+    CloseHandle(m_mappingHandle);
+#else
+    munmap(m_block, sizeof(StatusPageBlock));
+    if (m_isOwner)
+        shm_unlink(m_posixName.c_str());
+#endif
+}
+
+std::unique_ptr<SharedStatusPage> SharedStatusPage::Create(const std::string& name)
+{
+    std::unique_ptr<SharedStatusPage> page(new SharedStatusPage());
+    if (!page->Map(name, true))
+        return nullptr;
+
+    StatusPageBlock* block = page->m_block;
+    block->sequence.store(0, std::memory_order_relaxed);
+    std::memset(&block->status, 0, sizeof(SwapperStatus));
+    block->magic = STATUS_PAGE_MAGIC;
+    block->version = STATUS_PAGE_VERSION;
+    block->payloadSize = sizeof(SwapperStatus);
+    return page;
+}
+
+std::unique_ptr<SharedStatusPage> SharedStatusPage::Open(const std::string& name)
+{
+    std::unique_ptr<SharedStatusPage> page(new SharedStatusPage());
+    if (!page->Map(name, false))
+        return nullptr;
+
+    const StatusPageBlock* block = page->m_block;
+    if (block->magic != STATUS_PAGE_MAGIC || block->version != STATUS_PAGE_VERSION
+        || block->payloadSize != sizeof(SwapperStatus))
+        return nullptr;
+    return page;
+}
+
+void SharedStatusPage::Publish(const SwapperStatus& status)
+{
+    const std::uint32_t sequence = m_block->sequence.load(std::memory_order_relaxed);
+    m_block->sequence.store(sequence + 1, std::memory_order_relaxed); // odd: write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&m_block->status, &status, sizeof(SwapperStatus));
+    m_block->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool SharedStatusPage::TryRead(SwapperStatus& status, const int maxAttempts) const
+{
+    for (int attempt = 0; attempt < maxAttempts; ++attempt)
+    {
+        const std::uint32_t before = m_block->sequence.load(std::memory_order_acquire);
+        if (before & 1)
+            continue; // writer active
+        std::memcpy(&status, &m_block->status, sizeof(SwapperStatus));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_block->sequence.load(std::memory_order_relaxed) == before)
+            return true;
+    }
+    return false;
+}
+
+bool SharedStatusPage::Map(const std::string& name, const bool create)
+{
+    void* view = nullptr;
+#ifdef _WIN32
+    const std::string mappingName = "Local\\" + name;
+    HANDLE mapping = create
+        ? CreateFileMappingA(
+              INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(StatusPageBlock), mappingName.c_str())
+        : OpenFileMappingA(FILE_MAP_READ, FALSE, mappingName.c_str());
+    if (mapping == nullptr)
+        return false;
+    const DWORD access = create ? FILE_MAP_READ | FILE_MAP_WRITE : FILE_MAP_READ;
+    view = MapViewOfFile(mapping, access, 0, 0, sizeof(StatusPageBlock));
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_mappingHandle = mapping;
+#else
+    m_posixName = "/" + name;
+    const int fd = shm_open(m_posixName.c_str(), create ? O_CREAT | O_RDWR : O_RDONLY, 0644);
+    if (fd < 0)
+        return false;
+    if (create && ftruncate(fd, sizeof(StatusPageBlock)) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    view = mmap(nullptr, sizeof(StatusPageBlock), create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+        return false;
+#endif
+    m_block = static_cast<StatusPageBlock*>(view);
+    m_isOwner = create;
+    return true;
+}
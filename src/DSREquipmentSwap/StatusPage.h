@@ -0,0 +1,103 @@
+#pragma once
+
+#include <DSREquipmentSwap/Slots.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace DSREquipmentSwap
+{
+    // Fixed layout limits. These are part of the shared layout, so changing them requires a new `STATUS_PAGE_VERSION`.
+    constexpr int STATUS_PAGE_MAX_PLAYERS = 4;
+    constexpr int STATUS_PAGE_SLOT_COUNT = EQUIP_SLOT_COUNT; // indexed by `EquipSlot`
+    constexpr int STATUS_PAGE_MAX_TRIGGERS = 256;
+
+    constexpr std::uint32_t STATUS_PAGE_MAGIC = 0x53455344; // "DSES"
+    constexpr std::uint32_t STATUS_PAGE_VERSION = 1;
+
+    /// @brief Active temporary swap in one slot. `active == 0` means no temporary swap.
+    struct StatusTempSwap
+    {
+        std::int32_t active;
+        std::int32_t sourceParamID;
+        std::int32_t destParamID;
+    };
+
+    /// @brief Everything the swapper publishes each tick. Plain data with a fixed layout (no pointers), so it can be
+    /// copied in and out of shared memory as a block.
+    struct SwapperStatus
+    {
+        std::uint64_t tick;
+        std::int64_t publishTimeUs; // `steady_clock` time of publication (same clock in every process)
+        std::uint8_t gameLoaded;
+        std::uint8_t paused;
+        std::uint8_t connectedPlayerMask; // bit N set if ChrSlot N has a player
+        std::uint8_t reserved0;
+        std::int32_t monitorIntervalMs;
+
+        StatusTempSwap tempSwaps[STATUS_PAGE_MAX_PLAYERS][STATUS_PAGE_SLOT_COUNT];
+
+        // Triggers in trigger table order (sorted by `EquipSlot`, then config order). Only the first
+        // `STATUS_PAGE_MAX_TRIGGERS` are published. A deadline of 0 means the trigger is not on cooldown.
+        std::uint32_t triggerCount;
+        std::uint32_t reserved1;
+        std::int64_t cooldownDeadlinesUs[STATUS_PAGE_MAX_TRIGGERS][STATUS_PAGE_MAX_PLAYERS];
+
+        // `SwapperMetrics` counters.
+        std::uint64_t ticks;
+        std::uint64_t pausedTicks;
+        std::uint64_t swapsApplied;
+        std::uint64_t tempSwapForceReverts;
+        std::uint64_t commandsProcessed;
+        std::uint64_t commandsRejected;
+        std::uint64_t spEffectEventsDropped;
+    };
+
+    /// @brief Header + payload mapped into shared memory. `sequence` is a seqlock: odd while a write is in progress.
+    struct StatusPageBlock
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t payloadSize;
+        std::atomic<std::uint32_t> sequence;
+        SwapperStatus status;
+    };
+
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Status page seqlock must be lock-free.");
+
+    /// @brief Named shared-memory mapping of one `StatusPageBlock`.
+    class SharedStatusPage
+    {
+    public:
+        ~SharedStatusPage();
+
+        SharedStatusPage(const SharedStatusPage&) = delete;
+        SharedStatusPage& operator=(const SharedStatusPage&) = delete;
+
+        /// @brief Create (or reopen) the named page for publishing. Returns nullptr on failure.
+        static std::unique_ptr<SharedStatusPage> Create(const std::string& name);
+
+        /// @brief Open an existing named page (read-only). Returns nullptr if it does not exist or has another layout.
+        static std::unique_ptr<SharedStatusPage> Open(const std::string& name);
+
+        /// @brief Write a new status. Never blocks; readers retry if they overlap the write. Single writer only.
+        void Publish(const SwapperStatus& status);
+
+        /// @brief Copy a consistent snapshot into `status`. Returns false if no consistent copy was obtained within
+        /// `maxAttempts` (the writer kept overlapping).
+        bool TryRead(SwapperStatus& status, int maxAttempts = 64) const;
+
+    private:
+        SharedStatusPage() = default;
+
+        /// @brief Map the named region. `create` decides whether it may be created.
+        bool Map(const std::string& name, bool create);
+
+        StatusPageBlock* m_block = nullptr;
+        void* m_mappingHandle = nullptr; // Windows file mapping handle
+        std::string m_posixName;         // POSIX shm name (unlinked by the creator)
+        bool m_isOwner = false;
+    };
+} // namespace DSREquipmentSwap
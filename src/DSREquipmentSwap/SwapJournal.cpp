@@ -0,0 +1,340 @@
+#include "SwapJournal.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace DSREquipmentSwap;
+
+namespace
+{
+    /// @brief True if `a` and `b` are records of the same player, slot, layer and character.
+    bool IsSameRecord(const JournaledSwap& a, const JournaledSwap& b)
+    {
+        return a.characterID == b.characterID && a.playerIndex == b.playerIndex && a.slot == b.slot
+               && a.layer == b.layer;
+    }
+} // namespace
+
+SwapJournal::~SwapJournal()
+{
+    if (m_view == nullptr)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_view);
+    CloseHandle(m_mappingHandle);
+    CloseHandle(m_fileHandle);
+#else
+    munmap(m_view, FILE_SIZE);
+#endif
+}
+
+std::unique_ptr<SwapJournal> SwapJournal::Open(const std::filesystem::path& path)
+{
+    std::unique_ptr<SwapJournal> journal(new SwapJournal());
+    if (!journal->Map(path))
+        return nullptr;
+
+    auto* header = reinterpret_cast<Header*>(journal->m_view);
+    if (header->magic != SWAP_JOURNAL_MAGIC || header->version != SWAP_JOURNAL_VERSION
+        || header->recordSize != sizeof(SwapJournalRecord) || header->regionCapacity != REGION_CAPACITY)
+    {
+        // New file, or another layout: start over.
+        std::memset(journal->m_view, 0, FILE_SIZE);
+        header->magic = SWAP_JOURNAL_MAGIC;
+        header->version = SWAP_JOURNAL_VERSION;
+        header->recordSize = sizeof(SwapJournalRecord);
+        header->regionCapacity = REGION_CAPACITY;
+    }
+
+    if (journal->Replay())
+    {
+        std::vector<JournaledSwap>& kept = journal->m_kept;
+        if (kept.size() > MAX_KEPT_SWAPS)
+        {
+            journal->m_droppedCount = kept.size() - MAX_KEPT_SWAPS;
+            kept.erase(kept.begin(), kept.begin() + static_cast<std::ptrdiff_t>(journal->m_droppedCount));
+        }
+        journal->m_liveCount = kept.size();
+        journal->m_recovered = kept;
+        std::ranges::stable_partition(
+            journal->m_recovered, [](const JournaledSwap& swap) { return swap.layer == SwapJournalLayer::SWAP; });
+    }
+
+    // Start a fresh region holding only the live set, so this run has the whole region to append to.
+    journal->Compact();
+    journal->m_compactionCount = 0;
+    return journal;
+}
+
+void SwapJournal::Set(const JournaledSwap& swap)
+{
+    std::optional<JournaledSwap>& live =
+        m_live[swap.playerIndex][static_cast<int>(swap.slot)][static_cast<int>(swap.layer)];
+    if (live && *live == swap)
+        return;
+    if (live && live->characterID != swap.characterID)
+    {
+        // Another character's record of this slot: a different record, not replaced by the one below.
+        const JournaledSwap old = *live;
+        live.reset();
+        --m_liveCount;
+        Append(RecordKind::CLEAR, old);
+    }
+    if (EraseKept(swap))
+        --m_liveCount; // replaced by this record
+    if (!live)
+        ++m_liveCount;
+    live = swap;
+    Append(RecordKind::SET, swap);
+}
+
+void SwapJournal::Clear(const int playerIndex, const EquipSlot slot, const SwapJournalLayer layer)
+{
+    std::optional<JournaledSwap>& live = m_live[playerIndex][static_cast<int>(slot)][static_cast<int>(layer)];
+    if (!live)
+        return;
+    const JournaledSwap swap = *live;
+    live.reset();
+    --m_liveCount;
+    Append(RecordKind::CLEAR, swap);
+}
+
+void SwapJournal::Release(const JournaledSwap& swap)
+{
+    if (!EraseKept(swap))
+        return;
+    --m_liveCount;
+    Append(RecordKind::CLEAR, swap);
+}
+
+bool SwapJournal::EraseKept(const JournaledSwap& swap)
+{
+    const auto it =
+        std::ranges::find_if(m_kept, [&swap](const JournaledSwap& kept) { return IsSameRecord(kept, swap); });
+    if (it == m_kept.end())
+        return false;
+    m_kept.erase(it);
+    return true;
+}
+
+bool SwapJournal::Map(const std::filesystem::path& path)
+{
+    void* view = nullptr;
+#ifdef _WIN32
+    // No write sharing: a second swapper must not interleave records with ours.
+    const HANDLE file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    // Grows the file to `FILE_SIZE` (zero-filled) if it is smaller.
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, 0, FILE_SIZE, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    view = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, FILE_SIZE);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+#else
+    const int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        return false;
+    struct stat info = {};
+    if (fstat(fd, &info) != 0
+        || (info.st_size != static_cast<off_t>(FILE_SIZE) && ftruncate(fd, FILE_SIZE) != 0))
+    {
+        close(fd);
+        return false;
+    }
+    view = mmap(nullptr, FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+        return false;
+#endif
+    m_view = static_cast<std::byte*>(view);
+    return true;
+}
+
+bool SwapJournal::Replay()
+{
+    // Next epoch must be above every epoch in the file, including stale records past a region's valid prefix.
+    for (int region = 0; region < 2; ++region)
+    {
+        for (std::uint32_t index = 0; index < REGION_CAPACITY; ++index)
+        {
+            const SwapJournalRecord* record = GetRecord(region, index);
+            if (record->checksum == ComputeChecksum(*record))
+                m_epoch = std::max(m_epoch, record->epoch);
+        }
+    }
+
+    std::optional<int> newestRegion;
+    std::uint32_t newestLength = 0;
+    for (int region = 0; region < 2; ++region)
+    {
+        std::optional<std::uint32_t> checkpointIndex;
+        const std::uint32_t length = ScanRegion(region, checkpointIndex);
+        if (!checkpointIndex)
+            continue; // empty, or its compaction never finished
+        if (!newestRegion || GetRecord(region, 0)->epoch > GetRecord(*newestRegion, 0)->epoch)
+        {
+            newestRegion = region;
+            newestLength = length;
+        }
+    }
+    if (!newestRegion)
+        return false;
+
+    for (std::uint32_t index = 0; index < newestLength; ++index)
+    {
+        const SwapJournalRecord* record = GetRecord(*newestRegion, index);
+        if (record->playerIndex >= DSR_MAX_PLAYERS || record->slot >= EQUIP_SLOT_COUNT
+            || record->layer >= SWAP_JOURNAL_LAYER_COUNT)
+            continue; // checksum matched, but not written by this layout
+
+        const JournaledSwap swap{
+            record->playerIndex,
+            static_cast<EquipSlot>(record->slot),
+            static_cast<SwapJournalLayer>(record->layer),
+            record->sourceParamID,
+            record->destParamID,
+            record->characterID};
+        switch (static_cast<RecordKind>(record->kind))
+        {
+            case RecordKind::SET:
+                EraseKept(swap);
+                m_kept.push_back(swap); // newest last
+                break;
+            case RecordKind::CLEAR:
+                EraseKept(swap);
+                break;
+            case RecordKind::CHECKPOINT:
+                break;
+        }
+    }
+    m_region = *newestRegion;
+    m_next = newestLength;
+    return true;
+}
+
+SwapJournalRecord* SwapJournal::GetRecord(const int region, const std::uint32_t index) const
+{
+    std::byte* records = m_view + sizeof(Header);
+    return reinterpret_cast<SwapJournalRecord*>(records)
+           + static_cast<std::size_t>(region) * REGION_CAPACITY + index;
+}
+
+std::uint32_t SwapJournal::ScanRegion(const int region, std::optional<std::uint32_t>& checkpointIndex) const
+{
+    checkpointIndex.reset();
+    const SwapJournalRecord* first = GetRecord(region, 0);
+    if (first->checksum != ComputeChecksum(*first))
+        return 0;
+
+    std::uint32_t length = 0;
+    for (; length < REGION_CAPACITY; ++length)
+    {
+        const SwapJournalRecord* record = GetRecord(region, length);
+        if (record->checksum != ComputeChecksum(*record) || record->epoch != first->epoch)
+            break; // end of this epoch's records (the rest is torn or older)
+        if (!checkpointIndex && record->kind == static_cast<std::uint8_t>(RecordKind::CHECKPOINT))
+            checkpointIndex = length;
+    }
+    return length;
+}
+
+void SwapJournal::Append(const RecordKind kind, const JournaledSwap& swap)
+{
+    if (m_next >= REGION_CAPACITY)
+    {
+        Compact();
+        return;
+    }
+
+    WriteRecord(m_region, m_next++, m_epoch, kind, swap);
+}
+
+void SwapJournal::Compact()
+{
+    const int region = 1 - m_region;
+    const std::uint32_t epoch = m_epoch + 1;
+
+    // The active region stays valid until the checkpoint below is written. Kept records first, so they stay oldest.
+    std::uint32_t index = 0;
+    for (const JournaledSwap& swap : m_kept)
+        WriteRecord(region, index++, epoch, RecordKind::SET, swap);
+    for (const auto& slots : m_live)
+    {
+        for (const auto& layers : slots)
+        {
+            for (const std::optional<JournaledSwap>& swap : layers)
+            {
+                if (swap)
+                    WriteRecord(region, index++, epoch, RecordKind::SET, *swap);
+            }
+        }
+    }
+    WriteRecord(region, index++, epoch, RecordKind::CHECKPOINT, JournaledSwap{});
+
+    m_region = region;
+    m_epoch = epoch;
+    m_next = index;
+    ++m_compactionCount;
+}
+
+void SwapJournal::WriteRecord(
+    const int region,
+    const std::uint32_t index,
+    const std::uint32_t epoch,
+    const RecordKind kind,
+    const JournaledSwap& swap)
+{
+    // Built in full (checksum last) before it is copied in, so a torn copy fails the checksum.
+    SwapJournalRecord record = {};
+    record.epoch = epoch;
+    record.kind = static_cast<std::uint8_t>(kind);
+    record.playerIndex = static_cast<std::uint8_t>(swap.playerIndex);
+    record.slot = static_cast<std::uint8_t>(swap.slot);
+    record.layer = static_cast<std::uint8_t>(swap.layer);
+    record.sourceParamID = swap.sourceParamID;
+    record.destParamID = swap.destParamID;
+    record.characterID = swap.characterID;
+    record.checksum = ComputeChecksum(record);
+    std::memcpy(GetRecord(region, index), &record, sizeof(SwapJournalRecord));
+}
+
+std::uint32_t SwapJournal::ComputeChecksum(const SwapJournalRecord& record)
+{
+    // FNV-1a over every byte after the checksum. An all-zero record (never written) does not match.
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&record);
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = sizeof(record.checksum); i < sizeof(SwapJournalRecord); ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
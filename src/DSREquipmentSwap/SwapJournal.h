@@ -0,0 +1,193 @@
+#pragma once
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/Slots.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Which temporary record of a slot a journal entry mirrors. A slot can have both: a per-slot swap made on
+    /// top of a temporary loadout. Swaps are reverted before loadouts.
+    enum class SwapJournalLayer : std::uint8_t
+    {
+        SWAP = 0,    // `TempSwap`
+        LOADOUT = 1, // one slot of a `TempLoadout`
+    };
+
+    constexpr int SWAP_JOURNAL_LAYER_COUNT = 2;
+
+    /// @brief A temporary swap that is (or was, at the last run) applied in the game and not yet reverted.
+    struct JournaledSwap
+    {
+        int playerIndex;
+        EquipSlot slot;
+        SwapJournalLayer layer;
+        int sourceParamID;         // pre-swap ID, written back by a revert
+        int destParamID;           // ID the swap wrote
+        std::uint64_t characterID; // identity of the character it was applied to (see `GetCharacterID()`)
+
+        bool operator==(const JournaledSwap&) const = default;
+    };
+
+    constexpr std::uint32_t SWAP_JOURNAL_MAGIC = 0x4A534544; // "DESJ"
+    constexpr std::uint32_t SWAP_JOURNAL_VERSION = 2; // 2: character IDs are name hashes
+
+    /// @brief One fixed-size journal record. `checksum` covers every other byte, so a record torn by a crash mid-write
+    /// is simply not there.
+    struct SwapJournalRecord
+    {
+        std::uint32_t checksum;
+        std::uint32_t epoch; // every record of a region's valid prefix has the epoch of that region
+        std::uint8_t kind;   // `SwapJournal::RecordKind`
+        std::uint8_t playerIndex;
+        std::uint8_t slot;
+        std::uint8_t layer;
+        std::int32_t sourceParamID;
+        std::int32_t destParamID;
+        std::uint32_t reserved;
+        std::uint64_t characterID;
+    };
+
+    static_assert(sizeof(SwapJournalRecord) == 32, "Swap journal records are part of the file layout.");
+
+    /// @brief Crash-safe, append-only journal of the temporary swaps currently applied in the game, in a memory-mapped
+    /// file.
+    ///
+    /// @details Temporary swaps only exist in the swapper's memory, so if the game saves while one is applied and then
+    /// crashes (or is closed), the swapped ID stays in the save. Every change to a temporary record is appended to the
+    /// journal as one checksummed record, written straight into the mapping. There is no flush on this path: the OS
+    /// writes the mapped pages back even if the process dies (an OS crash or power loss can still lose the tail). On
+    /// the next start, `Open()` replays the journal, and `GetRecovered()` lists the swaps that were never reverted.
+    ///
+    /// The file holds two regions. Records are appended to the active region; when it is full, the live set is
+    /// rewritten at the start of the other region under the next epoch, followed by a checkpoint record, and appends
+    /// continue there. Replay uses the region with the highest epoch whose checkpoint was written, so a crash during
+    /// compaction falls back to the previous region, which is left untouched until the compaction after next.
+    ///
+    /// A record is identified by its player, slot, layer and character. Swaps recovered from the last run stay in the
+    /// journal, carried over by every compaction, until they are released: the swaps of a character that is not
+    /// loaded in this run are kept for a later run that loads it. Up to `MAX_KEPT_SWAPS` are kept, oldest dropped
+    /// first.
+    class SwapJournal
+    {
+    public:
+        ~SwapJournal();
+
+        SwapJournal(const SwapJournal&) = delete;
+        SwapJournal& operator=(const SwapJournal&) = delete;
+
+        /// @brief Open (or create) the journal file at `path` and replay it. A file with another layout or no valid
+        /// checkpoint is started over (nothing to recover). Returns nullptr if the file cannot be mapped.
+        static std::unique_ptr<SwapJournal> Open(const std::filesystem::path& path);
+
+        /// @brief Swaps that were still applied when the journal was last written, oldest first, swaps before
+        /// loadouts. They stay in the journal until they are released (or set again by this run).
+        [[nodiscard]] const std::vector<JournaledSwap>& GetRecovered() const { return m_recovered; }
+
+        /// @brief Record that `swap` is now this run's temporary record of its player, slot and layer. No-op if it
+        /// already is.
+        void Set(const JournaledSwap& swap);
+
+        /// @brief Record that a player's slot has no temporary record of this run in `layer` anymore. No-op if it had
+        /// none.
+        void Clear(int playerIndex, EquipSlot slot, SwapJournalLayer layer);
+
+        /// @brief Remove the recovered swap `swap` (from `GetRecovered()`) from the journal, once it is reverted or not
+        /// worth keeping. No-op if it is not in the journal anymore.
+        void Release(const JournaledSwap& swap);
+
+        /// @brief Number of temporary records currently in the journal (recovered ones included).
+        [[nodiscard]] std::size_t GetLiveCount() const { return m_liveCount; }
+
+        /// @brief Number of recovered swaps dropped by `Open()` to stay within `MAX_KEPT_SWAPS`.
+        [[nodiscard]] std::size_t GetDroppedCount() const { return m_droppedCount; }
+
+        /// @brief Number of times the journal has moved to its other region.
+        [[nodiscard]] std::uint64_t GetCompactionCount() const { return m_compactionCount; }
+
+        /// @brief Records per region.
+        static constexpr std::uint32_t REGION_CAPACITY = 512;
+
+        /// @brief Recovered swaps kept: every slot and layer of 10 characters (the game's save slots).
+        static constexpr std::size_t MAX_KEPT_SWAPS = 10 * EQUIP_SLOT_COUNT * SWAP_JOURNAL_LAYER_COUNT;
+
+    private:
+        enum class RecordKind : std::uint8_t
+        {
+            SET = 1,
+            CLEAR = 2,
+            CHECKPOINT = 3, // ends the snapshot of live records at the start of a region
+        };
+
+        /// @brief File header. Written once, when the file is created or started over.
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t recordSize;
+            std::uint32_t regionCapacity;
+            std::uint8_t reserved[16];
+        };
+
+        static constexpr std::size_t FILE_SIZE = sizeof(Header) + 2 * REGION_CAPACITY * sizeof(SwapJournalRecord);
+
+        static_assert(
+            DSR_MAX_PLAYERS * EQUIP_SLOT_COUNT * SWAP_JOURNAL_LAYER_COUNT + MAX_KEPT_SWAPS < REGION_CAPACITY,
+            "A compacted region must fit the largest live set and its checkpoint.");
+
+        SwapJournal() = default;
+
+        std::byte* m_view = nullptr;
+        void* m_fileHandle = nullptr;    // Windows file handle
+        void* m_mappingHandle = nullptr; // Windows file mapping handle
+        std::array<std::array<std::array<std::optional<JournaledSwap>, SWAP_JOURNAL_LAYER_COUNT>, EQUIP_SLOT_COUNT>,
+                   DSR_MAX_PLAYERS>
+            m_live = {};                       // this run's records
+        std::vector<JournaledSwap> m_kept; // recovered records not released yet, oldest first
+        std::size_t m_liveCount = 0;
+        std::size_t m_droppedCount = 0;
+        std::vector<JournaledSwap> m_recovered;
+        int m_region = 0;          // active region
+        std::uint32_t m_epoch = 0; // epoch of the active region
+        std::uint32_t m_next = 0;  // next free record in the active region
+        std::uint64_t m_compactionCount = 0;
+
+        /// @brief Map `FILE_SIZE` bytes of the file at `path`, creating or resizing it as needed.
+        bool Map(const std::filesystem::path& path);
+
+        /// @brief Rebuild `m_kept` from the newest committed region. Returns false if there is none.
+        bool Replay();
+
+        /// @brief Remove the record of `swap`'s player, slot, layer and character from `m_kept`. Returns false if
+        /// there was none.
+        bool EraseKept(const JournaledSwap& swap);
+
+        /// @brief Get record `index` of `region` in the mapping.
+        [[nodiscard]] SwapJournalRecord* GetRecord(int region, std::uint32_t index) const;
+
+        /// @brief Length of the valid prefix of `region` (records with a good checksum and the epoch of its first
+        /// record) and, if it contains one, the index of its first checkpoint.
+        std::uint32_t ScanRegion(int region, std::optional<std::uint32_t>& checkpointIndex) const;
+
+        /// @brief Append a record of a change already made to `m_live` or `m_kept`. If the active region is full,
+        /// compact instead (the compacted live set includes the change).
+        void Append(RecordKind kind, const JournaledSwap& swap);
+
+        /// @brief Write the live set and a checkpoint at the start of the other region, under the next epoch, and make
+        /// it the active region.
+        void Compact();
+
+        /// @brief Write a checksummed record of `swap` to slot `index` of `region`.
+        void WriteRecord(
+            int region, std::uint32_t index, std::uint32_t epoch, RecordKind kind, const JournaledSwap& swap);
+
+        [[nodiscard]] static std::uint32_t ComputeChecksum(const SwapJournalRecord& record);
+    };
+} // namespace DSREquipmentSwap
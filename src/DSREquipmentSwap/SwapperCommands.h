@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Runtime commands that can be posted to a running `EquipmentSwapper` from any thread.
+    enum class SwapperCommandType : std::uint8_t
+    {
+        FORCE_REVERT_TEMP_SWAPS, // revert all temporary swaps of connected players
+        PAUSE,                   // stop evaluating triggers (game load tracking continues)
+        RESUME,
+        SET_MONITOR_INTERVAL,    // `value` = new monitor interval in ms (1 or greater)
+        DUMP_METRICS,            // log current `SwapperMetrics`
+        ENABLE_TRIGGER_GROUP,    // `value` = trigger group (0 to MAX_TRIGGER_GROUPS - 1)
+        DISABLE_TRIGGER_GROUP,   // `value` = trigger group (0 to MAX_TRIGGER_GROUPS - 1)
+    };
+
+    /// @brief A single runtime command with its (optional) argument.
+    struct SwapperCommand
+    {
+        SwapperCommandType type = SwapperCommandType::DUMP_METRICS;
+        int value = 0;
+    };
+
+    /// @brief Get the display name of a command type, for logging.
+    inline std::string SwapperCommandTypeToString(const SwapperCommandType type)
+    {
+        switch (type)
+        {
+            case SwapperCommandType::FORCE_REVERT_TEMP_SWAPS:
+                return "ForceRevertTempSwaps";
+            case SwapperCommandType::PAUSE:
+                return "Pause";
+            case SwapperCommandType::RESUME:
+                return "Resume";
+            case SwapperCommandType::SET_MONITOR_INTERVAL:
+                return "SetMonitorInterval";
+            case SwapperCommandType::DUMP_METRICS:
+                return "DumpMetrics";
+            case SwapperCommandType::ENABLE_TRIGGER_GROUP:
+                return "EnableTriggerGroup";
+            case SwapperCommandType::DISABLE_TRIGGER_GROUP:
+                return "DisableTriggerGroup";
+        }
+        return "Unknown";
+    }
+} // namespace DSREquipmentSwap
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <format>
+#include <string>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Running counters kept by the swapper. Only written while holding the update lock (by the swapper thread,
+    /// or by the game thread in frame-hook mode).
+    struct SwapperMetrics
+    {
+        std::uint64_t ticks = 0;                   // trigger updates (loop iterations or game frames)
+        std::uint64_t pausedTicks = 0;             // iterations with trigger evaluation skipped while paused
+        std::uint64_t swapsApplied = 0;            // successful trigger swaps (all slots)
+        std::uint64_t loadoutsApplied = 0;         // successful loadout swaps (each one a batch of slots)
+        std::uint64_t tempSwapForceReverts = 0;    // force-revert passes (game reload or command)
+        std::uint64_t commandsProcessed = 0;
+        std::uint64_t commandsRejected = 0;        // commands with invalid arguments
+        std::uint64_t spEffectEventsDropped = 0;
+        std::uint64_t directReads = 0;             // direct backend reads (merged regions, SpEffect list windows)
+        std::uint64_t spEffectNodesRead = 0;       // SpEffect list nodes walked by `SpEffectListReader`
+        std::uint64_t spEffectListTruncations = 0; // lists cut short by `maxNodesPerUpdate`
+        std::uint64_t journaledSwapsReverted = 0;  // swaps left by the last run, reverted from the swap journal
+        std::uint64_t frameUpdates = 0;            // trigger updates run on the game's frame tick
+        std::uint64_t frameBudgetOverruns = 0;     // frame updates that took longer than `frameBudgetUs`
+        std::uint64_t frameFallbacks = 0;          // times frame updates were handed back to the swapper thread
+        std::uint64_t framesSkipped = 0;           // frames that found the swapper thread busy (e.g. game loading)
+        std::uint64_t maxFrameUpdateUs = 0;        // slowest frame update
+        std::uint64_t slotWritePreRaces = 0;       // writes aborted: the game changed the slot since we read it
+        std::uint64_t slotWritePostRaces = 0;      // writes the game changed or kept undoing right after we made them
+        std::uint64_t slotWriteRetries = 0;        // writes repeated because the game put the old ID back
+
+        [[nodiscard]] std::string ToString() const
+        {
+            return std::format(
+                "ticks={} pausedTicks={} swapsApplied={} loadoutsApplied={} tempSwapForceReverts={} "
+                "commandsProcessed={} commandsRejected={} spEffectEventsDropped={} directReads={} spEffectNodesRead={} "
+                "spEffectListTruncations={} journaledSwapsReverted={} frameUpdates={} frameBudgetOverruns={} "
+                "frameFallbacks={} framesSkipped={} maxFrameUpdateUs={} slotWritePreRaces={} slotWritePostRaces={} "
+                "slotWriteRetries={}",
+                ticks,
+                pausedTicks,
+                swapsApplied,
+                loadoutsApplied,
+                tempSwapForceReverts,
+                commandsProcessed,
+                commandsRejected,
+                spEffectEventsDropped,
+                directReads,
+                spEffectNodesRead,
+                spEffectListTruncations,
+                journaledSwapsReverted,
+                frameUpdates,
+                frameBudgetOverruns,
+                frameFallbacks,
+                framesSkipped,
+                maxFrameUpdateUs,
+                slotWritePreRaces,
+                slotWritePostRaces,
+                slotWriteRetries);
+        }
+    };
+} // namespace DSREquipmentSwap
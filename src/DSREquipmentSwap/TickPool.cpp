@@ -0,0 +1,115 @@
+#include "TickPool.h"
+
+#include <algorithm>
+
+using namespace DSREquipmentSwap;
+
+TickPool::TickPool(const int workerCount)
+{
+    const int count = std::max(workerCount, 1);
+    m_workers.reserve(static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i)
+        m_workers.emplace_back([this] { WorkerMain(); });
+}
+
+TickPool::~TickPool()
+{
+    Stop();
+}
+
+void TickPool::Add(TickFunction tick)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_isStopping)
+        return;
+    PushLocked(Entry{Clock::now(), m_nextOrder++, std::move(tick)});
+}
+
+void TickPool::Stop()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_isStopping = true;
+        m_heap.clear();
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+std::size_t TickPool::GetEntryCount() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_heap.size() + m_runningCount;
+}
+
+TickPoolStats TickPool::GetStats() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+void TickPool::WorkerMain()
+{
+    std::unique_lock lock(m_mutex);
+    while (!m_isStopping)
+    {
+        if (m_heap.empty())
+        {
+            m_wake.wait(lock);
+            continue;
+        }
+
+        const Clock::time_point due = m_heap.front().due;
+        const Clock::time_point now = Clock::now();
+        if (now < due)
+        {
+            if (due >= m_timedWaitUntil)
+            {
+                m_wake.wait(lock); // another worker wakes up for it
+                continue;
+            }
+            m_timedWaitUntil = due;
+            m_wake.wait_until(lock, due);
+            if (m_timedWaitUntil == due)
+                m_timedWaitUntil = Clock::time_point::max();
+            continue;
+        }
+
+        std::ranges::pop_heap(m_heap, IsLater);
+        Entry entry = std::move(m_heap.back());
+        m_heap.pop_back();
+        ++m_runningCount;
+        const auto latenessUs =
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - due).count());
+        m_stats.totalLatenessUs += latenessUs;
+        m_stats.maxLatenessUs = std::max(m_stats.maxLatenessUs, latenessUs);
+        ++m_stats.ticks;
+        if (!m_heap.empty())
+            m_wake.notify_one(); // someone has to wait for the next entry while this one runs
+
+        lock.unlock();
+        const std::optional<std::chrono::milliseconds> delay = entry.tick();
+        lock.lock();
+
+        --m_runningCount;
+        if (!delay)
+            ++m_stats.dropped;
+        else if (!m_isStopping)
+        {
+            entry.due = Clock::now() + *delay;
+            entry.order = m_nextOrder++;
+            PushLocked(std::move(entry));
+        }
+    }
+}
+
+void TickPool::PushLocked(Entry entry)
+{
+    m_heap.push_back(std::move(entry));
+    std::ranges::push_heap(m_heap, IsLater);
+    m_wake.notify_one();
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Counters kept by a `TickPool`.
+    struct TickPoolStats
+    {
+        std::uint64_t ticks = 0;            // tick functions run
+        std::uint64_t dropped = 0;          // entries dropped because their tick function returned nullopt
+        std::uint64_t totalLatenessUs = 0;  // summed delay between each tick's due time and its start
+        std::uint64_t maxLatenessUs = 0;    // longest such delay
+    };
+
+    /// @brief Runs the updates of many independent instances (e.g. one swapper per game process) on a fixed set of
+    /// worker threads, each instance on its own schedule.
+    ///
+    /// @details Each entry is a tick function that returns how long to wait before it runs again. Entries are kept in
+    /// a min-heap by due time; a free worker takes the earliest due entry, runs it without holding the pool lock, and
+    /// puts it back due that long after the tick ended, like a dedicated thread that sleeps between updates. An entry
+    /// is only ever held by one worker, so ticks of the same entry never overlap. Knows nothing about the swapper, so
+    /// it can be driven by plain functions (e.g. in a benchmark).
+    class TickPool
+    {
+    public:
+        /// @brief One update of an instance. Returns the delay until its next update, or nullopt to drop the entry.
+        using TickFunction = std::function<std::optional<std::chrono::milliseconds>()>;
+
+        /// @brief Start `workerCount` worker threads (at least one).
+        explicit TickPool(int workerCount);
+
+        TickPool(const TickPool&) = delete;
+        TickPool& operator=(const TickPool&) = delete;
+
+        /// @brief Stops the workers.
+        ~TickPool();
+
+        /// @brief Add an entry whose first tick is due now. Safe to call from any thread, including a tick.
+        void Add(TickFunction tick);
+
+        /// @brief Stop all workers, letting ticks in progress finish, and drop all entries. Safe to call more than once,
+        /// but not from a tick function.
+        void Stop();
+
+        [[nodiscard]] int GetWorkerCount() const { return static_cast<int>(m_workers.size()); }
+
+        /// @brief Number of entries scheduled or running.
+        [[nodiscard]] std::size_t GetEntryCount() const;
+
+        [[nodiscard]] TickPoolStats GetStats() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Entry
+        {
+            Clock::time_point due;
+            std::uint64_t order; // breaks ties between entries due at the same time (first added first)
+            TickFunction tick;
+        };
+
+        /// @brief Heap order: the earliest due entry is at the front.
+        static bool IsLater(const Entry& a, const Entry& b)
+        {
+            return a.due != b.due ? a.due > b.due : a.order > b.order;
+        }
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake; // new entry, entry put back, or stop
+        std::vector<Entry> m_heap;      // guarded by `m_mutex`
+        std::uint64_t m_nextOrder = 0;
+        std::size_t m_runningCount = 0; // entries currently held by a worker
+        // Due time that a worker is already waiting for (`max()` if none). Only one worker waits for each due time;
+        // the others wait for a notification, so a due entry does not wake every idle worker.
+        Clock::time_point m_timedWaitUntil = Clock::time_point::max();
+        bool m_isStopping = false;
+        TickPoolStats m_stats;
+        std::vector<std::thread> m_workers;
+
+        /// @brief Body of each worker thread.
+        void WorkerMain();
+
+        /// @brief Push `entry` onto the heap and wake a worker to reconsider the earliest due time. Requires the lock.
+        void PushLocked(Entry entry);
+    };
+} // namespace DSREquipmentSwap
@@ -0,0 +1,194 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+using namespace DSREquipmentSwap;
+
+std::uint64_t SteadyTimerClock::NowMs() const
+{
+    const auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch).count());
+}
+
+const SteadyTimerClock& SteadyTimerClock::Get()
+{
+    static const SteadyTimerClock clock;
+    return clock;
+}
+
+TimerWheel::TimerWheel(const std::size_t keyCount, const TimerClock& clock)
+    : m_clock(&clock)
+    , m_nowMs(clock.NowMs())
+    , m_nodes(keyCount)
+{
+    m_heads.fill(NIL);
+}
+
+void TimerWheel::Schedule(const std::uint32_t key, const std::uint64_t delayMs)
+{
+    Node& node = m_nodes[key];
+    if (node.isScheduled)
+        Unlink(key);
+    else
+        ++m_count;
+
+    // Due no earlier than the next millisecond the wheel will visit.
+    node.expiryMs = std::max(m_clock->NowMs() + delayMs, m_nowMs + 1);
+    node.isScheduled = true;
+    Insert(key);
+}
+
+void TimerWheel::Cancel(const std::uint32_t key)
+{
+    Node& node = m_nodes[key];
+    if (!node.isScheduled)
+        return;
+    Unlink(key);
+    node.isScheduled = false;
+    --m_count;
+}
+
+void TimerWheel::CancelAll()
+{
+    for (Node& node : m_nodes)
+        node = Node{};
+    m_heads.fill(NIL);
+    m_occupied = {};
+    m_count = 0;
+}
+
+std::uint64_t TimerWheel::GetRemainingMs(const std::uint32_t key) const
+{
+    const Node& node = m_nodes[key];
+    if (!node.isScheduled)
+        return 0;
+    const std::uint64_t nowMs = m_clock->NowMs();
+    return node.expiryMs > nowMs ? node.expiryMs - nowMs : 0;
+}
+
+void TimerWheel::Advance(std::vector<std::uint32_t>& expired)
+{
+    expired.clear();
+    const std::uint64_t targetMs = m_clock->NowMs();
+
+    while (m_nowMs < targetMs)
+    {
+        if (m_count == 0)
+        {
+            m_nowMs = targetMs;
+            break;
+        }
+
+        // Next millisecond with work: the earliest next occupied slot over all levels. A higher-level slot is due
+        // when all lower digits are zero, which is when it cascades.
+        std::uint64_t nextMs = std::numeric_limits<std::uint64_t>::max();
+        for (int level = 0; level < LEVEL_COUNT; ++level)
+        {
+            if (m_occupied[level] == 0)
+                continue;
+            const int shift = LEVEL_BITS * level;
+            const std::uint64_t digits = m_nowMs >> shift;
+            const auto current = static_cast<int>(digits & SLOT_MASK);
+            const int steps = std::countr_zero(std::rotr(m_occupied[level], current + 1)) + 1; // slots ahead (1-64)
+            nextMs = std::min(nextMs, (digits + steps) << shift);
+        }
+        if (nextMs > targetMs)
+        {
+            m_nowMs = targetMs;
+            break;
+        }
+        m_nowMs = nextMs;
+
+        if ((m_nowMs & SLOT_MASK) == 0)
+        {
+            // Level 0 wrapped. Move down the due slot of each level whose lower digits all just wrapped.
+            for (int level = 1; level < LEVEL_COUNT; ++level)
+            {
+                const auto slot = static_cast<std::uint32_t>(m_nowMs >> (LEVEL_BITS * level)) & SLOT_MASK;
+                Cascade(level, slot, expired);
+                if (slot != 0)
+                    break;
+            }
+        }
+
+        const std::uint32_t slot = m_nowMs & SLOT_MASK;
+        if (m_occupied[0] & (1ull << slot))
+            ExpireSlot(slot, expired);
+    }
+}
+
+void TimerWheel::Insert(const std::uint32_t key)
+{
+    Node& node = m_nodes[key];
+
+    // The level is the first one whose range covers the delay. Beyond the top level, park at its furthest slot.
+    const std::uint64_t delayMs = node.expiryMs - m_nowMs;
+    const std::uint64_t fileMs = delayMs > MAX_DELAY_MS ? m_nowMs + MAX_DELAY_MS : node.expiryMs;
+    int level = 0;
+    while (level < LEVEL_COUNT - 1 && delayMs >= (1ull << (LEVEL_BITS * (level + 1))))
+        ++level;
+    const auto slot = static_cast<std::uint32_t>(fileMs >> (LEVEL_BITS * level)) & SLOT_MASK;
+
+    node.bucket = static_cast<std::uint16_t>(level * SLOT_COUNT + slot);
+    node.prev = NIL;
+    node.next = m_heads[node.bucket];
+    if (node.next != NIL)
+        m_nodes[node.next].prev = key;
+    m_heads[node.bucket] = key;
+    m_occupied[level] |= 1ull << slot;
+}
+
+void TimerWheel::Unlink(const std::uint32_t key)
+{
+    const Node& node = m_nodes[key];
+    if (node.prev != NIL)
+        m_nodes[node.prev].next = node.next;
+    else
+        m_heads[node.bucket] = node.next;
+    if (node.next != NIL)
+        m_nodes[node.next].prev = node.prev;
+
+    if (m_heads[node.bucket] == NIL)
+        m_occupied[node.bucket / SLOT_COUNT] &= ~(1ull << (node.bucket % SLOT_COUNT));
+}
+
+void TimerWheel::Cascade(const int level, const std::uint32_t slot, std::vector<std::uint32_t>& expired)
+{
+    const std::size_t bucket = level * SLOT_COUNT + slot;
+    std::uint32_t key = m_heads[bucket];
+    m_heads[bucket] = NIL;
+    m_occupied[level] &= ~(1ull << slot);
+
+    while (key != NIL)
+    {
+        Node& node = m_nodes[key];
+        const std::uint32_t next = node.next;
+        if (node.expiryMs <= m_nowMs)
+        {
+            node.isScheduled = false;
+            --m_count;
+            expired.push_back(key);
+        }
+        else
+            Insert(key);
+        key = next;
+    }
+}
+
+void TimerWheel::ExpireSlot(const std::uint32_t slot, std::vector<std::uint32_t>& expired)
+{
+    std::uint32_t key = m_heads[slot];
+    m_heads[slot] = NIL;
+    m_occupied[0] &= ~(1ull << slot);
+
+    while (key != NIL)
+    {
+        Node& node = m_nodes[key];
+        node.isScheduled = false;
+        --m_count;
+        expired.push_back(key);
+        key = node.next;
+    }
+}
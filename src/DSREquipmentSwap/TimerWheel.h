@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Source of the current time for `TimerWheel`, in milliseconds. Injectable, so timers can be stepped
+    /// deterministically (e.g. by a test) instead of following the real clock.
+    class TimerClock
+    {
+    public:
+        virtual ~TimerClock() = default;
+
+        /// @brief Get the current time in milliseconds. Must never go backwards.
+        [[nodiscard]] virtual std::uint64_t NowMs() const = 0;
+    };
+
+    /// @brief `std::chrono::steady_clock`, the clock used outside of tests.
+    class SteadyTimerClock final : public TimerClock
+    {
+    public:
+        [[nodiscard]] std::uint64_t NowMs() const override;
+
+        /// @brief Get the shared instance (the clock has no state).
+        [[nodiscard]] static const SteadyTimerClock& Get();
+    };
+
+    /// @brief Clock that only moves when told to.
+    class ManualTimerClock final : public TimerClock
+    {
+    public:
+        [[nodiscard]] std::uint64_t NowMs() const override { return m_nowMs; }
+
+        void AdvanceMs(const std::uint64_t ms) { m_nowMs += ms; }
+
+    private:
+        std::uint64_t m_nowMs = 0;
+    };
+
+    /// @brief Hierarchical timer wheel with millisecond resolution over a fixed set of timer keys `[0, keyCount)`.
+    ///
+    /// @details Four levels of 64 slots each. Level N holds timers due within 64^(N + 1) ms, in the slot of their
+    /// expiry time's Nth 6-bit digit, so `Schedule()` and `Cancel()` are O(1) list operations on the timer's key. When
+    /// level 0 wraps around, the due slot of the next level is moved down ("cascaded"), so each timer is touched at
+    /// most once per level. `Advance()` jumps straight to the next occupied slot (using a bitmap per level), so idle
+    /// time costs nothing. Timers further out than the top level (about 4.6 hours) are parked in its last slot and
+    /// re-filed when it comes around.
+    ///
+    /// A timer is identified by its key alone: scheduling a running timer restarts it. Keys are dense (e.g. a rule
+    /// index times the player count plus a player index), so the wheel stores its nodes in a flat array.
+    class TimerWheel
+    {
+    public:
+        /// @brief Wheel for keys `[0, keyCount)`, starting at `clock`'s current time. `clock` must outlive the wheel.
+        explicit TimerWheel(std::size_t keyCount = 0, const TimerClock& clock = SteadyTimerClock::Get());
+
+        /// @brief Start (or restart) timer `key` so that it expires `delayMs` from the clock's current time (and no
+        /// earlier than the next millisecond `Advance()` visits).
+        void Schedule(std::uint32_t key, std::uint64_t delayMs);
+
+        /// @brief Stop timer `key`, if it is running.
+        void Cancel(std::uint32_t key);
+
+        /// @brief Stop all timers.
+        void CancelAll();
+
+        /// @brief True if timer `key` is running (scheduled and not yet expired by `Advance()`).
+        [[nodiscard]] bool IsScheduled(const std::uint32_t key) const { return m_nodes[key].isScheduled; }
+
+        /// @brief Get the time left until timer `key` expires, in milliseconds (0 if it is not running).
+        [[nodiscard]] std::uint64_t GetRemainingMs(std::uint32_t key) const;
+
+        /// @brief Number of running timers.
+        [[nodiscard]] std::size_t GetCount() const { return m_count; }
+
+        /// @brief Get the heap memory held by the timer nodes, in bytes.
+        [[nodiscard]] std::size_t GetMemoryBytes() const { return m_nodes.capacity() * sizeof(Node); }
+
+        /// @brief Move the wheel to the clock's current time. Every timer that expires on the way is stopped and its
+        /// key is appended to `expired` (cleared first), in expiry order.
+        void Advance(std::vector<std::uint32_t>& expired);
+
+    private:
+        static constexpr int LEVEL_BITS = 6;
+        static constexpr int LEVEL_COUNT = 4;
+        static constexpr std::uint32_t SLOT_COUNT = 1u << LEVEL_BITS;
+        static constexpr std::uint32_t SLOT_MASK = SLOT_COUNT - 1;
+        static constexpr std::uint64_t MAX_DELAY_MS = (1ull << (LEVEL_BITS * LEVEL_COUNT)) - 1;
+        static constexpr std::uint32_t NIL = std::numeric_limits<std::uint32_t>::max();
+
+        struct Node
+        {
+            std::uint64_t expiryMs = 0;
+            std::uint32_t prev = NIL;
+            std::uint32_t next = NIL;
+            std::uint16_t bucket = 0; // level * SLOT_COUNT + slot
+            bool isScheduled = false;
+        };
+
+        const TimerClock* m_clock;
+        std::uint64_t m_nowMs; // time the wheel has been advanced to
+        std::vector<Node> m_nodes;
+        std::array<std::uint32_t, LEVEL_COUNT * SLOT_COUNT> m_heads;
+        std::array<std::uint64_t, LEVEL_COUNT> m_occupied = {}; // bit N == slot N of the level has timers
+        std::size_t m_count = 0;
+
+        /// @brief File (scheduled) node `key` into the slot for its expiry, relative to `m_nowMs`.
+        void Insert(std::uint32_t key);
+
+        /// @brief Remove node `key` from its slot list (does not change `isScheduled`).
+        void Unlink(std::uint32_t key);
+
+        /// @brief Re-file every timer in slot `slot` of `level` relative to `m_nowMs`. Timers that are due go to
+        /// `expired`.
+        void Cascade(int level, std::uint32_t slot, std::vector<std::uint32_t>& expired);
+
+        /// @brief Stop and report every timer in level 0 slot `slot` (all due at `m_nowMs`).
+        void ExpireSlot(std::uint32_t slot, std::vector<std::uint32_t>& expired);
+    };
+} // namespace DSREquipmentSwap
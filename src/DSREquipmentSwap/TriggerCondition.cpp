@@ -0,0 +1,656 @@
+#include "TriggerCondition.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <format>
+#include <limits>
+
+using namespace DSREquipmentSwap;
+
+namespace
+{
+    /// @brief Apply binary `op` to `a` and `b`. Shared by constant folding and `RunCondition()`, so both agree.
+    std::int32_t ApplyBinary(const ConditionOp op, const std::int32_t a, const std::int32_t b)
+    {
+        // Wrapping arithmetic (through unsigned), so no input is undefined behavior.
+        const auto ua = static_cast<std::uint32_t>(a);
+        const auto ub = static_cast<std::uint32_t>(b);
+        switch (op)
+        {
+            case ConditionOp::ADD:
+                return static_cast<std::int32_t>(ua + ub);
+            case ConditionOp::SUB:
+                return static_cast<std::int32_t>(ua - ub);
+            case ConditionOp::MUL:
+                return static_cast<std::int32_t>(ua * ub);
+            case ConditionOp::DIV:
+                if (b == 0)
+                    return 0;
+                if (b == -1)
+                    return static_cast<std::int32_t>(0u - ua);
+                return a / b;
+            case ConditionOp::MOD:
+                return b == 0 || b == -1 ? 0 : a % b;
+            case ConditionOp::EQ:
+                return a == b;
+            case ConditionOp::NE:
+                return a != b;
+            case ConditionOp::LT:
+                return a < b;
+            case ConditionOp::LE:
+                return a <= b;
+            case ConditionOp::GT:
+                return a > b;
+            case ConditionOp::GE:
+                return a >= b;
+            default:
+                return 0;
+        }
+    }
+
+    [[nodiscard]] bool IsComparison(const ConditionOp op)
+    {
+        return op >= ConditionOp::EQ && op <= ConditionOp::GE;
+    }
+
+    /// @brief Get the `*_CONSTANT` form of binary `op`.
+    [[nodiscard]] ConditionOp WithConstantOperand(const ConditionOp op)
+    {
+        return static_cast<ConditionOp>(
+            static_cast<int>(op) - static_cast<int>(ConditionOp::ADD) + static_cast<int>(ConditionOp::ADD_CONSTANT));
+    }
+
+    /// @brief Get the binary operator that gives the same result as `op` with its operands swapped, if there is one.
+    [[nodiscard]] std::optional<ConditionOp> GetSwappedOperator(const ConditionOp op)
+    {
+        switch (op)
+        {
+            case ConditionOp::ADD:
+            case ConditionOp::MUL:
+            case ConditionOp::EQ:
+            case ConditionOp::NE:
+                return op;
+            case ConditionOp::LT:
+                return ConditionOp::GT;
+            case ConditionOp::LE:
+                return ConditionOp::GE;
+            case ConditionOp::GT:
+                return ConditionOp::LT;
+            case ConditionOp::GE:
+                return ConditionOp::LE;
+            default:
+                return std::nullopt;
+        }
+    }
+
+    /// @brief Recursive-descent parser that builds a constant-folded expression tree, then emits it as bytecode.
+    class ConditionCompiler
+    {
+    public:
+        ConditionCompiler(const std::string_view source, const EquipSlot slot, std::vector<std::int32_t>& spEffectIDs)
+            : m_source(source)
+            , m_slot(slot)
+            , m_spEffectIDs(spEffectIDs)
+        {}
+
+        std::optional<CompiledCondition> Compile(std::string& error)
+        {
+            if (m_source.size() > CONDITION_MAX_LENGTH)
+            {
+                error = std::format("Condition is longer than {} characters.", CONDITION_MAX_LENGTH);
+                return std::nullopt;
+            }
+
+            const int root = ParseOr();
+            SkipSpace();
+            if (m_error.empty() && m_pos < m_source.size())
+                Fail(std::format("Unexpected '{}'.", m_source[m_pos]));
+            if (!m_error.empty())
+            {
+                error = std::format("{} (at character {})", m_error, m_errorPos + 1);
+                return std::nullopt;
+            }
+
+            CompiledCondition compiled;
+            if (m_nodes[root].op == ConditionOp::PUSH)
+                compiled.constantValue = m_nodes[root].operand != 0;
+            Emit(root, compiled.code);
+            compiled.code.push_back(ConditionInstruction{ConditionOp::RETURN, 0});
+
+            // Only slots still read after folding (e.g. not those of `false && id`).
+            for (const ConditionInstruction& instruction : compiled.code)
+            {
+                if (instruction.op == ConditionOp::LOAD_SLOT)
+                    compiled.slots.set(static_cast<std::size_t>(instruction.operand));
+            }
+            if (m_maxDepth > CONDITION_MAX_STACK)
+            {
+                error = std::format("Condition needs a stack deeper than {}. Simplify it.", CONDITION_MAX_STACK);
+                return std::nullopt;
+            }
+            return compiled;
+        }
+
+    private:
+        // Expression tree node. Leaves are `PUSH` and `LOAD_*`; `JUMP_IF_FALSE`/`JUMP_IF_TRUE` stand for `&&`/`||`.
+        struct Node
+        {
+            ConditionOp op;
+            std::int32_t operand = 0;
+            int lhs = -1;
+            int rhs = -1;
+            bool isBool = false; // always 0 or 1
+        };
+
+        static constexpr int MAX_NESTING = 64;
+
+        std::string_view m_source;
+        EquipSlot m_slot;
+        std::vector<std::int32_t>& m_spEffectIDs;
+        std::size_t m_pos = 0;
+        int m_nesting = 0;
+        std::string m_error;
+        std::size_t m_errorPos = 0;
+        std::vector<Node> m_nodes;
+        int m_depth = 0;
+        int m_maxDepth = 0;
+
+        // --- Errors ---
+
+        int Fail(const std::string& message)
+        {
+            if (m_error.empty())
+            {
+                m_error = message;
+                m_errorPos = m_pos;
+            }
+            return Constant(0); // keeps parsing well-formed; the result is discarded
+        }
+
+        // --- Lexing ---
+
+        void SkipSpace()
+        {
+            while (m_pos < m_source.size() && std::isspace(static_cast<unsigned char>(m_source[m_pos])))
+                ++m_pos;
+        }
+
+        /// @brief Consume `token` if it comes next.
+        bool Accept(const std::string_view token)
+        {
+            SkipSpace();
+            if (m_source.substr(m_pos, token.size()) != token)
+                return false;
+            m_pos += token.size();
+            return true;
+        }
+
+        void Expect(const std::string_view token)
+        {
+            if (!Accept(token))
+                Fail(std::format("Expected '{}'.", token));
+        }
+
+        std::string_view ReadIdentifier()
+        {
+            SkipSpace();
+            const std::size_t start = m_pos;
+            while (m_pos < m_source.size()
+                   && (std::isalnum(static_cast<unsigned char>(m_source[m_pos])) || m_source[m_pos] == '_'))
+                ++m_pos;
+            return m_source.substr(start, m_pos - start);
+        }
+
+        // --- Tree building (with constant folding) ---
+
+        int Add(const Node& node)
+        {
+            m_nodes.push_back(node);
+            return static_cast<int>(m_nodes.size()) - 1;
+        }
+
+        int Constant(const std::int32_t value)
+        {
+            return Add(Node{ConditionOp::PUSH, value, -1, -1, value == 0 || value == 1});
+        }
+
+        [[nodiscard]] bool IsConstant(const int node) const { return m_nodes[node].op == ConditionOp::PUSH; }
+
+        int ToBool(const int node)
+        {
+            if (m_nodes[node].isBool)
+                return node;
+            if (IsConstant(node))
+                return Constant(m_nodes[node].operand != 0);
+            return Add(Node{ConditionOp::BOOL, 0, node, -1, true});
+        }
+
+        int Unary(const ConditionOp op, const int operand)
+        {
+            if (IsConstant(operand))
+            {
+                const std::int32_t value = m_nodes[operand].operand;
+                return Constant(op == ConditionOp::NOT ? value == 0 : ApplyBinary(ConditionOp::SUB, 0, value));
+            }
+            return Add(Node{op, 0, operand, -1, op == ConditionOp::NOT});
+        }
+
+        int Binary(const ConditionOp op, const int lhs, const int rhs)
+        {
+            if (IsConstant(lhs) && IsConstant(rhs))
+                return Constant(ApplyBinary(op, m_nodes[lhs].operand, m_nodes[rhs].operand));
+            // Constants go on the right where possible, to be emitted as a `*_CONSTANT` operand.
+            if (const std::optional<ConditionOp> swapped = GetSwappedOperator(op); swapped && IsConstant(lhs))
+                return Add(Node{*swapped, 0, rhs, lhs, IsComparison(op)});
+            return Add(Node{op, 0, lhs, rhs, IsComparison(op)});
+        }
+
+        /// @brief `lhs && rhs` (`isAnd`) or `lhs || rhs`. Operands have no side effects, so a constant on either side
+        /// decides the result or drops out.
+        int Logical(const bool isAnd, const int lhs, const int rhs)
+        {
+            const std::int32_t absorbing = isAnd ? 0 : 1; // `false &&` / `true ||`
+            for (const int side : {lhs, rhs})
+            {
+                if (IsConstant(side) && (m_nodes[side].operand != 0) == (absorbing != 0))
+                    return Constant(absorbing);
+            }
+            if (IsConstant(lhs))
+                return ToBool(rhs);
+            if (IsConstant(rhs))
+                return ToBool(lhs);
+            const ConditionOp op = isAnd ? ConditionOp::JUMP_IF_FALSE : ConditionOp::JUMP_IF_TRUE;
+            return Add(Node{op, 0, ToBool(lhs), ToBool(rhs), true});
+        }
+
+        // --- Parsing, loosest binding first ---
+
+        int ParseOr()
+        {
+            int lhs = ParseAnd();
+            while (m_error.empty() && Accept("||"))
+                lhs = Logical(false, lhs, ParseAnd());
+            return lhs;
+        }
+
+        int ParseAnd()
+        {
+            int lhs = ParseNot();
+            while (m_error.empty() && Accept("&&"))
+                lhs = Logical(true, lhs, ParseNot());
+            return lhs;
+        }
+
+        int ParseNot()
+        {
+            SkipSpace();
+            if (m_source.substr(m_pos, 2) != "!=" && Accept("!"))
+            {
+                if (++m_nesting > MAX_NESTING)
+                    return Fail("Condition is nested too deeply.");
+                const int operand = ParseNot();
+                --m_nesting;
+                return Unary(ConditionOp::NOT, operand);
+            }
+            return ParseComparison();
+        }
+
+        int ParseComparison()
+        {
+            const int lhs = ParseSum();
+            // Two-character operators first.
+            static constexpr std::array<std::pair<std::string_view, ConditionOp>, 6> OPERATORS = {{
+                {"==", ConditionOp::EQ},
+                {"!=", ConditionOp::NE},
+                {"<=", ConditionOp::LE},
+                {">=", ConditionOp::GE},
+                {"<", ConditionOp::LT},
+                {">", ConditionOp::GT},
+            }};
+            for (const auto& [token, op] : OPERATORS)
+            {
+                if (Accept(token))
+                    return Binary(op, lhs, ParseSum());
+            }
+            return lhs;
+        }
+
+        int ParseSum()
+        {
+            int lhs = ParseProduct();
+            while (m_error.empty())
+            {
+                if (Accept("+"))
+                    lhs = Binary(ConditionOp::ADD, lhs, ParseProduct());
+                else if (Accept("-"))
+                    lhs = Binary(ConditionOp::SUB, lhs, ParseProduct());
+                else
+                    break;
+            }
+            return lhs;
+        }
+
+        int ParseProduct()
+        {
+            int lhs = ParseNegation();
+            while (m_error.empty())
+            {
+                if (Accept("*"))
+                    lhs = Binary(ConditionOp::MUL, lhs, ParseNegation());
+                else if (Accept("/"))
+                    lhs = Binary(ConditionOp::DIV, lhs, ParseNegation());
+                else if (Accept("%"))
+                    lhs = Binary(ConditionOp::MOD, lhs, ParseNegation());
+                else
+                    break;
+            }
+            return lhs;
+        }
+
+        int ParseNegation()
+        {
+            if (!Accept("-"))
+                return ParseOperand();
+            if (++m_nesting > MAX_NESTING)
+                return Fail("Condition is nested too deeply.");
+            const int operand = ParseNegation();
+            --m_nesting;
+            return Unary(ConditionOp::NEG, operand);
+        }
+
+        int ParseOperand()
+        {
+            SkipSpace();
+            if (m_pos >= m_source.size())
+                return Fail("Unexpected end of condition.");
+
+            if (Accept("("))
+            {
+                if (++m_nesting > MAX_NESTING)
+                    return Fail("Condition is nested too deeply.");
+                const int inner = ParseOr();
+                --m_nesting;
+                Expect(")");
+                return inner;
+            }
+
+            if (std::isdigit(static_cast<unsigned char>(m_source[m_pos])))
+            {
+                std::int64_t value = 0;
+                while (m_pos < m_source.size() && std::isdigit(static_cast<unsigned char>(m_source[m_pos])))
+                {
+                    value = value * 10 + (m_source[m_pos++] - '0');
+                    if (value > std::numeric_limits<std::int32_t>::max())
+                        return Fail("Integer is too large.");
+                }
+                return Constant(static_cast<std::int32_t>(value));
+            }
+
+            const std::size_t identifierPos = m_pos;
+            const std::string_view name = ReadIdentifier();
+            if (name == "true")
+                return Constant(1);
+            if (name == "false")
+                return Constant(0);
+            if (name == "id")
+                return LoadSlot(m_slot);
+            if (name == "player")
+                return Add(Node{ConditionOp::LOAD_PLAYER});
+            if (name == "param")
+                return ParseParam();
+            if (name == "spEffect")
+                return ParseSpEffect();
+            if (name == "secondary")
+                return ParseSecondary();
+
+            m_pos = identifierPos;
+            if (name.empty())
+                return Fail(std::format("Unexpected '{}'.", m_source[m_pos]));
+            return Fail(std::format("Unknown name '{}'.", name));
+        }
+
+        int LoadSlot(const EquipSlot slot)
+        {
+            return Add(Node{ConditionOp::LOAD_SLOT, static_cast<std::int32_t>(slot)});
+        }
+
+        int ParseParam()
+        {
+            Expect("(");
+            const std::size_t keyPos = m_pos;
+            const std::string_view key = ReadIdentifier();
+            const std::optional<EquipSlot> slot = FindEquipSlot(key);
+            if (!slot)
+            {
+                m_pos = keyPos;
+                return Fail(std::format("Unknown slot '{}'.", key));
+            }
+            Expect(")");
+            return LoadSlot(*slot);
+        }
+
+        int ParseSpEffect()
+        {
+            Expect("(");
+            const std::size_t argumentPos = m_pos;
+            const int argument = ParseOr();
+            Expect(")");
+            if (!m_error.empty())
+                return argument;
+            if (!IsConstant(argument) || m_nodes[argument].operand <= 0)
+            {
+                m_pos = argumentPos;
+                return Fail("spEffect() takes a constant SpEffect ID greater than 0.");
+            }
+
+            const std::int32_t spEffectID = m_nodes[argument].operand;
+            auto it = std::ranges::find(m_spEffectIDs, spEffectID);
+            if (it == m_spEffectIDs.end())
+                it = m_spEffectIDs.insert(m_spEffectIDs.end(), spEffectID);
+            return Add(
+                Node{ConditionOp::LOAD_SP_EFFECT, static_cast<std::int32_t>(it - m_spEffectIDs.begin()), -1, -1, true});
+        }
+
+        int ParseSecondary()
+        {
+            Expect("(");
+            const std::size_t handPos = m_pos;
+            const std::string_view hand = ReadIdentifier();
+            if (hand != "left" && hand != "right")
+            {
+                m_pos = handPos;
+                return Fail("secondary() takes 'left' or 'right'.");
+            }
+            Expect(")");
+            return Add(Node{ConditionOp::LOAD_SECONDARY, hand == "right", -1, -1, true});
+        }
+
+        // --- Emission ---
+
+        void Push(
+            std::vector<ConditionInstruction>& code,
+            const ConditionOp op,
+            const std::int32_t operand,
+            const int depthChange)
+        {
+            code.push_back(ConditionInstruction{op, operand});
+            m_depth += depthChange;
+            m_maxDepth = std::max(m_maxDepth, m_depth);
+        }
+
+        void Emit(const int index, std::vector<ConditionInstruction>& code)
+        {
+            const Node& node = m_nodes[index];
+            switch (node.op)
+            {
+                case ConditionOp::PUSH:
+                case ConditionOp::LOAD_SLOT:
+                case ConditionOp::LOAD_SECONDARY:
+                case ConditionOp::LOAD_PLAYER:
+                case ConditionOp::LOAD_SP_EFFECT:
+                    Push(code, node.op, node.operand, 1);
+                    break;
+                case ConditionOp::NOT:
+                case ConditionOp::NEG:
+                case ConditionOp::BOOL:
+                    Emit(node.lhs, code);
+                    Push(code, node.op, 0, 0);
+                    break;
+                case ConditionOp::JUMP_IF_FALSE:
+                case ConditionOp::JUMP_IF_TRUE:
+                {
+                    // The left value decides, or is popped and the right value is the result.
+                    Emit(node.lhs, code);
+                    const std::size_t jump = code.size();
+                    Push(code, node.op, 0, -1);
+                    Emit(node.rhs, code);
+                    code[jump].operand = static_cast<std::int32_t>(code.size());
+                    break;
+                }
+                default: // binary
+                    Emit(node.lhs, code);
+                    if (IsConstant(node.rhs))
+                    {
+                        Push(code, WithConstantOperand(node.op), m_nodes[node.rhs].operand, 0);
+                        break;
+                    }
+                    Emit(node.rhs, code);
+                    Push(code, node.op, 0, -1);
+                    break;
+            }
+        }
+    };
+} // namespace
+
+std::optional<CompiledCondition> DSREquipmentSwap::CompileCondition(
+    const std::string_view source, const EquipSlot slot, std::vector<std::int32_t>& spEffectIDs, std::string& error)
+{
+    return ConditionCompiler(source, slot, spEffectIDs).Compile(error);
+}
+
+bool DSREquipmentSwap::RunCondition(const ConditionInstruction* code, const ConditionContext& context)
+{
+    // The top of the stack lives in `top` (a register), and only values below it in `stack`.
+    std::array<std::int32_t, CONDITION_MAX_STACK> stack; // depth checked at compile time
+    std::int32_t* below = stack.data();
+    std::int32_t top = 0;
+    const ConditionInstruction* instruction = code;
+    while (true)
+    {
+        const std::int32_t operand = instruction->operand;
+        switch ((instruction++)->op)
+        {
+            case ConditionOp::PUSH:
+                *below++ = top;
+                top = operand;
+                break;
+            case ConditionOp::LOAD_SLOT:
+                *below++ = top;
+                top = context.snapshot.paramIDs[operand];
+                break;
+            case ConditionOp::LOAD_SECONDARY:
+                *below++ = top;
+                top = context.snapshot.isSecondaryActive[operand];
+                break;
+            case ConditionOp::LOAD_PLAYER:
+                *below++ = top;
+                top = context.playerIndex;
+                break;
+            case ConditionOp::LOAD_SP_EFFECT:
+                *below++ = top;
+                top = context.spEffectActive[operand];
+                break;
+            case ConditionOp::NOT:
+                top = top == 0;
+                break;
+            case ConditionOp::NEG:
+                top = ApplyBinary(ConditionOp::SUB, 0, top);
+                break;
+            case ConditionOp::BOOL:
+                top = top != 0;
+                break;
+            case ConditionOp::JUMP_IF_FALSE:
+                if (top == 0)
+                    instruction = code + operand;
+                else
+                    top = *--below;
+                break;
+            case ConditionOp::JUMP_IF_TRUE:
+                if (top != 0)
+                    instruction = code + operand;
+                else
+                    top = *--below;
+                break;
+            case ConditionOp::RETURN:
+                return top != 0;
+            // Binary operators, spelled out so each is one dispatch.
+            case ConditionOp::ADD:
+                top = ApplyBinary(ConditionOp::ADD, *--below, top);
+                break;
+            case ConditionOp::SUB:
+                top = ApplyBinary(ConditionOp::SUB, *--below, top);
+                break;
+            case ConditionOp::MUL:
+                top = ApplyBinary(ConditionOp::MUL, *--below, top);
+                break;
+            case ConditionOp::DIV:
+                top = ApplyBinary(ConditionOp::DIV, *--below, top);
+                break;
+            case ConditionOp::MOD:
+                top = ApplyBinary(ConditionOp::MOD, *--below, top);
+                break;
+            case ConditionOp::EQ:
+                top = *--below == top;
+                break;
+            case ConditionOp::NE:
+                top = *--below != top;
+                break;
+            case ConditionOp::LT:
+                top = *--below < top;
+                break;
+            case ConditionOp::LE:
+                top = *--below <= top;
+                break;
+            case ConditionOp::GT:
+                top = *--below > top;
+                break;
+            case ConditionOp::GE:
+                top = *--below >= top;
+                break;
+            case ConditionOp::ADD_CONSTANT:
+                top = ApplyBinary(ConditionOp::ADD, top, operand);
+                break;
+            case ConditionOp::SUB_CONSTANT:
+                top = ApplyBinary(ConditionOp::SUB, top, operand);
+                break;
+            case ConditionOp::MUL_CONSTANT:
+                top = ApplyBinary(ConditionOp::MUL, top, operand);
+                break;
+            case ConditionOp::DIV_CONSTANT:
+                top = ApplyBinary(ConditionOp::DIV, top, operand);
+                break;
+            case ConditionOp::MOD_CONSTANT:
+                top = ApplyBinary(ConditionOp::MOD, top, operand);
+                break;
+            case ConditionOp::EQ_CONSTANT:
+                top = top == operand;
+                break;
+            case ConditionOp::NE_CONSTANT:
+                top = top != operand;
+                break;
+            case ConditionOp::LT_CONSTANT:
+                top = top < operand;
+                break;
+            case ConditionOp::LE_CONSTANT:
+                top = top <= operand;
+                break;
+            case ConditionOp::GT_CONSTANT:
+                top = top > operand;
+                break;
+            case ConditionOp::GE_CONSTANT:
+                top = top >= operand;
+                break;
+        }
+    }
+}
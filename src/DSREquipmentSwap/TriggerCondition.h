@@ -0,0 +1,103 @@
+#pragma once
+
+#include <DSREquipmentSwap/Slots.h>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Instruction set of compiled trigger conditions: a stack machine over 32-bit integers (booleans are 0 or
+    /// 1). Arithmetic wraps around, and division or modulo by zero gives 0.
+    enum class ConditionOp : std::uint8_t
+    {
+        PUSH,           // push `operand`
+        LOAD_SLOT,      // push the snapshot ParamID of slot `operand`
+        LOAD_SECONDARY, // push 1 if the secondary weapon of hand `operand` (0 = left, 1 = right) is current
+        LOAD_PLAYER,    // push the player index
+        LOAD_SP_EFFECT, // push 1 if condition SpEffect `operand` (see `ConditionContext`) is active
+        NOT,
+        NEG,
+        BOOL, // replace the top with 1 if it is not 0
+        ADD,
+        SUB,
+        MUL,
+        DIV,
+        MOD,
+        EQ,
+        NE,
+        LT,
+        LE,
+        GT,
+        GE,
+        // Binary operators with a constant right operand (`operand`), in the same order as above.
+        ADD_CONSTANT,
+        SUB_CONSTANT,
+        MUL_CONSTANT,
+        DIV_CONSTANT,
+        MOD_CONSTANT,
+        EQ_CONSTANT,
+        NE_CONSTANT,
+        LT_CONSTANT,
+        LE_CONSTANT,
+        GT_CONSTANT,
+        GE_CONSTANT,
+        JUMP_IF_FALSE, // if the top is 0, jump to instruction `operand` (keeping it); otherwise pop it
+        JUMP_IF_TRUE,  // if the top is not 0, jump to instruction `operand` (keeping it); otherwise pop it
+        RETURN,        // the condition holds if the top is not 0
+    };
+
+    /// @brief One instruction. Jump targets are relative to the start of the condition's code.
+    struct ConditionInstruction
+    {
+        ConditionOp op;
+        std::int32_t operand;
+    };
+
+    /// @brief Deepest stack a condition may need. Deeper conditions are rejected at compile time.
+    constexpr int CONDITION_MAX_STACK = 16;
+
+    /// @brief Longest condition source accepted, in characters.
+    constexpr std::size_t CONDITION_MAX_LENGTH = 1024;
+
+    /// @brief A trigger condition compiled by `CompileCondition()`.
+    struct CompiledCondition
+    {
+        std::vector<ConditionInstruction> code; // ends with `RETURN`
+        std::optional<bool> constantValue;      // set if the whole condition folded to a constant
+        SlotMask slots;                         // slots whose ParamID the condition reads
+    };
+
+    /// @brief Compile condition `source` for a trigger on `slot` (what `id` refers to).
+    ///
+    /// @details Grammar, loosest binding first: `||`, `&&`, `!` (prefix), comparisons (`==`, `!=`, `<`, `<=`, `>`,
+    /// `>=`; not chained), `+`/`-`, `*`/`/`/`%`, unary `-`, then operands:
+    /// - integer literals, `true`, `false` and parenthesized expressions;
+    /// - `id`: ParamID in the trigger's own slot;
+    /// - `param(<slot>)`: ParamID in another slot, named by its config key (e.g. `param(rightPrimaryWeapon)`);
+    /// - `spEffect(<expression>)`: 1 if that SpEffect is active (the argument must be constant);
+    /// - `secondary(left)` / `secondary(right)`: 1 if that hand's current weapon is its secondary one;
+    /// - `player`: player index (0 = host).
+    ///
+    /// Constant subexpressions are folded, constant operands are inlined into the instruction that uses them, and
+    /// `&&`/`||` compile to short-circuit jumps. SpEffect IDs are given dense
+    /// indices in `spEffectIDs`, which may be shared between conditions (new IDs are appended). Returns nullopt and sets
+    /// `error` if `source` is invalid.
+    std::optional<CompiledCondition> CompileCondition(
+        std::string_view source, EquipSlot slot, std::vector<std::int32_t>& spEffectIDs, std::string& error);
+
+    /// @brief Data a condition is evaluated against.
+    struct ConditionContext
+    {
+        const PlayerSnapshot& snapshot;
+        int playerIndex;
+        std::span<const std::uint8_t> spEffectActive; // indexed like `CompileCondition()`'s `spEffectIDs`
+    };
+
+    /// @brief Run compiled condition `code` (from its first instruction). Returns true if the condition holds.
+    [[nodiscard]] bool RunCondition(const ConditionInstruction* code, const ConditionContext& context);
+} // namespace DSREquipmentSwap
@@ -0,0 +1,575 @@
+#include "TriggerTable.h"
+
+#include <DSREquipmentSwap/ParamIDMatch.h>
+#ifdef DSR_EQUIPMENT_SWAP_EMBEDDED
+#include <DSREquipmentSwap/EmbeddedConfigData.h>
+#endif
+
+#include <algorithm>
+#include <format>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace DSREquipmentSwap;
+
+namespace
+{
+    /// @brief Hash of every field of `config` (matches `SwapTriggerConfig::operator==`).
+    std::size_t HashTriggerConfig(const SwapTriggerConfig& config)
+    {
+        std::size_t hash = std::hash<std::string>{}(config.condition);
+        for (const int field : {
+                 config.spEffectIDTrigger,
+                 config.paramIDTrigger,
+                 config.maxParamIDTrigger,
+                 config.targetParamID,
+                 static_cast<int>(config.isTargetIDAbsolute),
+                 static_cast<int>(config.isPermanent),
+                 config.group,
+                 config.priority,
+                 config.durationMs})
+            hash = hash * 1'000'003 ^ std::hash<int>{}(field);
+        return hash;
+    }
+
+    template <typename T>
+    std::size_t GetVectorBytes(const std::vector<T>& vector)
+    {
+        return vector.capacity() * sizeof(T);
+    }
+} // namespace
+
+TriggerTable::TriggerTable(const EquipmentSwapConfig& config, const TimerClock& clock)
+{
+    std::size_t count = 0;
+    for (const TriggerCategory& category : TRIGGER_CATEGORIES)
+        count += (config.*category.triggers).size() * category.slotCount;
+    m_minParamIDs.reserve(count);
+    m_maxParamIDs.reserve(count);
+    m_spEffectIDs.reserve(count);
+    m_targetParamIDs.reserve(count);
+    m_flags.reserve(count);
+    m_conditionStarts.reserve(count);
+    m_definitionIndices.reserve(count);
+    m_chainConfigs = config.swapChains;
+
+    // Store each distinct trigger config once, whichever lists it appears in and however many times.
+    std::vector<std::vector<std::uint32_t>> categoryDefinitions(TRIGGER_CATEGORIES.size());
+    std::unordered_multimap<std::size_t, std::uint32_t> definitionsByHash;
+    for (std::size_t categoryIndex = 0; categoryIndex < TRIGGER_CATEGORIES.size(); ++categoryIndex)
+    {
+        for (const SwapTriggerConfig& triggerConfig : config.*TRIGGER_CATEGORIES[categoryIndex].triggers)
+        {
+            const std::size_t hash = HashTriggerConfig(triggerConfig);
+            auto [match, end] = definitionsByHash.equal_range(hash);
+            while (match != end && m_definitions[match->second] != triggerConfig)
+                ++match;
+            std::uint32_t definitionIndex;
+            if (match != end)
+                definitionIndex = match->second;
+            else
+            {
+                definitionIndex = static_cast<std::uint32_t>(m_definitions.size());
+                m_definitions.push_back(triggerConfig);
+                definitionsByHash.emplace(hash, definitionIndex);
+            }
+            categoryDefinitions[categoryIndex].push_back(definitionIndex);
+        }
+    }
+    m_definitions.shrink_to_fit();
+
+    // Slot-major insertion keeps the arrays sorted by slot without needing to sort them.
+    std::vector<std::uint32_t> slotTriggers;
+    std::vector<std::uint32_t> slotInstances;
+    for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+    {
+        const auto slot = static_cast<EquipSlot>(slotIndex);
+        m_slotStarts[slotIndex] = GetCount();
+        slotTriggers.clear();
+        for (std::size_t categoryIndex = 0; categoryIndex < TRIGGER_CATEGORIES.size(); ++categoryIndex)
+        {
+            const TriggerCategory& category = TRIGGER_CATEGORIES[categoryIndex];
+            for (int i = 0; i < category.slotCount; ++i)
+            {
+                const std::vector<std::uint32_t>& definitions = categoryDefinitions[categoryIndex];
+                if (category.slots[i] == slot)
+                    slotTriggers.insert(slotTriggers.end(), definitions.begin(), definitions.end());
+            }
+        }
+
+        // Evaluation order is the priority order, as the first match wins. Stable, so ties keep config order.
+        std::ranges::stable_sort(
+            slotTriggers,
+            [this](const std::uint32_t a, const std::uint32_t b)
+            {
+                return m_definitions[a].priority > m_definitions[b].priority;
+            });
+        slotInstances.assign(m_definitions.size(), NO_INSTANCE);
+        for (const std::uint32_t definitionIndex : slotTriggers)
+            Append(definitionIndex, slot, slotInstances);
+
+        m_chainSlotStarts[slotIndex] = static_cast<std::uint32_t>(m_chainTransitions.size());
+        AppendChains(config, slot);
+    }
+    m_slotStarts[EQUIP_SLOT_COUNT] = GetCount();
+    m_chainSlotStarts[EQUIP_SLOT_COUNT] = static_cast<std::uint32_t>(m_chainTransitions.size());
+    m_spEffectActive.assign(GetCount() + GetChainCount(), 0);
+    m_conditionSpEffectActive.assign(m_conditionSpEffectIDs.size(), 0);
+    for (std::uint32_t i = 0; i < m_conditionSpEffectIDs.size(); ++i)
+        m_conditionSpEffectLookup.emplace_back(m_conditionSpEffectIDs[i], i);
+    std::ranges::sort(m_conditionSpEffectLookup);
+    m_conditionCode.shrink_to_fit();
+    m_chainTransitions.shrink_to_fit();
+
+    // Only rules with a SpEffect ever go on cooldown.
+    m_cooldownIndices.reserve(GetCount() + GetChainCount());
+    for (const std::int32_t spEffectID : m_spEffectIDs)
+        m_cooldownIndices.push_back(spEffectID > 0 ? m_cooldownRuleCount++ : NO_COOLDOWN);
+    for (const std::int32_t spEffectID : m_chainSpEffectIDs)
+        m_cooldownIndices.push_back(spEffectID > 0 ? m_cooldownRuleCount++ : NO_COOLDOWN);
+    m_cooldowns = TimerWheel(m_cooldownRuleCount * DSR_MAX_PLAYERS, clock);
+    MoveTexts();
+
+#ifdef DSR_EQUIPMENT_SWAP_EMBEDDED
+    // The generated hash holds rule indices of the table the embedder built. A table with other counts (e.g. if the
+    // embedded config and this code were built from different trigger table versions) would get indices of other
+    // rules, or past its own, for every SpEffect lookup. Logged too, since the DLL's bootstrap swallows exceptions.
+    if (GetCount() != EmbeddedConfigData::TRIGGER_COUNT || GetChainCount() != EmbeddedConfigData::CHAIN_COUNT)
+    {
+        const std::string error = std::format(
+            "Trigger table has {} triggers and {} chains, but the embedded SpEffect hash was built for {} and {}. "
+            "Rebuild the embedded config.",
+            GetCount(),
+            GetChainCount(),
+            EmbeddedConfigData::TRIGGER_COUNT,
+            EmbeddedConfigData::CHAIN_COUNT);
+        Firelink::Error(error);
+        throw std::runtime_error(error);
+    }
+#else
+    // Embedded-config builds use the hash generated at build time instead. Rule indices are triggers, then chains.
+    std::vector<std::int32_t> ruleSpEffectIDs = m_spEffectIDs;
+    ruleSpEffectIDs.insert(ruleSpEffectIDs.end(), m_chainSpEffectIDs.begin(), m_chainSpEffectIDs.end());
+    m_spEffectHash = SpEffectHash::Build(ruleSpEffectIDs);
+#endif
+}
+
+void TriggerTable::Append(
+    const std::uint32_t definitionIndex, const EquipSlot slot, std::vector<std::uint32_t>& slotInstances)
+{
+    const SwapTriggerConfig& config = m_definitions[definitionIndex];
+
+    // Fold the three ParamID condition forms (none, exact, range) into one inclusive range.
+    std::int32_t minParamID = std::numeric_limits<std::int32_t>::min();
+    std::int32_t maxParamID = std::numeric_limits<std::int32_t>::max();
+    if (config.paramIDTrigger > 0)
+    {
+        minParamID = config.paramIDTrigger;
+        maxParamID = config.maxParamIDTrigger == -1 ? config.paramIDTrigger : config.maxParamIDTrigger;
+    }
+
+    m_minParamIDs.push_back(minParamID);
+    m_maxParamIDs.push_back(maxParamID);
+    m_spEffectIDs.push_back(config.spEffectIDTrigger);
+    m_targetParamIDs.push_back(config.targetParamID);
+
+    // A duplicate in the same slot compiles to the same code, so it shares the earlier instance's.
+    bool hasCondition;
+    if (const std::uint32_t sameInstance = slotInstances[definitionIndex]; sameInstance != NO_INSTANCE)
+    {
+        m_conditionStarts.push_back(m_conditionStarts[sameInstance]);
+        hasCondition = (m_flags[sameInstance] & FLAG_CONDITION) != 0;
+    }
+    else
+        hasCondition = AppendCondition(config, slot);
+    m_flags.push_back((config.isTargetIDAbsolute ? FLAG_ABSOLUTE_TARGET : 0) | (hasCondition ? FLAG_CONDITION : 0));
+    slotInstances[definitionIndex] = GetCount();
+    m_definitionIndices.push_back(definitionIndex);
+}
+
+bool TriggerTable::AppendCondition(const SwapTriggerConfig& config, const EquipSlot slot)
+{
+    m_conditionStarts.push_back(static_cast<std::uint32_t>(m_conditionCode.size()));
+    if (config.condition.empty())
+        return false;
+
+    // Compiled per slot instance: `id` is a different load in each slot.
+    std::string error;
+    std::optional<CompiledCondition> compiled = CompileCondition(config.condition, slot, m_conditionSpEffectIDs, error);
+    if (!compiled)
+    {
+        // Rejected by `Validate()` already; never fire rather than ignore the condition.
+        m_conditionCode.push_back(ConditionInstruction{ConditionOp::PUSH, 0});
+        m_conditionCode.push_back(ConditionInstruction{ConditionOp::RETURN, 0});
+        return true;
+    }
+    if (compiled->constantValue == true)
+        return false; // folded away
+    m_conditionCode.insert(m_conditionCode.end(), compiled->code.begin(), compiled->code.end());
+    m_conditionSlots |= compiled->slots;
+    return true;
+}
+
+void TriggerTable::AppendChains(const EquipmentSwapConfig& config, const EquipSlot slot)
+{
+    // Chains of this slot's categories, in config order.
+    std::vector<std::uint32_t> chainIndices;
+    for (std::uint32_t configIndex = 0; configIndex < config.swapChains.size(); ++configIndex)
+    {
+        const SwapChainConfig& chain = config.swapChains[configIndex];
+        const TriggerCategory* category = FindTriggerCategory(chain.category);
+        if (category == nullptr || chain.paramIDs.size() < 2)
+            continue; // invalid (reported by `Validate()`)
+        if (std::ranges::find(category->slots.begin(), category->slots.begin() + category->slotCount, slot)
+            == category->slots.begin() + category->slotCount)
+            continue;
+
+        chainIndices.push_back(GetChainCount());
+        m_chainSpEffectIDs.push_back(chain.spEffectIDTrigger);
+        m_chainFlags.push_back(0);
+        m_chainConfigIndices.push_back(configIndex);
+    }
+
+    // Chains without a SpEffect are followed to their end, through any number of chains. The first chain to list an ID
+    // decides where it goes next.
+    std::unordered_map<std::int32_t, std::int32_t> nextParamID;
+    for (const std::uint32_t chainIndex : chainIndices)
+    {
+        const SwapChainConfig& chain = m_chainConfigs[m_chainConfigIndices[chainIndex]];
+        if (chain.spEffectIDTrigger > 0)
+            continue;
+        for (std::size_t i = 0; i + 1 < chain.paramIDs.size(); ++i)
+            nextParamID.try_emplace(chain.paramIDs[i], chain.paramIDs[i + 1]);
+    }
+    auto resolve = [&nextParamID](std::int32_t paramID)
+    {
+        // Bounded, in case chains from different entries form a loop.
+        for (std::size_t hops = 0; hops < nextParamID.size(); ++hops)
+        {
+            const auto next = nextParamID.find(paramID);
+            if (next == nextParamID.end())
+                break;
+            paramID = next->second;
+        }
+        return paramID;
+    };
+
+    const auto slotStart = static_cast<std::ptrdiff_t>(m_chainTransitions.size());
+    for (const std::uint32_t chainIndex : chainIndices)
+    {
+        const SwapChainConfig& chain = m_chainConfigs[m_chainConfigIndices[chainIndex]];
+        const std::vector<int>& ids = chain.paramIDs;
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            std::int32_t toParamID;
+            if (chain.spEffectIDTrigger <= 0)
+                toParamID = resolve(ids[i]); // straight to the end
+            else if (i + 1 < ids.size())
+                toParamID = resolve(ids[i + 1]); // one step, plus any chain-less hops from there
+            else if (chain.isCycle)
+                toParamID = resolve(ids.front());
+            else
+                continue; // end of a one-way chain
+
+            if (toParamID != ids[i])
+                m_chainTransitions.push_back(ChainTransition{ids[i], toParamID, chainIndex});
+        }
+    }
+
+    // Sort by source ID for lookup. Stable, so the first chain in config order still wins.
+    std::stable_sort(
+        m_chainTransitions.begin() + slotStart,
+        m_chainTransitions.end(),
+        [](const ChainTransition& a, const ChainTransition& b) { return a.fromParamID < b.fromParamID; });
+}
+
+EquipSlot TriggerTable::GetSlot(const std::uint32_t index) const
+{
+    // First slot whose end is past `index`.
+    const auto end = std::upper_bound(m_slotStarts.begin() + 1, m_slotStarts.end(), index);
+    return static_cast<EquipSlot>(end - m_slotStarts.begin() - 1);
+}
+
+std::span<const std::uint32_t> TriggerTable::FindSpEffectTriggers(const std::int32_t spEffectID) const
+{
+#ifdef DSR_EQUIPMENT_SWAP_EMBEDDED
+    // Generated for the same config with the same trigger order, and fully constexpr.
+    return EmbeddedConfigData::SP_EFFECT_HASH.Find(spEffectID);
+#else
+    return m_spEffectHash.Find(spEffectID);
+#endif
+}
+
+void TriggerTable::MoveTexts()
+{
+    std::size_t textSize = 0;
+    for (const SwapTriggerConfig& definition : m_definitions)
+        textSize += definition.condition.size();
+    for (const SwapChainConfig& chain : m_chainConfigs)
+        textSize += chain.category.size();
+    m_texts.reserve(textSize);
+    m_textStarts.reserve(m_definitions.size() + m_chainConfigs.size() + 1);
+
+    auto move = [this](std::string& text)
+    {
+        m_textStarts.push_back(static_cast<std::uint32_t>(m_texts.size()));
+        m_texts.insert(m_texts.end(), text.begin(), text.end());
+        std::string().swap(text); // frees its heap buffer, if any
+    };
+    for (SwapTriggerConfig& definition : m_definitions)
+        move(definition.condition);
+    for (SwapChainConfig& chain : m_chainConfigs)
+        move(chain.category);
+    m_textStarts.push_back(static_cast<std::uint32_t>(m_texts.size()));
+}
+
+std::string TriggerTable::DescribeRule(const std::uint32_t ruleIndex) const
+{
+    if (ruleIndex < GetCount())
+    {
+        SwapTriggerConfig config = GetConfig(ruleIndex);
+        config.condition = GetText(m_definitionIndices[ruleIndex]);
+        return config.ToString();
+    }
+    const std::uint32_t chainConfigIndex = m_chainConfigIndices[ruleIndex - GetCount()];
+    SwapChainConfig chain = m_chainConfigs[chainConfigIndex];
+    chain.category = GetText(m_definitions.size() + chainConfigIndex);
+    return chain.ToString();
+}
+
+bool TriggerTable::IsRulePermanent(const std::uint32_t ruleIndex) const
+{
+    if (ruleIndex < GetCount())
+        return GetConfig(ruleIndex).isPermanent;
+    return m_chainConfigs[m_chainConfigIndices[ruleIndex - GetCount()]].isPermanent;
+}
+
+int TriggerTable::GetRuleDurationMs(const std::uint32_t ruleIndex) const
+{
+    return ruleIndex < GetCount() ? GetConfig(ruleIndex).durationMs : 0; // chains have no duration
+}
+
+void TriggerTable::AppendSpEffectIDs(std::vector<int>& ids) const
+{
+    ids.insert(ids.end(), m_spEffectIDs.begin(), m_spEffectIDs.end());
+    ids.insert(ids.end(), m_chainSpEffectIDs.begin(), m_chainSpEffectIDs.end());
+    ids.insert(ids.end(), m_conditionSpEffectIDs.begin(), m_conditionSpEffectIDs.end());
+}
+
+SlotMask TriggerTable::GetTriggeredSlots() const
+{
+    SlotMask slots;
+    for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+    {
+        slots.set(
+            slotIndex,
+            m_slotStarts[slotIndex + 1] > m_slotStarts[slotIndex]
+                || m_chainSlotStarts[slotIndex + 1] > m_chainSlotStarts[slotIndex]);
+    }
+    return slots;
+}
+
+TriggerTableMemory TriggerTable::GetMemoryUsage() const
+{
+    TriggerTableMemory memory;
+    memory.hotBytes = GetVectorBytes(m_minParamIDs) + GetVectorBytes(m_maxParamIDs) + GetVectorBytes(m_spEffectIDs)
+        + GetVectorBytes(m_targetParamIDs) + GetVectorBytes(m_flags);
+    memory.conditionBytes = GetVectorBytes(m_conditionStarts) + GetVectorBytes(m_conditionCode)
+        + GetVectorBytes(m_conditionSpEffectIDs) + GetVectorBytes(m_conditionSpEffectLookup)
+        + GetVectorBytes(m_conditionSpEffectActive);
+    memory.definitionBytes = GetVectorBytes(m_definitionIndices) + GetVectorBytes(m_definitions)
+        + GetVectorBytes(m_chainConfigs) + GetVectorBytes(m_texts) + GetVectorBytes(m_textStarts);
+    for (const SwapChainConfig& chain : m_chainConfigs)
+        memory.definitionBytes += GetVectorBytes(chain.paramIDs);
+    memory.cooldownBytes =
+        GetVectorBytes(m_cooldownIndices) + m_cooldowns.GetMemoryBytes() + GetVectorBytes(m_expiredCooldowns);
+    memory.spEffectBytes =
+        m_spEffectHash.GetMemoryBytes() + GetVectorBytes(m_spEffectActive) + GetVectorBytes(m_spEffectActiveIndices);
+    memory.chainBytes = GetVectorBytes(m_chainSpEffectIDs) + GetVectorBytes(m_chainFlags)
+        + GetVectorBytes(m_chainConfigIndices) + GetVectorBytes(m_chainTransitions);
+    memory.objectBytes = sizeof(TriggerTable);
+    return memory;
+}
+
+std::int32_t TriggerTable::GetRuleSpEffectID(const std::uint32_t ruleIndex) const
+{
+    return ruleIndex < GetCount() ? m_spEffectIDs[ruleIndex] : m_chainSpEffectIDs[ruleIndex - GetCount()];
+}
+
+void TriggerTable::CancelCooldown(const std::uint32_t ruleIndex, const int playerIndex)
+{
+    if (m_cooldownIndices[ruleIndex] != NO_COOLDOWN)
+        m_cooldowns.Cancel(GetCooldownKey(ruleIndex, playerIndex));
+}
+
+void TriggerTable::StartCooldown(const std::uint32_t ruleIndex, const int playerIndex, const int cooldownMs)
+{
+    if (cooldownMs > 0)
+        m_cooldowns.Schedule(GetCooldownKey(ruleIndex, playerIndex), static_cast<std::uint64_t>(cooldownMs));
+}
+
+int TriggerTable::SetGroupEnabled(const int group, const bool enabled)
+{
+    int count = 0;
+    for (std::uint32_t i = 0; i < GetCount(); ++i)
+    {
+        if (GetConfig(i).group != group)
+            continue;
+        if (enabled)
+            m_flags[i] &= ~FLAG_DISABLED;
+        else
+            m_flags[i] |= FLAG_DISABLED;
+        ++count;
+    }
+    for (std::uint32_t i = 0; i < GetChainCount(); ++i)
+    {
+        if (m_chainConfigs[m_chainConfigIndices[i]].group != group)
+            continue;
+        if (enabled)
+            m_chainFlags[i] &= ~FLAG_DISABLED;
+        else
+            m_chainFlags[i] |= FLAG_DISABLED;
+        ++count;
+    }
+    return count;
+}
+
+void TriggerTable::Evaluate(
+    const int playerIndex, PlayerSnapshot& snapshot, const int cooldownMs, std::vector<PendingSwap>& swaps)
+{
+    swaps.clear();
+
+    // Flag the triggers of each active SpEffect. Most active SpEffects belong to no trigger and cost one lookup.
+    for (const int spEffectID : snapshot.activeSpEffects)
+    {
+        for (const std::uint32_t index : FindSpEffectTriggers(spEffectID))
+        {
+            if (!m_spEffectActive[index])
+            {
+                m_spEffectActive[index] = 1;
+                m_spEffectActiveIndices.push_back(index);
+            }
+        }
+    }
+
+    // Conditions ask whether a SpEffect is on the player at all, not whether it just started.
+    if (!m_conditionSpEffectLookup.empty())
+    {
+        const std::vector<int>& heldSpEffects =
+            snapshot.heldSpEffects.empty() ? snapshot.activeSpEffects : snapshot.heldSpEffects;
+        for (const int spEffectID : heldSpEffects)
+        {
+            const auto entry = std::ranges::lower_bound(
+                m_conditionSpEffectLookup, spEffectID, {}, &std::pair<std::int32_t, std::uint32_t>::first);
+            if (entry != m_conditionSpEffectLookup.end() && entry->first == spEffectID)
+                m_conditionSpEffectActive[entry->second] = 1;
+        }
+    }
+    const ConditionContext conditionContext{snapshot, playerIndex, m_conditionSpEffectActive};
+
+    for (int slotIndex = 0; slotIndex < EQUIP_SLOT_COUNT; ++slotIndex)
+    {
+        const auto slot = static_cast<EquipSlot>(slotIndex);
+        const bool isSlotActive = snapshot.IsSlotActive(slot);
+        const std::uint32_t end = m_slotStarts[slotIndex + 1];
+
+        // Triggers are in priority order, and the first one that fires wins the slot for this update.
+        const int currentParamID = snapshot.paramIDs[slotIndex];
+        bool isSlotSwapped = false;
+        std::uint32_t i = m_slotStarts[slotIndex];
+        while (i < end)
+        {
+            // Jump straight to the next trigger whose ParamID range contains the current ID.
+            i += static_cast<std::uint32_t>(
+                FindParamIDMatch(m_minParamIDs.data() + i, m_maxParamIDs.data() + i, end - i, currentParamID));
+            if (i == end)
+                break;
+
+            const std::uint32_t index = i++;
+            if (m_flags[index] & FLAG_DISABLED)
+                continue; // trigger group disabled at runtime
+
+            const std::int32_t spEffectID = m_spEffectIDs[index];
+            if (spEffectID > 0)
+            {
+                // Only works for current weapon slot.
+                if (!isSlotActive)
+                    continue;
+                if (m_cooldowns.IsScheduled(GetCooldownKey(index, playerIndex)))
+                    continue; // SpEffect trigger still on cooldown for this swap
+                if (!m_spEffectActive[index])
+                    continue; // SpEffect not active
+            }
+
+            // Last, as it is the most expensive check.
+            if ((m_flags[index] & FLAG_CONDITION)
+                && !RunCondition(m_conditionCode.data() + m_conditionStarts[index], conditionContext))
+                continue;
+
+            if (spEffectID > 0)
+                StartCooldown(index, playerIndex, cooldownMs);
+
+            const int newParamID = (m_flags[index] & FLAG_ABSOLUTE_TARGET)
+                ? m_targetParamIDs[index]
+                : currentParamID + m_targetParamIDs[index];
+
+            swaps.push_back(PendingSwap{slot, currentParamID, newParamID, index});
+            snapshot.paramIDs[slotIndex] = newParamID;
+            isSlotSwapped = true;
+            break;
+        }
+
+        // Chains come after all triggers, so they only get slots that no trigger swapped.
+        if (!isSlotSwapped && m_chainSlotStarts[slotIndex + 1] > m_chainSlotStarts[slotIndex])
+            EvaluateChains(playerIndex, slot, snapshot, cooldownMs, swaps);
+    }
+
+    for (const std::uint32_t index : m_spEffectActiveIndices)
+        m_spEffectActive[index] = 0;
+    m_spEffectActiveIndices.clear();
+    std::ranges::fill(m_conditionSpEffectActive, 0);
+}
+
+bool TriggerTable::EvaluateChains(
+    const int playerIndex,
+    const EquipSlot slot,
+    PlayerSnapshot& snapshot,
+    const int cooldownMs,
+    std::vector<PendingSwap>& swaps)
+{
+    const int slotIndex = static_cast<int>(slot);
+    const int currentParamID = snapshot.paramIDs[slotIndex];
+    const auto begin = m_chainTransitions.begin() + m_chainSlotStarts[slotIndex];
+    const auto end = m_chainTransitions.begin() + m_chainSlotStarts[slotIndex + 1];
+    auto transition = std::lower_bound(
+        begin,
+        end,
+        currentParamID,
+        [](const ChainTransition& t, const std::int32_t paramID) { return t.fromParamID < paramID; });
+
+    for (; transition != end && transition->fromParamID == currentParamID; ++transition)
+    {
+        const std::uint32_t chainIndex = transition->chainIndex;
+        if (m_chainFlags[chainIndex] & FLAG_DISABLED)
+            continue;
+
+        if (m_chainSpEffectIDs[chainIndex] > 0)
+        {
+            // Same rules as SpEffect triggers: current weapon only, and one step per cooldown.
+            if (!snapshot.IsSlotActive(slot))
+                continue;
+            if (m_cooldowns.IsScheduled(GetCooldownKey(GetCount() + chainIndex, playerIndex)))
+                continue;
+            if (!m_spEffectActive[GetCount() + chainIndex])
+                continue;
+            StartCooldown(GetCount() + chainIndex, playerIndex, cooldownMs);
+        }
+
+        swaps.push_back(PendingSwap{slot, currentParamID, transition->toParamID, GetCount() + chainIndex});
+        snapshot.paramIDs[slotIndex] = transition->toParamID;
+        return true;
+    }
+    return false;
+}
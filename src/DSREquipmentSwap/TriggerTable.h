@@ -0,0 +1,260 @@
+#pragma once
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/Slots.h>
+#include <DSREquipmentSwap/SpEffectHash.h>
+#include <DSREquipmentSwap/TimerWheel.h>
+#include <DSREquipmentSwap/TriggerCondition.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DSREquipmentSwap
+{
+    /// @brief A swap chosen by `TriggerTable::Evaluate()`, still to be written to the game.
+    struct PendingSwap
+    {
+        EquipSlot slot;
+        int sourceParamID;
+        int destParamID;
+        std::uint32_t ruleIndex; // trigger index, or `TriggerTable::GetCount()` + chain index for a swap chain step
+    };
+
+    /// @brief Memory held by a `TriggerTable`, by part, in bytes (vector capacities, not just sizes).
+    struct TriggerTableMemory
+    {
+        std::size_t hotBytes = 0;        // per-trigger arrays read by `Evaluate()`
+        std::size_t conditionBytes = 0;  // compiled conditions
+        std::size_t definitionBytes = 0; // unique trigger configs and chain configs, with their strings and ID lists
+        std::size_t cooldownBytes = 0;   // cooldown timers (SpEffect rules only) and their per-rule indices
+        std::size_t spEffectBytes = 0;   // SpEffect hash and per-rule active flags
+        std::size_t chainBytes = 0;      // chain instances and transitions
+        std::size_t objectBytes = 0;     // the table object itself
+
+        [[nodiscard]] std::size_t GetTotal() const
+        {
+            return hotBytes + conditionBytes + definitionBytes + cooldownBytes + spEffectBytes + chainBytes
+                + objectBytes;
+        }
+    };
+
+    /// @brief All swap triggers, sorted by slot, stored as parallel arrays (structure of arrays) with a single
+    /// evaluation kernel.
+    ///
+    /// @details Evaluation only touches the hot arrays: ParamID ranges (scanned with SIMD, see `FindParamIDMatch()`),
+    /// then SpEffect IDs, flags and cooldowns of matching triggers. Full configs are cold data for logging, stored
+    /// once per distinct trigger and shared by every slot instance (and duplicate entry) of it.
+    /// Triggers are addressed by index; slot N owns indices `[start[N], start[N + 1])`, sorted by descending
+    /// `SwapTriggerConfig::priority` (then config order), which is the order the first match is searched in.
+    ///
+    /// Swap chains (`SwapChainConfig`) are compiled into a per-slot transition table (sorted by source ID) with every
+    /// chain-less hop already followed, and evaluated if none of the slot's triggers fired, at most one step per update.
+    ///
+    /// Trigger conditions (`SwapTriggerConfig::condition`) are compiled once per trigger instance into one flat bytecode
+    /// array, and only run for a trigger that passed every other check. Instances of the same trigger in the same slot
+    /// share their code.
+    ///
+    /// Only rules with a SpEffect can go on cooldown, so only they get cooldown timers (one per player).
+    class TriggerTable
+    {
+    public:
+        TriggerTable() = default;
+
+        /// @brief Build from every trigger category in `config`. Each trigger is copied into every slot that its
+        /// category covers. Within a slot, triggers keep their config order. Cooldowns run on `clock`.
+        explicit TriggerTable(const EquipmentSwapConfig& config, const TimerClock& clock = SteadyTimerClock::Get());
+
+        /// @brief Get the total number of triggers (over all slots).
+        [[nodiscard]] std::uint32_t GetCount() const { return static_cast<std::uint32_t>(m_definitionIndices.size()); }
+
+        /// @brief Get the number of distinct trigger configs that the triggers were built from.
+        [[nodiscard]] std::uint32_t GetDefinitionCount() const
+        {
+            return static_cast<std::uint32_t>(m_definitions.size());
+        }
+
+        /// @brief Get the original config of trigger `index` (cold data, for logging). Its `condition` is empty; the
+        /// table keeps the text with its other strings (see `DescribeRule()`).
+        [[nodiscard]] const SwapTriggerConfig& GetConfig(const std::uint32_t index) const
+        {
+            return m_definitions[m_definitionIndices[index]];
+        }
+
+        /// @brief Get the equipment slot that trigger `index` checks and swaps.
+        [[nodiscard]] EquipSlot GetSlot(std::uint32_t index) const;
+
+        /// @brief Get the cooldown left on trigger `index` for `playerIndex`, in milliseconds.
+        [[nodiscard]] int GetCooldown(const std::uint32_t index, const int playerIndex) const
+        {
+            if (m_cooldownIndices[index] == NO_COOLDOWN)
+                return 0; // no SpEffect, never on cooldown
+            return static_cast<int>(m_cooldowns.GetRemainingMs(GetCooldownKey(index, playerIndex)));
+        }
+
+        /// @brief Get the number of rules (triggers and chains) that have cooldown timers.
+        [[nodiscard]] std::uint32_t GetCooldownRuleCount() const { return m_cooldownRuleCount; }
+
+        /// @brief Get the memory held by this table, by part.
+        [[nodiscard]] TriggerTableMemory GetMemoryUsage() const;
+
+        /// @brief Get the set of slots that have at least one trigger.
+        [[nodiscard]] SlotMask GetTriggeredSlots() const;
+
+        /// @brief Append every SpEffect ID that a trigger, chain or condition reacts to (unsorted, with repeats and
+        /// "no SpEffect" values) to `ids`.
+        void AppendSpEffectIDs(std::vector<int>& ids) const;
+
+        /// @brief Get the set of slots whose ParamID a trigger condition reads (each must be in the snapshot).
+        [[nodiscard]] SlotMask GetConditionSlots() const { return m_conditionSlots; }
+
+        /// @brief Get the number of swap chain instances (one per chain per slot).
+        [[nodiscard]] std::uint32_t GetChainCount() const
+        {
+            return static_cast<std::uint32_t>(m_chainConfigIndices.size());
+        }
+
+        /// @brief Describe the trigger or chain behind a `PendingSwap::ruleIndex`, for logging.
+        [[nodiscard]] std::string DescribeRule(std::uint32_t ruleIndex) const;
+
+        /// @brief True if swaps made by `PendingSwap::ruleIndex` are permanent (never reverted).
+        [[nodiscard]] bool IsRulePermanent(std::uint32_t ruleIndex) const;
+
+        /// @brief Get how long a temporary swap made by `PendingSwap::ruleIndex` lasts, in milliseconds (0 == until
+        /// it is reverted for another reason).
+        [[nodiscard]] int GetRuleDurationMs(std::uint32_t ruleIndex) const;
+
+        /// @brief Get the SpEffect ID to rule index (trigger or `GetCount()` + chain) hash built at construction.
+        [[nodiscard]] const SpEffectHash& GetSpEffectHash() const { return m_spEffectHash; }
+
+        /// @brief Get the SpEffect ID of the trigger or chain behind a `PendingSwap::ruleIndex` (0 or less == none).
+        [[nodiscard]] std::int32_t GetRuleSpEffectID(std::uint32_t ruleIndex) const;
+
+        /// @brief End every trigger and chain cooldown that has run out (by the clock given at construction).
+        void ExpireCooldowns() { m_cooldowns.Advance(m_expiredCooldowns); }
+
+        /// @brief End the cooldown that `Evaluate()` started for `PendingSwap::ruleIndex` and `playerIndex`, e.g.
+        /// because its swap was not written, so the rule can fire again on the next update.
+        void CancelCooldown(std::uint32_t ruleIndex, int playerIndex);
+
+        /// @brief Enable or disable all triggers and chains in `group`. Returns the number changed.
+        int SetGroupEnabled(int group, bool enabled);
+
+        /// @brief Check the enabled triggers of every slot against `snapshot` and append the resulting swaps to `swaps`
+        /// (cleared first), in slot order. At most one swap per slot: the first trigger that fires wins, and the rest
+        /// of the slot's triggers (and its chains) are not evaluated.
+        ///
+        /// @details SpEffect triggers only fire for the current weapon of a hand (and any armor/ring slot), and then go
+        /// on cooldown for `playerIndex`. Each swap updates `snapshot`, exactly as if the new param ID had been read
+        /// back from the game. Active SpEffects are resolved to triggers once, through the perfect hash, rather than
+        /// searched for each SpEffect trigger. Conditions check `snapshot.heldSpEffects` if it is set, and
+        /// `snapshot.activeSpEffects` otherwise.
+        void Evaluate(int playerIndex, PlayerSnapshot& snapshot, int cooldownMs, std::vector<PendingSwap>& swaps);
+
+    private:
+        // Bits of `m_flags`.
+        static constexpr std::uint8_t FLAG_ABSOLUTE_TARGET = 1 << 0;
+        static constexpr std::uint8_t FLAG_DISABLED = 1 << 1;
+        static constexpr std::uint8_t FLAG_CONDITION = 1 << 2; // has a condition that is not always true
+
+        // Hot data, one entry per trigger. A trigger without a ParamID condition has the range [INT32_MIN, INT32_MAX].
+        std::vector<std::int32_t> m_minParamIDs;
+        std::vector<std::int32_t> m_maxParamIDs;
+        std::vector<std::int32_t> m_spEffectIDs; // 0 or less == no SpEffect condition
+        std::vector<std::int32_t> m_targetParamIDs;
+        std::vector<std::uint8_t> m_flags;
+
+        // Compiled conditions. A trigger with `FLAG_CONDITION` runs the code starting at its `m_conditionStarts` entry.
+        std::vector<std::uint32_t> m_conditionStarts;
+        std::vector<ConditionInstruction> m_conditionCode;
+        std::vector<std::int32_t> m_conditionSpEffectIDs; // dense index -> SpEffect ID, shared by all conditions
+        std::vector<std::pair<std::int32_t, std::uint32_t>> m_conditionSpEffectLookup; // (ID, dense index), sorted
+        std::vector<std::uint8_t> m_conditionSpEffectActive; // by dense index; set and cleared by `Evaluate()`
+        SlotMask m_conditionSlots;
+
+        // Cold data. Each distinct trigger config is stored once; every instance points to its definition.
+        std::vector<std::uint32_t> m_definitionIndices; // into `m_definitions`
+        std::vector<SwapTriggerConfig> m_definitions;
+
+        // Trigger conditions and chain categories, moved out of `m_definitions` and `m_chainConfigs` once built, so
+        // their memory is the table's own and counted exactly. Text `i` (definitions, then chain configs) is
+        // `m_texts[m_textStarts[i]]` up to the next start.
+        std::vector<char> m_texts;
+        std::vector<std::uint32_t> m_textStarts;
+
+        SpEffectHash m_spEffectHash; // SpEffect ID -> trigger indices (unused in embedded-config builds)
+
+        // One hop of a swap chain instance: `fromParamID` is swapped to `toParamID`.
+        struct ChainTransition
+        {
+            std::int32_t fromParamID;
+            std::int32_t toParamID;
+            std::uint32_t chainIndex;
+        };
+
+        // Swap chain instances (one per chain per slot of its category).
+        std::vector<std::int32_t> m_chainSpEffectIDs; // 0 or less == no SpEffect condition
+        std::vector<std::uint8_t> m_chainFlags;       // `FLAG_DISABLED` only
+        std::vector<std::uint32_t> m_chainConfigIndices; // into `m_chainConfigs`
+        std::vector<SwapChainConfig> m_chainConfigs;     // cold: `config.swapChains`
+        std::vector<ChainTransition> m_chainTransitions; // sorted by slot, then `fromParamID`
+        std::array<std::uint32_t, EQUIP_SLOT_COUNT + 1> m_chainSlotStarts = {};
+
+        // Rules (triggers, then chains) whose SpEffect is active for the player being evaluated. Set and cleared by
+        // `Evaluate()`.
+        std::vector<std::uint8_t> m_spEffectActive;
+        std::vector<std::uint32_t> m_spEffectActiveIndices;
+
+        /// @brief Get the rule indices of all triggers and chains with SpEffect `spEffectID`.
+        [[nodiscard]] std::span<const std::uint32_t> FindSpEffectTriggers(std::int32_t spEffectID) const;
+
+        std::array<std::uint32_t, EQUIP_SLOT_COUNT + 1> m_slotStarts = {}; // slot N is [start[N], start[N + 1])
+
+        // SpEffect cooldowns of every rule with a SpEffect, for every player. A running timer is a cooldown. Rules
+        // (triggers, then chains) are numbered densely in `m_cooldownIndices`; rules without a SpEffect get none.
+        static constexpr std::uint32_t NO_COOLDOWN = std::numeric_limits<std::uint32_t>::max();
+        std::vector<std::uint32_t> m_cooldownIndices; // by rule index
+        std::uint32_t m_cooldownRuleCount = 0;
+        TimerWheel m_cooldowns;
+        std::vector<std::uint32_t> m_expiredCooldowns; // reused by `ExpireCooldowns()`
+
+        /// @brief Get the timer of rule `ruleIndex` for `playerIndex`. The rule must have a SpEffect.
+        [[nodiscard]] std::uint32_t GetCooldownKey(const std::uint32_t ruleIndex, const int playerIndex) const
+        {
+            return m_cooldownIndices[ruleIndex] * DSR_MAX_PLAYERS + static_cast<std::uint32_t>(playerIndex);
+        }
+
+        /// @brief Put rule `ruleIndex` on cooldown for `playerIndex` (no cooldown if `cooldownMs` is 0).
+        void StartCooldown(std::uint32_t ruleIndex, int playerIndex, int cooldownMs);
+
+        static constexpr std::uint32_t NO_INSTANCE = std::numeric_limits<std::uint32_t>::max();
+
+        /// @brief Append an instance of definition `definitionIndex` for `slot`. `slotInstances` holds the last
+        /// instance of each definition in this slot (`NO_INSTANCE` if none), whose compiled condition is reused.
+        void Append(std::uint32_t definitionIndex, EquipSlot slot, std::vector<std::uint32_t>& slotInstances);
+
+        /// @brief Compile the condition of the trigger being appended for `slot`. Returns true if it needs to run.
+        bool AppendCondition(const SwapTriggerConfig& config, EquipSlot slot);
+
+        /// @brief Add every chain of `config` that applies to `slot`, with its transitions.
+        void AppendChains(const EquipmentSwapConfig& config, EquipSlot slot);
+
+        /// @brief Move the condition and category strings of `m_definitions` and `m_chainConfigs` into `m_texts`.
+        void MoveTexts();
+
+        /// @brief Get text `textIndex` of `m_texts`.
+        [[nodiscard]] std::string_view GetText(std::size_t textIndex) const
+        {
+            return {m_texts.data() + m_textStarts[textIndex], m_textStarts[textIndex + 1] - m_textStarts[textIndex]};
+        }
+
+        /// @brief Try the chain transitions of `slot` for the slot's current ID. Returns true if one was taken.
+        bool EvaluateChains(
+            int playerIndex, EquipSlot slot, PlayerSnapshot& snapshot, int cooldownMs, std::vector<PendingSwap>& swaps);
+    };
+} // namespace DSREquipmentSwap
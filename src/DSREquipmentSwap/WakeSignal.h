@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace DSREquipmentSwap
+{
+    /// @brief Auto-reset signal that lets producers wake a sleeping consumer thread early.
+    ///
+    /// @details `Notify()` only touches the mutex when the consumer is actually waiting, so producers on game threads
+    /// normally pay for two atomic operations and nothing more.
+    class WakeSignal
+    {
+    public:
+        /// @brief Wake the waiting thread (or make its next wait return immediately).
+        void Notify()
+        {
+            m_pending.store(true);
+            if (m_waiting.load())
+            {
+                // Taking the mutex guarantees the waiter is either before its predicate check or blocked in `wait`.
+                std::lock_guard lock(m_mutex);
+            }
+            m_condition.notify_all();
+        }
+
+        /// @brief Block for up to `timeout` or until notified. Returns true if notified (and clears the signal).
+        bool WaitFor(const std::chrono::milliseconds timeout)
+        {
+            std::unique_lock lock(m_mutex);
+            m_waiting.store(true);
+            const bool notified = m_condition.wait_for(lock, timeout, [this] { return m_pending.exchange(false); });
+            m_waiting.store(false);
+            return notified;
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::atomic<bool> m_pending = false;
+        std::atomic<bool> m_waiting = false;
+    };
+} // namespace DSREquipmentSwap
@@ -1,10 +1,25 @@
-﻿#include <DSREquipmentSwap/Config.h>
+﻿#include <DSREquipmentSwap/Bootstrap.h>
+#include <DSREquipmentSwap/Config.h>
+#ifdef DSR_EQUIPMENT_SWAP_EMBEDDED
+#include <DSREquipmentSwap/EmbeddedConfig.h>
+#endif
 #include <DSREquipmentSwap/EquipmentSwapper.h>
+#include <DSREquipmentSwap/FrameSource.h>
+#include <DSREquipmentSwap/SpEffectEvents.h>
 
 #include <Firelink/Logging.h>
 
+#include <chrono>
+#include <format>
+#include <memory>
+
+using DSREquipmentSwap::Bootstrap;
 using DSREquipmentSwap::EquipmentSwapConfig;
 using DSREquipmentSwap::EquipmentSwapper;
+using DSREquipmentSwap::ExternalFrameSource;
+using DSREquipmentSwap::ExternalSpEffectEventSource;
+using DSREquipmentSwap::SwapperCommand;
+using DSREquipmentSwap::SwapperCommandType;
 using std::filesystem::path;
 
 namespace
@@ -12,11 +27,56 @@ namespace
     const path JSON_CONFIG_PATH = "DSREquipmentSwap.json";
     const path LOG_PATH = "DSREquipmentSwap.log";
 
-    std::unique_ptr<EquipmentSwapper> equipmentSwapper;
+    std::unique_ptr<EquipmentSwapper> equipmentSwapper; // created by the bootstrap thread; use only if ready
+    Bootstrap bootstrap; // declared last, so its thread is stopped before the swapper is destroyed
+
+    /// @brief First bootstrap step: everything that used to run in `DllMain`, now off the loader lock.
+    bool InitializeSwapper()
+    {
+        Firelink::Info("DSREquipmentSwap DLL loaded. Creating 'DSREquipmentSwap.log' file.");
+
+        // Set log file to `DSREquipmentSwap.log`.
+        Firelink::SetLogFile(LOG_PATH);
+
+        Firelink::Info("DSREquipmentSwap DLL loaded. Starting weapon swap trigger monitor.");
+
+        EquipmentSwapConfig config;
+#ifdef DSR_EQUIPMENT_SWAP_EMBEDDED
+        // Fixed trigger set compiled into this build; there is no JSON file to read.
+        DSREquipmentSwap::LoadEmbeddedConfig(config);
+        EquipmentSwapper::LogConfig(config, "embedded config");
+#else
+        if (!EquipmentSwapper::LoadConfig(JSON_CONFIG_PATH, config))
+        {
+            Firelink::Error("Failed to load configuration. Exiting...");
+            return false;
+        }
+#endif
+        equipmentSwapper = std::make_unique<EquipmentSwapper>(config);
+        // Only used if `eventDrivenSpEffects` is enabled; fed by `DSREquipmentSwap_PushSpEffectApplied()`.
+        equipmentSwapper->SetSpEffectEventSource(std::make_unique<ExternalSpEffectEventSource>());
+        // Only used if `frameHookMode` is enabled; fed by `DSREquipmentSwap_OnFrame()`.
+        equipmentSwapper->SetFrameSource(std::make_unique<ExternalFrameSource>());
+        equipmentSwapper->SetFirstTickCallback(
+            []
+            {
+                bootstrap.MarkFirstTick();
+                Firelink::Info(
+                    std::format(
+                        "First swapper update {:.1f} ms after DLL attach (config load and setup: {:.1f} ms).",
+                        bootstrap.GetTimeToFirstTick().value_or(std::chrono::microseconds(0)).count() / 1000.0,
+                        bootstrap.GetInitializeDuration().value_or(std::chrono::microseconds(0)).count() / 1000.0));
+            });
+        return true;
+    }
 } // namespace
 
-/// @brief Entry point for the DLL. Starts `EquipmentSwapper` main loop in a thread until library is unloaded.
-BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserved)
+/// @brief Entry point for the DLL. Pins the module and starts the bootstrap thread, which loads the config and then runs
+/// the `EquipmentSwapper` main loop for the rest of the process. Nothing else is done under the loader lock.
+///
+/// @details The module is pinned because it can never be unloaded safely: its threads would have to be stopped and
+/// joined on detach, under the loader lock, which deadlocks as soon as one of them needs the lock (e.g. to exit).
+BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID /*lpReserved*/)
 {
     switch (ul_reason_for_call)
     {
@@ -24,43 +84,71 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         {
             DisableThreadLibraryCalls(hModule);
 
-            if (equipmentSwapper != nullptr)
+            // `FreeLibrary()` becomes a no-op, so the only detach left is the process exiting.
+            HMODULE pinnedModule = nullptr;
+            if (!GetModuleHandleExW(
+                    GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_PIN,
+                    reinterpret_cast<LPCWSTR>(&DllMain),
+                    &pinnedModule))
             {
-                Firelink::Warning("DSREquipmentSwap DLL main loop has already started. Exiting...");
-                break;
+                Firelink::Error("Failed to pin DSREquipmentSwap DLL. Not loading, as it could not be unloaded safely.");
+                return FALSE;
             }
 
-            Firelink::Info("DSREquipmentSwap DLL loaded. Creating 'DSREquipmentSwap.log' file.");
-
-            // Set log file to `DSREquipmentSwap.log`.
-            Firelink::SetLogFile(LOG_PATH);
-
-            Firelink::Info("DSREquipmentSwap DLL loaded. Starting weapon swap trigger monitor.");
-
-            EquipmentSwapConfig config;
-            if (!EquipmentSwapper::LoadConfig(JSON_CONFIG_PATH, config))
-            {
-                Firelink::Error("Failed to load configuration. Exiting...");
-                return FALSE; // Exit if config loading failed.
-            }
-            equipmentSwapper = std::make_unique<EquipmentSwapper>(config);
-            equipmentSwapper->StartThreaded();
+            const bool started = bootstrap.Start(
+                {
+                    InitializeSwapper,
+                    [] { equipmentSwapper->Run(); },
+                    [] { equipmentSwapper->RequestStop(); },
+                });
+            if (!started)
+                Firelink::Warning("DSREquipmentSwap DLL main loop has already started. Exiting...");
             break;
         }
 
         case DLL_PROCESS_DETACH:
-        {
-            // DLL is being unloaded. Stop swap thread.
-            if (equipmentSwapper != nullptr)
-            {
-                Firelink::Info("DSREquipmentSwap DLL unloading. Stopping weapon swap trigger monitor.");
-                equipmentSwapper->StopThreaded();
-            }
+            // The module is pinned, so this is the process exiting: every other thread is already gone, and there is
+            // nothing to stop (destroying `bootstrap` only joins a thread that has ended). Never wait on a running
+            // thread here, under the loader lock.
             break;
-        }
 
         default:
             break;
     }
     return TRUE;
 }
+
+/// @brief Exported entry point for other mods to check whether the swapper is ready (see `BootstrapState` for values).
+/// Commands posted before it is ready (state 2, running) are rejected.
+extern "C" __declspec(dllexport) int DSREquipmentSwap_GetState()
+{
+    return static_cast<int>(bootstrap.GetState());
+}
+
+/// @brief Exported entry point for a detour on the game's SpEffect-apply routine (or another mod that already has one)
+/// to report that `spEffectID` was applied to the player in ChrSlot `playerIndex`. Lock-free and non-blocking, so it
+/// is safe to call from the game thread. Returns false if no event-driven swapper is listening.
+extern "C" __declspec(dllexport) bool DSREquipmentSwap_PushSpEffectApplied(const int playerIndex, const int spEffectID)
+{
+    return ExternalSpEffectEventSource::PushSpEffectApplied(playerIndex, spEffectID);
+}
+
+/// @brief Exported entry point for a detour on the game's main update (or another mod that already has one) to call once
+/// per frame, on the game thread. In frame-hook mode, runs one swap update there (never blocking; the update is skipped
+/// if the swapper thread is busy). Returns false if no frame-hook swapper is listening.
+extern "C" __declspec(dllexport) bool DSREquipmentSwap_OnFrame()
+{
+    return ExternalFrameSource::NotifyFrame();
+}
+
+/// @brief Exported entry point for other mods to control the running swapper (see `SwapperCommandType` for values).
+/// Safe to call from any thread. Returns false if the swapper is not running, the command type is unknown, or the
+/// command queue is full.
+extern "C" __declspec(dllexport) bool DSREquipmentSwap_PostCommand(const int commandType, const int value)
+{
+    if (!bootstrap.IsReady())
+        return false;
+    if (commandType < 0 || commandType > static_cast<int>(SwapperCommandType::DISABLE_TRIGGER_GROUP))
+        return false;
+    return equipmentSwapper->PostCommand(SwapperCommand{static_cast<SwapperCommandType>(commandType), value});
+}
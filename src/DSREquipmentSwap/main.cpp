@@ -1,5 +1,9 @@
 ﻿#include <DSREquipmentSwap/Config.h>
+#ifdef DSR_EQUIPMENT_SWAP_EMBEDDED
+#include <DSREquipmentSwap/EmbeddedConfig.h>
+#endif
 #include <DSREquipmentSwap/EquipmentSwapper.h>
+#include <DSREquipmentSwap/MultiProcessSwapper.h>
 
 #include <Firelink/Logging.h>
 
@@ -7,6 +11,7 @@
 
 using DSREquipmentSwap::EquipmentSwapConfig;
 using DSREquipmentSwap::EquipmentSwapper;
+using DSREquipmentSwap::MultiProcessSwapper;
 using std::filesystem::path;
 
 namespace
@@ -25,11 +30,25 @@ int main()
     Firelink::Info("DSREquipmentSwap EXE started. Starting weapon swap trigger monitor.");
 
     EquipmentSwapConfig config;
+#ifdef DSR_EQUIPMENT_SWAP_EMBEDDED
+    // Fixed trigger set compiled into this build; there is no JSON file to read.
+    DSREquipmentSwap::LoadEmbeddedConfig(config);
+    EquipmentSwapper::LogConfig(config, "embedded config");
+#else
     if (!EquipmentSwapper::LoadConfig(JSON_CONFIG_PATH, config))
     {
         Firelink::Error("Failed to load configuration. Exiting...");
         return -1;
     }
+#endif
+
+    if (config.hookConfig.maxProcesses > 1)
+    {
+        // Several game instances (e.g. a test rig): one swapper each, all updated by a shared worker pool.
+        const auto swapper = std::make_unique<MultiProcessSwapper>(config);
+        swapper->Run();
+        return 0;
+    }
 
     // In this executable version, we don't need a thread. We block forever here (unless the process search times out).
     const auto swapper = std::make_unique<EquipmentSwapper>(config);
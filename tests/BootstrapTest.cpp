@@ -0,0 +1,176 @@
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/Bootstrap.h>
+
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <stdexcept>
+#include <thread>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    /// @brief Steps that record what the bootstrap called. `run` blocks until `requestStop`.
+    struct RecordingSteps
+    {
+        std::atomic<int> initializeCount = 0;
+        std::atomic<int> runCount = 0;
+        std::atomic<int> requestStopCount = 0;
+        std::atomic<bool> isStopRequested = false;
+
+        Bootstrap::Steps Get(const bool isInitialized = true)
+        {
+            return {
+                [this, isInitialized]
+                {
+                    ++initializeCount;
+                    return isInitialized;
+                },
+                [this]
+                {
+                    ++runCount;
+                    while (!isStopRequested.load())
+                        std::this_thread::sleep_for(std::chrono::microseconds(100));
+                },
+                [this]
+                {
+                    ++requestStopCount;
+                    isStopRequested = true;
+                },
+            };
+        }
+    };
+
+    void WaitForState(const Bootstrap& bootstrap, const BootstrapState state)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (bootstrap.GetState() != state && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+        CHECK(bootstrap.GetState() == state);
+    }
+
+    void TestStartAndStop()
+    {
+        RecordingSteps steps;
+        Bootstrap bootstrap;
+        CHECK(bootstrap.GetState() == BootstrapState::NOT_STARTED && !bootstrap.IsReady());
+        CHECK(!bootstrap.GetInitializeDuration() && !bootstrap.GetTimeToFirstTick());
+
+        CHECK(bootstrap.Start(steps.Get()));
+        CHECK(!bootstrap.Start(steps.Get())); // at most once
+        WaitForState(bootstrap, BootstrapState::RUNNING);
+        CHECK(bootstrap.IsReady() && bootstrap.GetInitializeDuration().has_value());
+
+        bootstrap.MarkFirstTick();
+        const auto timeToFirstTick = bootstrap.GetTimeToFirstTick();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        bootstrap.MarkFirstTick(); // only the first one counts
+        CHECK(timeToFirstTick && bootstrap.GetTimeToFirstTick() == timeToFirstTick);
+
+        bootstrap.Stop();
+        CHECK(bootstrap.GetState() == BootstrapState::STOPPED && !bootstrap.IsReady());
+        bootstrap.Stop(); // again: no-op
+        CHECK(steps.initializeCount == 1 && steps.runCount == 1 && steps.requestStopCount == 1);
+        CHECK(!bootstrap.Start(steps.Get()));
+    }
+
+    void TestStopBeforeStart()
+    {
+        RecordingSteps steps;
+        Bootstrap bootstrap;
+        bootstrap.Stop();
+        CHECK(bootstrap.GetState() == BootstrapState::STOPPED);
+        CHECK(!bootstrap.Start(steps.Get()));
+        CHECK(bootstrap.GetState() == BootstrapState::STOPPED);
+        CHECK(steps.initializeCount == 0 && steps.runCount == 0 && steps.requestStopCount == 0);
+    }
+
+    /// @brief `Stop()` while initializing waits for the initialization, never enters `run`, and keeps `Start()` out.
+    void TestStopDuringInitialize()
+    {
+        std::latch isInitializing(1);
+        std::latch canFinishInitialize(1);
+        std::atomic<bool> isRunEntered = false;
+        Bootstrap bootstrap;
+        bootstrap.Start({
+            [&]
+            {
+                isInitializing.count_down();
+                canFinishInitialize.wait();
+                return true;
+            },
+            [&] { isRunEntered = true; },
+            [] {},
+        });
+        isInitializing.wait();
+        CHECK(bootstrap.GetState() == BootstrapState::INITIALIZING && !bootstrap.IsReady());
+
+        std::atomic<bool> isStopped = false;
+        std::thread stopThread(
+            [&]
+            {
+                bootstrap.Stop();
+                isStopped = true;
+            });
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        CHECK(!isStopped); // waiting for the initialization
+        CHECK(!bootstrap.Start({[] { return true; }, [] {}, [] {}})); // start during stop
+
+        canFinishInitialize.count_down();
+        stopThread.join();
+        CHECK(bootstrap.GetState() == BootstrapState::STOPPED && !isRunEntered);
+        CHECK(bootstrap.GetInitializeDuration() >= std::chrono::milliseconds(5));
+    }
+
+    void TestFailedInitialize()
+    {
+        {
+            RecordingSteps steps;
+            Bootstrap bootstrap;
+            bootstrap.Start(steps.Get(false));
+            WaitForState(bootstrap, BootstrapState::FAILED);
+            bootstrap.Stop(); // joins; still failed
+            CHECK(bootstrap.GetState() == BootstrapState::FAILED && !bootstrap.IsReady());
+            CHECK(steps.runCount == 0 && steps.requestStopCount == 0);
+            CHECK(bootstrap.GetInitializeDuration().has_value());
+        }
+        {
+            // An exception must not escape the thread.
+            Bootstrap bootstrap;
+            bootstrap.Start({[]() -> bool { throw std::runtime_error("no config"); }, [] {}, [] {}});
+            WaitForState(bootstrap, BootstrapState::FAILED);
+        }
+        {
+            // Neither may one from the swapper loop, which means nothing is running any more.
+            Bootstrap bootstrap;
+            bootstrap.Start({[] { return true; }, [] { throw std::runtime_error("lost hook"); }, [] {}});
+            WaitForState(bootstrap, BootstrapState::FAILED);
+            bootstrap.Stop();
+            CHECK(bootstrap.GetState() == BootstrapState::FAILED);
+        }
+    }
+
+    void TestDestructorStops()
+    {
+        RecordingSteps steps;
+        {
+            Bootstrap bootstrap;
+            bootstrap.Start(steps.Get());
+            WaitForState(bootstrap, BootstrapState::RUNNING);
+        }
+        CHECK(steps.requestStopCount == 1 && steps.isStopRequested);
+    }
+} // namespace
+
+int main()
+{
+    TestStartAndStop();
+    TestStopBeforeStart();
+    TestStopDuringInitialize();
+    TestFailedInitialize();
+    TestDestructorStops();
+    return Finish("BootstrapTest");
+}
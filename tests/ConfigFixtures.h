@@ -0,0 +1,115 @@
+#pragma once
+
+#include <DSREquipmentSwap/Config.h>
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <format>
+#include <istream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace DSREquipmentSwap::Testing
+{
+    /// @brief Read `config` the way configs were read before `ReadConfig()`: parse the whole document, convert it, and
+    /// drop invalid triggers, chains and loadouts. The reference `ReadConfig()` must agree with.
+    inline bool ReadConfigDocument(std::istream& input, EquipmentSwapConfig& config, std::string& error)
+    {
+        try
+        {
+            from_json(nlohmann::json::parse(input), config);
+        }
+        catch (const nlohmann::json::exception& e)
+        {
+            error = e.what();
+            return false;
+        }
+        for (const TriggerCategory& category : TRIGGER_CATEGORIES)
+        {
+            std::erase_if(
+                config.*category.triggers,
+                [&category](const SwapTriggerConfig& trigger) { return !trigger.Validate(std::string(category.name)); });
+        }
+        std::erase_if(config.swapChains, [](const SwapChainConfig& chain) { return !chain.Validate(); });
+        std::erase_if(config.loadouts, [](const LoadoutConfig& loadout) { return !loadout.Validate(); });
+        return true;
+    }
+
+    /// @brief JSON of a generated config with `triggersPerList` triggers in every trigger list, as a tool would write
+    /// it: every field of most entries, conditions on some, keys this version does not know, and a few invalid
+    /// triggers (2%), chains and loadouts (1%). The same `seed` gives the same text.
+    inline std::string MakeLargeConfigJson(const int triggersPerList, const std::uint32_t seed = 1)
+    {
+        std::mt19937 random(seed);
+        std::string json = R"({
+  "generator": {"name": "test", "version": [1, 2, {"build": null}]},
+  "hookConfig": {"monitorIntervalMs": 16, "maxProcesses": 2, "unknownSetting": true},
+)";
+        for (const TriggerCategory& category : TRIGGER_CATEGORIES)
+        {
+            json += std::format("  \"{}\": [\n", category.name);
+            for (int i = 0; i < triggersPerList; ++i)
+            {
+                const int kind = static_cast<int>(random() % 100);
+                const int paramID = 100000 + static_cast<int>(random() % 900) * 1000;
+                const int spEffectID = kind < 40 ? 2000 + static_cast<int>(random() % 500) : -1;
+                json += std::format(
+                    "    {{\"spEffectIDTrigger\": {}, \"paramIDTrigger\": {}, \"maxParamIDTrigger\": {}, "
+                    "\"targetParamID\": {}, \"isTargetIDAbsolute\": {}, \"isPermanent\": {}, \"group\": {}, "
+                    "\"priority\": {}, \"durationMs\": {}",
+                    kind == 0 ? -1 : spEffectID,
+                    kind == 0 ? -1 : paramID, // neither trigger set: invalid
+                    kind < 10 ? paramID + 99 : -1,
+                    100 + static_cast<int>(random() % 4) * 100,
+                    kind % 7 == 0 ? "true" : "false",
+                    kind % 5 == 0 ? "true" : "false",
+                    static_cast<int>(random() % 4),
+                    static_cast<int>(random() % 3),
+                    kind % 5 != 0 && kind % 3 == 0 ? 500 : 0);
+                if (kind >= 90)
+                    json += R"(, "condition": "spEffect(2100) && param(rightPrimaryWeapon) >= 300000")";
+                else if (kind == 89)
+                    json += R"(, "condition": "id >")"; // invalid
+                if (kind % 11 == 0)
+                    json += R"(, "comment": "from a newer version", "tags": ["a", {"b": [1, 2]}])";
+                json += i + 1 < triggersPerList ? "},\n" : "}\n";
+            }
+            json += "  ],\n";
+        }
+
+        const int chainCount = triggersPerList / 10 + 1;
+        json += "  \"swapChains\": [\n";
+        for (int i = 0; i < chainCount; ++i)
+        {
+            const int kind = static_cast<int>(random() % 100);
+            json += std::format(
+                "    {{\"category\": \"{}\", \"spEffectIDTrigger\": {}, \"paramIDs\": [{}, {}, {}], "
+                "\"isCycle\": {}}}{}\n",
+                kind == 0 ? "noSuchTriggers" : TRIGGER_CATEGORIES[i % TRIGGER_CATEGORIES.size()].name,
+                3000 + i,
+                200000 + i * 1000,
+                201000 + i * 1000,
+                202000 + i * 1000,
+                kind % 2 == 0 ? "true" : "false",
+                i + 1 < chainCount ? "," : "");
+        }
+        json += "  ],\n  \"loadouts\": [\n";
+        for (int i = 0; i < chainCount; ++i)
+        {
+            const int kind = static_cast<int>(random() % 100);
+            json += std::format(
+                "    {{\"name\": \"Loadout {}\", \"spEffectIDTrigger\": {}, \"targets\": "
+                "[{{\"slot\": \"{}\", \"paramID\": {}}}, {{\"slot\": \"ring1\", \"paramID\": {}}}]}}{}\n",
+                i,
+                4000 + i,
+                kind == 0 ? "noSuchSlot" : "headArmor",
+                300000 + i,
+                400000 + i,
+                i + 1 < chainCount ? "," : "");
+        }
+        json += "  ]\n}\n";
+        return json;
+    }
+} // namespace DSREquipmentSwap::Testing
@@ -0,0 +1,117 @@
+#include "ConfigFixtures.h"
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/ConfigReader.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    enum class Reader
+    {
+        NONE, // only opens the file: the baseline peak memory of a child
+        EVENTS,
+        DOCUMENT,
+    };
+
+    struct LoadResult
+    {
+        bool isLoaded = false;
+        std::size_t triggerCount = 0;
+        double loadMs = 0.0;
+        long maxResidentKiB = 0;
+    };
+
+    /// @brief Load `path` with `reader` in a child process, so its peak memory is that of this load alone.
+    LoadResult LoadInChild(const std::filesystem::path& path, const Reader reader)
+    {
+        int pipeFDs[2];
+        if (pipe(pipeFDs) != 0)
+            return {};
+        const pid_t processID = fork();
+        if (processID == 0)
+        {
+            close(pipeFDs[0]);
+            LoadResult result;
+            const auto start = std::chrono::steady_clock::now();
+            std::ifstream input(path, std::ios::binary);
+            EquipmentSwapConfig config;
+            std::string error;
+            if (reader == Reader::EVENTS)
+            {
+                ConfigReadStats stats;
+                result.isLoaded = ReadConfig(input, config, stats, error);
+            }
+            else if (reader == Reader::DOCUMENT)
+            {
+                result.isLoaded = ReadConfigDocument(input, config, error);
+            }
+            else
+            {
+                result.isLoaded = input.is_open();
+            }
+            result.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            for (const TriggerCategory& category : TRIGGER_CATEGORIES)
+                result.triggerCount += (config.*category.triggers).size();
+            const bool isWritten = write(pipeFDs[1], &result, sizeof(result)) == sizeof(result);
+            _exit(isWritten ? 0 : 1);
+        }
+        close(pipeFDs[1]);
+        LoadResult result;
+        if (processID < 0 || read(pipeFDs[0], &result, sizeof(result)) != sizeof(result))
+            result = {};
+        close(pipeFDs[0]);
+
+        rusage usage = {};
+        int status = 0;
+        if (processID > 0 && wait4(processID, &status, 0, &usage) == processID && status == 0)
+            result.maxResidentKiB = usage.ru_maxrss; // KiB on Linux
+        return result;
+    }
+} // namespace
+
+/// @brief Load time and peak memory of generated configs of about 1 to 60 MiB, read event by event with `ReadConfig()`
+/// and as a whole document (how configs were read before). Peak memory is the child's that loads the config, less
+/// that of a child that only opens it. Not a pass/fail threshold; it only fails if a config does not load, or the two
+/// readers load different numbers of triggers.
+int main()
+{
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / ("DSREquipmentSwapConfigReaderBenchmark" + std::to_string(getpid()));
+    std::printf("Config size: events load time, peak memory; document load time, peak memory\n");
+    for (const int triggersPerList : {500, 5000, 40000})
+    {
+        {
+            std::ofstream output(path, std::ios::binary);
+            output << MakeLargeConfigJson(triggersPerList);
+        }
+        const double sizeMiB = static_cast<double>(std::filesystem::file_size(path)) / (1024 * 1024);
+
+        const LoadResult baseline = LoadInChild(path, Reader::NONE);
+        const LoadResult events = LoadInChild(path, Reader::EVENTS);
+        const LoadResult document = LoadInChild(path, Reader::DOCUMENT);
+        CHECK(baseline.isLoaded && events.isLoaded && document.isLoaded);
+        CHECK(events.triggerCount > 0 && events.triggerCount == document.triggerCount);
+        std::printf(
+            "%5.1f MiB: %7.1f ms, %7.1f MiB; %7.1f ms, %7.1f MiB\n",
+            sizeMiB,
+            events.loadMs,
+            static_cast<double>(events.maxResidentKiB - baseline.maxResidentKiB) / 1024,
+            document.loadMs,
+            static_cast<double>(document.maxResidentKiB - baseline.maxResidentKiB) / 1024);
+    }
+    std::filesystem::remove(path);
+    return Finish("ConfigReaderBenchmark");
+}
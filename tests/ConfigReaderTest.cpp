@@ -0,0 +1,128 @@
+#include "ConfigFixtures.h"
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/ConfigReader.h>
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    std::size_t CountTriggers(const EquipmentSwapConfig& config)
+    {
+        std::size_t count = 0;
+        for (const TriggerCategory& category : TRIGGER_CATEGORIES)
+            count += (config.*category.triggers).size();
+        return count;
+    }
+
+    /// @brief Read `json` with `ReadConfig()` and as a whole document, and check both agree: both fail, or both read
+    /// the same config. Returns whether `ReadConfig()` succeeded.
+    bool CheckReadsSame(const std::string& json, ConfigReadStats& stats)
+    {
+        std::istringstream documentInput(json);
+        EquipmentSwapConfig documentConfig;
+        std::string documentError;
+        const bool isDocumentRead = ReadConfigDocument(documentInput, documentConfig, documentError);
+
+        std::istringstream input(json);
+        EquipmentSwapConfig config;
+        std::string error;
+        const bool isRead = ReadConfig(input, config, stats, error);
+
+        CHECK(isRead == isDocumentRead);
+        CHECK(isRead || !error.empty());
+        if (isRead && isDocumentRead)
+        {
+            CHECK(nlohmann::json(config) == nlohmann::json(documentConfig));
+            CHECK(stats.triggerCount == CountTriggers(documentConfig));
+            CHECK(stats.chainCount == documentConfig.swapChains.size());
+            CHECK(stats.loadoutCount == documentConfig.loadouts.size());
+        }
+        return isRead;
+    }
+
+    void TestLargeConfig()
+    {
+        constexpr int TRIGGERS_PER_LIST = 2000;
+        const std::string json = MakeLargeConfigJson(TRIGGERS_PER_LIST);
+        ConfigReadStats stats;
+        CHECK(CheckReadsSame(json, stats));
+        CHECK(stats.droppedCount > 0); // the generator's invalid entries
+        CHECK(stats.triggerCount + stats.chainCount + stats.loadoutCount + stats.droppedCount
+              == TRIGGER_CATEGORIES.size() * TRIGGERS_PER_LIST + 2 * (TRIGGERS_PER_LIST / 10 + 1));
+
+        // Progress is reported in order, up to the input size.
+        std::istringstream input(json, std::ios::in | std::ios::binary);
+        EquipmentSwapConfig config;
+        std::string error;
+        std::uint64_t lastBytesRead = 0;
+        int progressCount = 0;
+        bool isInOrder = true;
+        CHECK(ReadConfig(input, config, stats, error, [&](const std::uint64_t bytesRead)
+        {
+            isInOrder &= bytesRead >= lastBytesRead && bytesRead <= json.size();
+            lastBytesRead = bytesRead;
+            ++progressCount;
+        }));
+        CHECK(progressCount > 1 && isInOrder);
+    }
+
+    void TestEdgeCases()
+    {
+        const char* const validCases[] = {
+            "{}",
+            R"({"unknown": {"a": [1, {"b": [2]}]}, "headArmorTriggers": [{"paramIDTrigger": 5, "targetParamID": 1}]})",
+            R"({"headArmorTriggers": [{"paramIDTrigger": 5}], "headArmorTriggers": [{"paramIDTrigger": 6}, )"
+            R"({"paramIDTrigger": 7}]})",
+            R"({"hookConfig": {"monitorIntervalMs": 7, "spEffectList": {"headPointerPath": [1, 2]}}, )"
+            R"("ringTriggers": []})",
+            R"({"ringTriggers": [{"spEffectIDTrigger": -1, "paramIDTrigger": -1}, {"paramIDTrigger": 3}]})",
+            R"({"swapChains": [{"category": "nope", "paramIDs": [1, 2]}, )"
+            R"({"category": "ringTriggers", "paramIDs": [1, 2]}]})",
+            R"({"loadouts": [{"name": "x", "spEffectIDTrigger": 5, "targets": [{"slot": "ring0", "paramID": 1}]}, )"
+            R"({"name": "bad"}]})",
+            R"({"leftWeaponTriggers": [{"paramIDTrigger": 5, "condition": "id >"}]})",
+        };
+        for (const char* json : validCases)
+        {
+            ConfigReadStats stats;
+            CHECK(CheckReadsSame(json, stats));
+        }
+
+        const char* const invalidCases[] = {
+            "",
+            "[]",
+            "5",
+            R"({"x": 1)",
+            R"({"a": 1} x)",
+            R"({"leftWeaponTriggers": 5})",
+            R"({"leftWeaponTriggers": {}})",
+            R"({"leftWeaponTriggers": [{"paramIDTrigger": "a"}]})",
+            R"({"hookConfig": null})",
+            R"({"hookConfig": [1]})",
+            R"({"ringTriggers": [{"paramIDTrigger": 3}, 7]})",
+            R"({"ringTriggers": [[1]]})",
+            R"({"ringTriggers": [null]})",
+        };
+        for (const char* json : invalidCases)
+        {
+            ConfigReadStats stats;
+            CHECK(!CheckReadsSame(json, stats));
+        }
+    }
+} // namespace
+
+int main()
+{
+    TestLargeConfig();
+    TestEdgeCases();
+    return Finish("ConfigReaderTest");
+}
@@ -0,0 +1,198 @@
+#include "FakeGame.h"
+
+#include <DSREquipmentSwap/Config.h>
+
+#include <Firelink/Logging.h>
+#include <Firelink/Pointer.h>
+#include <Firelink/Process.h>
+#include <FirelinkDSRHook/DSRHook.h>
+#include <FirelinkDSRHook/DSRPlayer.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+using namespace FirelinkDSR;
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    constexpr int CHR_SLOT_WORDS = 0x38 / 8; // the game's ChrSlot size, with the PlayerIns pointer first
+
+    // Game memory read by `BasePointer::ReadPointer()` and the swapper's memory backend. Laid out again by every
+    // `PlayerIns()` call, so each thread has its own.
+    thread_local std::array<std::uint64_t, 4> g_playerIns = {};
+    thread_local std::array<std::uint64_t, DSR_MAX_PLAYERS * CHR_SLOT_WORDS> g_chrSlots = {};
+    std::array<std::uint64_t, DSR_MAX_PLAYERS> g_connectedPlayerIns = {}; // only their addresses are used
+
+    EquipSlot GetWeaponEquipSlot(const WeaponSlot slot, const bool isLeftHand)
+    {
+        if (isLeftHand)
+            return slot == WeaponSlot::PRIMARY ? EquipSlot::LEFT_PRIMARY : EquipSlot::LEFT_SECONDARY;
+        return slot == WeaponSlot::PRIMARY ? EquipSlot::RIGHT_PRIMARY : EquipSlot::RIGHT_SECONDARY;
+    }
+
+    int ReadFakeSlot(const EquipSlot slot)
+    {
+        std::lock_guard lock(GetFakeGameMutex());
+        FakeGame& game = GetFakeGame();
+        ++game.readCount;
+        if (game.onRead)
+            game.onRead(slot);
+        return game.paramIDs[static_cast<int>(slot)];
+    }
+
+    bool WriteFakeSlot(const EquipSlot slot, const int paramID)
+    {
+        std::lock_guard lock(GetFakeGameMutex());
+        FakeGame& game = GetFakeGame();
+        if (game.isWriteFailing)
+            return false;
+        ++game.writeCount;
+        game.paramIDs[static_cast<int>(slot)] = paramID;
+        if (game.onWrite)
+            game.onWrite(slot);
+        return true;
+    }
+} // namespace
+
+FakeGame& DSREquipmentSwap::Testing::GetFakeGame()
+{
+    static FakeGame game;
+    return game;
+}
+
+std::recursive_mutex& DSREquipmentSwap::Testing::GetFakeGameMutex()
+{
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+
+Firelink::BasePointer Firelink::BasePointer::ReadPointer(const std::string& /* name */, const int offset) const
+{
+    if (IsNull())
+        return {};
+    std::uint64_t pointer = 0;
+    std::memcpy(&pointer, reinterpret_cast<const std::byte*>(m_address) + offset, sizeof(pointer));
+    return BasePointer(static_cast<std::uintptr_t>(pointer));
+}
+
+Firelink::ManagedProcess::ManagedProcess(const unsigned long processID, const HANDLE handle)
+    : m_processID(processID)
+    , m_handle(handle)
+{}
+
+std::unique_ptr<Firelink::ManagedProcess> Firelink::ManagedProcess::WaitForProcess(
+    const std::wstring& /* name */, int /* timeoutMs */, int /* intervalMs */, std::atomic<bool>& /* stopFlag */)
+{
+    std::lock_guard lock(GetFakeGameMutex());
+    if (!GetFakeGame().isProcessRunning)
+        return nullptr;
+    return std::make_unique<ManagedProcess>(1, nullptr);
+}
+
+bool Firelink::ManagedProcess::IsProcessTerminated() const
+{
+    std::lock_guard lock(GetFakeGameMutex());
+    const FakeGame& game = GetFakeGame();
+    return !game.isProcessRunning
+           || std::ranges::find(game.exitedProcessIDs, m_processID) != game.exitedProcessIDs.end();
+}
+
+DSRHook::DSRHook(std::unique_ptr<Firelink::ManagedProcess> process)
+    : m_process(std::move(process))
+{}
+
+bool DSRHook::IsGameLoaded() const
+{
+    std::lock_guard lock(GetFakeGameMutex());
+    return GetFakeGame().isGameLoaded;
+}
+
+std::shared_ptr<Firelink::BasePointer> DSRHook::PlayerIns() const
+{
+    std::lock_guard lock(GetFakeGameMutex());
+    const FakeGame& game = GetFakeGame();
+    if (!game.isGameLoaded)
+        return std::make_shared<Firelink::BasePointer>();
+
+    // Laid out fresh for each call, from the fake game's current state.
+    g_chrSlots = {};
+    for (int i = 0; i < game.connectedPlayerCount; ++i)
+        g_chrSlots[i * CHR_SLOT_WORDS] = reinterpret_cast<std::uintptr_t>(&g_connectedPlayerIns[i]);
+    g_playerIns = {};
+    g_playerIns[(PLAYER_INS::CHR_INS_NO_VTABLE + CHR_INS_NO_VTABLE::CONNECTED_PLAYERS_CHR_SLOT_ARRAY) / 8] =
+        reinterpret_cast<std::uintptr_t>(g_chrSlots.data());
+    return std::make_shared<Firelink::BasePointer>(reinterpret_cast<std::uintptr_t>(g_playerIns.data()));
+}
+
+void Firelink::Debug(const std::string& message)
+{
+    std::lock_guard lock(GetFakeGameMutex());
+    GetFakeGame().logLines.push_back("DEBUG: " + message);
+}
+
+void Firelink::Info(const std::string& message)
+{
+    std::lock_guard lock(GetFakeGameMutex());
+    GetFakeGame().logLines.push_back("INFO: " + message);
+}
+
+void Firelink::Warning(const std::string& message)
+{
+    std::lock_guard lock(GetFakeGameMutex());
+    GetFakeGame().logLines.push_back("WARNING: " + message);
+}
+
+void Firelink::Error(const std::string& message)
+{
+    std::lock_guard lock(GetFakeGameMutex());
+    GetFakeGame().logLines.push_back("ERROR: " + message);
+}
+
+DSRPlayer::DSRPlayer(DSRHook* /* hook */, Firelink::BasePointer /* playerIns */) {}
+
+std::vector<int> DSRPlayer::GetPlayerActiveSpEffects() const
+{
+    std::lock_guard lock(GetFakeGameMutex());
+    return GetFakeGame().activeSpEffects;
+}
+
+int DSRPlayer::GetWeapon(const WeaponSlot slot, const bool isLeftHand) const
+{
+    return ReadFakeSlot(GetWeaponEquipSlot(slot, isLeftHand));
+}
+
+bool DSRPlayer::SetWeapon(const WeaponSlot slot, const int paramID, const bool isLeftHand) const
+{
+    return WriteFakeSlot(GetWeaponEquipSlot(slot, isLeftHand), paramID);
+}
+
+WeaponSlot DSRPlayer::GetWeaponSlot(const bool isLeftHand) const
+{
+    std::lock_guard lock(GetFakeGameMutex());
+    return GetFakeGame().isSecondaryActive[isLeftHand ? 0 : 1] ? WeaponSlot::SECONDARY : WeaponSlot::PRIMARY;
+}
+
+int DSRPlayer::GetArmor(const ArmorType type) const
+{
+    return ReadFakeSlot(static_cast<EquipSlot>(static_cast<int>(EquipSlot::HEAD) + static_cast<int>(type)));
+}
+
+bool DSRPlayer::SetArmor(const ArmorType type, const int paramID) const
+{
+    return WriteFakeSlot(static_cast<EquipSlot>(static_cast<int>(EquipSlot::HEAD) + static_cast<int>(type)), paramID);
+}
+
+int DSRPlayer::GetRing(const int ringSlot) const
+{
+    return ReadFakeSlot(ringSlot == 0 ? EquipSlot::RING_0 : EquipSlot::RING_1);
+}
+
+bool DSRPlayer::SetRing(const int ringSlot, const int paramID) const
+{
+    return WriteFakeSlot(ringSlot == 0 ? EquipSlot::RING_0 : EquipSlot::RING_1, paramID);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <DSREquipmentSwap/Slots.h>
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace DSREquipmentSwap::Testing
+{
+    /// @brief The game state behind every fake `DSRPlayer`, and the lines logged through fake Firelink logging.
+    ///
+    /// @details `onRead` and `onWrite` let a test act as the game at the exact points where the swapper reads or
+    /// writes a slot (e.g. equip something else between the swapper's check and its write).
+    ///
+    /// Every fake takes `GetFakeGameMutex()` while it uses the fake game, so swappers may run on several threads
+    /// (multi-process mode). A test that changes the game while they do takes it too.
+    struct FakeGame
+    {
+        bool isProcessRunning = true;
+        std::vector<unsigned long> exitedProcessIDs; // processes that have exited even though the game still runs
+        bool isGameLoaded = true;
+        int connectedPlayerCount = 1; // in ChrSlots 0 and up; all of them share the slots below
+
+        std::array<int, EQUIP_SLOT_COUNT> paramIDs = {};
+        std::array<bool, 2> isSecondaryActive = {}; // left hand first
+        std::vector<int> activeSpEffects;
+        bool isWriteFailing = false;
+
+        std::function<void(EquipSlot slot)> onRead;  // called before each slot read
+        std::function<void(EquipSlot slot)> onWrite; // called after each slot write
+        int readCount = 0;
+        int writeCount = 0;
+
+        std::vector<std::string> logLines; // "INFO: ...", "WARNING: ..." and so on
+    };
+
+    /// @brief The fake game. Tests reset it with `GetFakeGame() = {}`.
+    FakeGame& GetFakeGame();
+
+    /// @brief Guards the fake game. Recursive, since `onRead` and `onWrite` run under it.
+    std::recursive_mutex& GetFakeGameMutex();
+} // namespace DSREquipmentSwap::Testing
@@ -0,0 +1,13 @@
+#pragma once
+
+// Test stand-in for Firelink's logging: lines go to `FakeGame.h`'s log instead of a file.
+
+#include <string>
+
+namespace Firelink
+{
+    void Debug(const std::string& message);
+    void Info(const std::string& message);
+    void Warning(const std::string& message);
+    void Error(const std::string& message);
+} // namespace Firelink
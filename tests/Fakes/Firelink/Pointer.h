@@ -0,0 +1,28 @@
+#pragma once
+
+// Test stand-in for Firelink's pointers: a plain address in this process, as the fake game's memory lives here.
+
+#include <cstdint>
+#include <string>
+
+namespace Firelink
+{
+    class BasePointer
+    {
+    public:
+        BasePointer() = default;
+
+        explicit BasePointer(const std::uintptr_t address)
+            : m_address(address)
+        {}
+
+        /// @brief Follow the pointer stored at `offset` from this one (null if this one is null).
+        [[nodiscard]] BasePointer ReadPointer(const std::string& name, int offset) const;
+
+        [[nodiscard]] bool IsNull() const { return m_address == 0; }
+        [[nodiscard]] void* GetAddress() const { return reinterpret_cast<void*>(m_address); }
+
+    private:
+        std::uintptr_t m_address = 0;
+    };
+} // namespace Firelink
@@ -0,0 +1,31 @@
+#pragma once
+
+// Test stand-in for Firelink's processes: every process is the fake game of `FakeGame.h`.
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+typedef void* HANDLE;
+
+namespace Firelink
+{
+    class ManagedProcess
+    {
+    public:
+        ManagedProcess(unsigned long processID, HANDLE handle);
+
+        /// @brief A new process of the fake game, or nullptr if `FakeGame::isProcessRunning` is false.
+        static std::unique_ptr<ManagedProcess> WaitForProcess(
+            const std::wstring& name, int timeoutMs, int intervalMs, std::atomic<bool>& stopFlag);
+
+        [[nodiscard]] bool IsHandleValid() const { return true; }
+        [[nodiscard]] bool IsProcessTerminated() const;
+        [[nodiscard]] HANDLE GetHandle() const { return m_handle; }
+        [[nodiscard]] unsigned long GetProcessID() const { return m_processID; }
+
+    private:
+        unsigned long m_processID;
+        HANDLE m_handle;
+    };
+} // namespace Firelink
@@ -0,0 +1,20 @@
+#pragma once
+
+// Test stand-in for FirelinkDSR's enums (only those the swapper uses).
+
+namespace FirelinkDSR
+{
+    enum class WeaponSlot
+    {
+        PRIMARY,
+        SECONDARY,
+    };
+
+    enum class ArmorType
+    {
+        HEAD,
+        BODY,
+        ARMS,
+        LEGS,
+    };
+} // namespace FirelinkDSR
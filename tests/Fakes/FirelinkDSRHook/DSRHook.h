@@ -0,0 +1,37 @@
+#pragma once
+
+// Test stand-in for FirelinkDSR's hook: the game's `PlayerIns` and ChrSlot array are buffers of `FakeFirelink.cpp`,
+// filled from `FakeGame.h`'s state, so the swapper reads them with its in-process memory backend.
+
+#include <Firelink/Pointer.h>
+#include <Firelink/Process.h>
+
+#include <memory>
+
+#define DSR_PROCESS_NAME L"DarkSoulsRemastered.exe"
+
+namespace FirelinkDSR
+{
+    namespace PLAYER_INS
+    {
+        constexpr int CHR_INS_NO_VTABLE = 0x8;
+    }
+
+    namespace CHR_INS_NO_VTABLE
+    {
+        constexpr int CONNECTED_PLAYERS_CHR_SLOT_ARRAY = 0x10;
+    }
+
+    class DSRHook
+    {
+    public:
+        explicit DSRHook(std::unique_ptr<Firelink::ManagedProcess> process);
+
+        [[nodiscard]] std::shared_ptr<Firelink::ManagedProcess> GetProcess() const { return m_process; }
+        [[nodiscard]] bool IsGameLoaded() const;
+        [[nodiscard]] std::shared_ptr<Firelink::BasePointer> PlayerIns() const;
+
+    private:
+        std::shared_ptr<Firelink::ManagedProcess> m_process;
+    };
+} // namespace FirelinkDSR
@@ -0,0 +1,30 @@
+#pragma once
+
+// Test stand-in for FirelinkDSR's player: every `DSRPlayer` is the one player of `FakeGame.h`.
+
+#include <FirelinkDSRHook/DSREnums.h>
+
+#include <Firelink/Pointer.h>
+
+#include <vector>
+
+namespace FirelinkDSR
+{
+    class DSRHook;
+
+    class DSRPlayer
+    {
+    public:
+        DSRPlayer() = default;
+        DSRPlayer(DSRHook* hook, Firelink::BasePointer playerIns);
+
+        [[nodiscard]] std::vector<int> GetPlayerActiveSpEffects() const;
+        [[nodiscard]] int GetWeapon(WeaponSlot slot, bool isLeftHand) const;
+        bool SetWeapon(WeaponSlot slot, int paramID, bool isLeftHand) const;
+        [[nodiscard]] WeaponSlot GetWeaponSlot(bool isLeftHand) const;
+        [[nodiscard]] int GetArmor(ArmorType type) const;
+        bool SetArmor(ArmorType type, int paramID) const;
+        [[nodiscard]] int GetRing(int ringSlot) const;
+        bool SetRing(int ringSlot, int paramID) const;
+    };
+} // namespace FirelinkDSR
@@ -0,0 +1,233 @@
+#include "FakeGame.h"
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/EquipmentSwapper.h>
+#include <DSREquipmentSwap/FrameSource.h>
+
+#include <Firelink/Process.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    constexpr std::uint64_t BUDGET_US = 1000;
+    constexpr std::uint32_t OVERRUN_LIMIT = 3;
+    constexpr std::uint64_t INITIAL_BACKOFF_US = 5'000'000;
+    constexpr std::uint64_t MAX_BACKOFF_US = 20'000'000;
+    constexpr std::uint64_t STALL_US = 500'000;
+    constexpr std::uint64_t FRAME_US = 16'667; // 60 FPS
+
+    FrameScheduler MakeScheduler()
+    {
+        return FrameScheduler(BUDGET_US, OVERRUN_LIMIT, INITIAL_BACKOFF_US, MAX_BACKOFF_US, STALL_US);
+    }
+
+    /// @brief Run frames from `nowUs` on, each taking `elapsedUs`, while the scheduler lets them. Returns the number
+    /// run; `nowUs` is moved past them.
+    int RunFrames(FrameScheduler& scheduler, std::uint64_t& nowUs, const int count, const std::uint64_t elapsedUs)
+    {
+        int runCount = 0;
+        for (int i = 0; i < count; ++i, nowUs += FRAME_US)
+        {
+            if (!scheduler.ShouldRunFrame(nowUs))
+                continue;
+            scheduler.RecordFrame(nowUs, elapsedUs);
+            ++runCount;
+        }
+        return runCount;
+    }
+
+    void TestFramePacing()
+    {
+        FrameScheduler scheduler = MakeScheduler();
+        std::uint64_t nowUs = 1'000'000;
+        CHECK(scheduler.ShouldThreadUpdate(nowUs)); // no frame yet
+        CHECK(scheduler.ShouldRunFrame(nowUs));
+
+        // Frames within budget: the game's frames update, the thread does not.
+        CHECK(RunFrames(scheduler, nowUs, 100, BUDGET_US) == 100);
+        CHECK(!scheduler.ShouldThreadUpdate(nowUs));
+        CHECK(scheduler.GetFrameCount() == 100 && scheduler.GetOverrunCount() == 0);
+        CHECK(scheduler.GetMaxElapsedUs() == BUDGET_US);
+    }
+
+    void TestMissedFrames()
+    {
+        FrameScheduler scheduler = MakeScheduler();
+        std::uint64_t nowUs = 1'000'000;
+        RunFrames(scheduler, nowUs, 10, 100);
+        const std::uint64_t lastFrameEndUs = nowUs - FRAME_US + 100;
+
+        // A few missed frames (a hitch) do not wake the thread; a stall does, until frames come back.
+        CHECK(!scheduler.ShouldThreadUpdate(lastFrameEndUs + 10 * FRAME_US));
+        CHECK(!scheduler.ShouldThreadUpdate(lastFrameEndUs + STALL_US));
+        CHECK(scheduler.ShouldThreadUpdate(lastFrameEndUs + STALL_US + 1));
+        CHECK(scheduler.ShouldRunFrame(lastFrameEndUs + STALL_US + 1)); // not a fallback: frames may run any time
+        nowUs = lastFrameEndUs + 2 * STALL_US;
+        RunFrames(scheduler, nowUs, 1, 100);
+        CHECK(!scheduler.ShouldThreadUpdate(nowUs));
+        CHECK(scheduler.GetFallbackCount() == 0);
+    }
+
+    void TestOverBudget()
+    {
+        FrameScheduler scheduler = MakeScheduler();
+        std::uint64_t nowUs = 1'000'000;
+
+        // Slow frames that are not in a row are only counted.
+        for (int i = 0; i < 5; ++i)
+        {
+            RunFrames(scheduler, nowUs, OVERRUN_LIMIT - 1, 2 * BUDGET_US);
+            RunFrames(scheduler, nowUs, 1, BUDGET_US);
+        }
+        CHECK(scheduler.GetOverrunCount() == 5 * (OVERRUN_LIMIT - 1) && scheduler.GetFallbackCount() == 0);
+
+        // `OVERRUN_LIMIT` in a row: no frame runs for the backoff, and the thread updates instead.
+        RunFrames(scheduler, nowUs, OVERRUN_LIMIT, 2 * BUDGET_US);
+        CHECK(scheduler.GetFallbackCount() == 1 && scheduler.GetLastBackoffUs() == INITIAL_BACKOFF_US);
+        const std::uint64_t fallbackEndUs = nowUs - FRAME_US + 2 * BUDGET_US + INITIAL_BACKOFF_US;
+        CHECK(!scheduler.ShouldRunFrame(fallbackEndUs - 1) && scheduler.ShouldThreadUpdate(fallbackEndUs - 1));
+        CHECK(scheduler.ShouldRunFrame(fallbackEndUs));
+        CHECK(RunFrames(scheduler, nowUs, static_cast<int>(INITIAL_BACKOFF_US / FRAME_US) - 1, 100) == 0);
+
+        // Over budget again right away: the backoff doubles, up to its maximum.
+        for (const std::uint64_t backoffUs : {2 * INITIAL_BACKOFF_US, 4 * INITIAL_BACKOFF_US, MAX_BACKOFF_US})
+        {
+            nowUs = fallbackEndUs + 10 * MAX_BACKOFF_US * (backoffUs / INITIAL_BACKOFF_US);
+            RunFrames(scheduler, nowUs, OVERRUN_LIMIT, 2 * BUDGET_US);
+            CHECK(scheduler.GetLastBackoffUs() == backoffUs);
+        }
+
+        // Frames within budget for long enough reset it.
+        nowUs += 2 * MAX_BACKOFF_US;
+        CHECK(RunFrames(scheduler, nowUs, FrameScheduler::BACKOFF_RESET_FRAMES, BUDGET_US)
+              == static_cast<int>(FrameScheduler::BACKOFF_RESET_FRAMES));
+        RunFrames(scheduler, nowUs, OVERRUN_LIMIT, 2 * BUDGET_US);
+        CHECK(scheduler.GetLastBackoffUs() == INITIAL_BACKOFF_US);
+    }
+
+    void TestExternalFrameSource()
+    {
+        CHECK(!ExternalFrameSource::NotifyFrame()); // nothing started
+
+        int frameCount = 0;
+        ExternalFrameSource source;
+        CHECK(source.Start([&frameCount] { ++frameCount; }));
+        ExternalFrameSource otherSource;
+        CHECK(!otherSource.Start([] {})); // one at a time
+        CHECK(ExternalFrameSource::NotifyFrame() && ExternalFrameSource::NotifyFrame());
+        CHECK(frameCount == 2);
+        otherSource.Stop(); // not the started one: no effect
+        CHECK(ExternalFrameSource::NotifyFrame() && frameCount == 3);
+
+        // `Stop()` waits out a frame that is running the callback.
+        std::latch isInFrame(1);
+        std::latch canFinishFrame(1);
+        std::atomic<bool> isFrameFinished = false;
+        ExternalFrameSource blockingSource;
+        source.Stop();
+        CHECK(blockingSource.Start(
+            [&]
+            {
+                isInFrame.count_down();
+                canFinishFrame.wait();
+                isFrameFinished = true;
+            }));
+        std::thread gameThread([] { ExternalFrameSource::NotifyFrame(); });
+        isInFrame.wait();
+        std::atomic<bool> isStopped = false;
+        std::thread stopThread(
+            [&]
+            {
+                blockingSource.Stop();
+                CHECK(isFrameFinished);
+                isStopped = true;
+            });
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        CHECK(!isStopped);
+        canFinishFrame.count_down();
+        gameThread.join();
+        stopThread.join();
+        CHECK(!ExternalFrameSource::NotifyFrame() && frameCount == 3);
+    }
+
+    /// @brief Frame source driven by the test, as the game's frame hook would.
+    class TestFrameSource final : public FrameSource
+    {
+    public:
+        bool Start(std::function<void()> onFrame) override
+        {
+            m_onFrame = std::move(onFrame);
+            return true;
+        }
+
+        void Stop() override { m_onFrame = nullptr; }
+
+        [[nodiscard]] std::string GetName() const override { return "Test"; }
+
+        void RunFrame() const
+        {
+            if (m_onFrame)
+                m_onFrame();
+        }
+
+    private:
+        std::function<void()> m_onFrame;
+    };
+
+    /// @brief Updates move to the game's frames while they come, and back to the swapper thread when they stop.
+    void TestSwapperFallsBackToThread()
+    {
+        GetFakeGame() = {};
+        int& headParamID = GetFakeGame().paramIDs[static_cast<int>(EquipSlot::HEAD)];
+        headParamID = 5000;
+
+        EquipmentSwapConfig config;
+        config.hookConfig.frameHookMode = true;
+        config.hookConfig.swapJournalPath.clear();
+        config.headArmorTriggers.push_back(SwapTriggerConfig{-1, 5000, -1, 6000, true, true}); // every update
+        EquipmentSwapper swapper(config);
+        auto frameSource = std::make_unique<TestFrameSource>();
+        const TestFrameSource& frames = *frameSource;
+        swapper.SetFrameSource(std::move(frameSource));
+        swapper.Attach(std::make_unique<Firelink::ManagedProcess>(1, nullptr));
+
+        // No frame yet: the thread updates.
+        CHECK(swapper.Tick().has_value());
+        CHECK(headParamID == 6000);
+
+        // Frames update; the thread only keeps the hook up to date meanwhile.
+        headParamID = 5000;
+        frames.RunFrame();
+        CHECK(headParamID == 6000);
+        headParamID = 5000;
+        CHECK(swapper.Tick().has_value());
+        CHECK(headParamID == 5000);
+
+        // The frame source stops calling: the thread takes over once frames have stalled.
+        std::this_thread::sleep_for(std::chrono::microseconds(STALL_US + 100'000));
+        CHECK(swapper.Tick().has_value());
+        CHECK(headParamID == 6000);
+    }
+} // namespace
+
+int main()
+{
+    TestFramePacing();
+    TestMissedFrames();
+    TestOverBudget();
+    TestExternalFrameSource();
+    TestSwapperFallsBackToThread();
+    return Finish("FrameUpdateTest");
+}
@@ -0,0 +1,135 @@
+#include "FakeGame.h"
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/MultiProcessSwapper.h>
+#include <DSREquipmentSwap/ProcessDiscovery.h>
+
+#include <Firelink/Process.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    constexpr int MONITOR_INTERVAL_MS = 10;
+    constexpr auto RUN_TIME = std::chrono::milliseconds(1000);
+
+    /// @brief `processCount` processes, all running for the whole benchmark.
+    class FixedProcessDiscovery final : public ProcessDiscovery
+    {
+    public:
+        explicit FixedProcessDiscovery(const int processCount)
+        {
+            for (int i = 0; i < processCount; ++i)
+                m_processIDs.push_back(static_cast<std::uint32_t>(100 + i));
+        }
+
+        std::optional<std::uint32_t> FindProcess() override { return m_processIDs.front(); }
+        void FindProcesses(std::vector<std::uint32_t>& processIDs) override { processIDs = m_processIDs; }
+        [[nodiscard]] std::uint64_t GetNameLookupCount() const override { return 0; }
+        [[nodiscard]] std::string GetName() const override { return "Fixed"; }
+
+    private:
+        std::vector<std::uint32_t> m_processIDs;
+    };
+
+    struct RunResult
+    {
+        int hookedCount = 0;
+        bool isAnyLost = false;
+        unsigned long long ticks = 0;
+        unsigned long long averageLatenessUs = 0;
+        unsigned long long maxLatenessUs = 0;
+    };
+
+    /// @brief Run `processCount` instances on `workerThreads` workers for `RUN_TIME`, and read the pool's counters
+    /// from the stop line `Run()` logs.
+    RunResult Run(const int processCount, const int workerThreads)
+    {
+        {
+            std::lock_guard lock(GetFakeGameMutex());
+            GetFakeGame() = {};
+            GetFakeGame().connectedPlayerCount = 4;
+        }
+
+        EquipmentSwapConfig config;
+        config.hookConfig.maxProcesses = processCount;
+        config.hookConfig.workerThreads = workerThreads;
+        config.hookConfig.processSearchIntervalMs = 100;
+        config.hookConfig.monitorIntervalMs = MONITOR_INTERVAL_MS;
+        config.hookConfig.swapJournalPath.clear();
+        for (int i = 0; i < 8; ++i)
+            config.headArmorTriggers.push_back(SwapTriggerConfig{-1, 5000 + i, -1, 6000 + i, true, true});
+
+        MultiProcessSwapper swapper(config);
+        swapper.SetProcessDiscovery(std::make_unique<FixedProcessDiscovery>(processCount));
+        swapper.SetProcessOpener([](const std::uint32_t processID)
+        {
+            return std::make_unique<Firelink::ManagedProcess>(processID, nullptr);
+        });
+        std::thread runThread([&swapper] { swapper.Run(); });
+        std::this_thread::sleep_for(RUN_TIME);
+        swapper.RequestStop();
+        runThread.join();
+
+        RunResult result;
+        std::lock_guard lock(GetFakeGameMutex());
+        for (const std::string& line : GetFakeGame().logLines)
+        {
+            result.hookedCount += line.starts_with("INFO: Instance ") && line.find(" hooked ") != std::string::npos;
+            result.isAnyLost |= line.find(" lost DSR process ") != std::string::npos;
+            int instanceCount = 0;
+            std::sscanf(
+                line.c_str(),
+                "INFO: Stopped %d swapper instances (%llu updates, scheduling delay %llu us on average, %llu us",
+                &instanceCount,
+                &result.ticks,
+                &result.averageLatenessUs,
+                &result.maxLatenessUs);
+        }
+        return result;
+    }
+} // namespace
+
+/// @brief Updates and scheduling delay of up to 32 swapper instances (multi-process mode) on a few worker threads,
+/// each updating every `MONITOR_INTERVAL_MS` with four players. Game access goes through the fakes, which serialize it
+/// like a single remote process never would, so this measures the pool and the swapper's own work. Not a pass/fail
+/// threshold; it only fails if an instance is not hooked or loses its process.
+int main()
+{
+    const int hardwareThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    std::printf("Instances x workers: updates per instance per second (ideal %d); scheduling delay average, max\n",
+        1000 / MONITOR_INTERVAL_MS);
+    for (const int processCount : {1, 8, 32})
+    {
+        // One worker, a few, and what `workerThreads: 0` picks (one per instance, up to the hardware threads).
+        std::vector<int> workerCounts = {1, 4, std::min(processCount, hardwareThreads)};
+        std::erase_if(workerCounts, [processCount](const int workerCount) { return workerCount > processCount; });
+        std::ranges::sort(workerCounts);
+        workerCounts.erase(std::ranges::unique(workerCounts).begin(), workerCounts.end());
+        for (const int workerCount : workerCounts)
+        {
+            const RunResult result = Run(processCount, workerCount);
+            CHECK(result.hookedCount == processCount && !result.isAnyLost);
+            std::printf(
+                "%2d x %2d: %5.1f; %5llu us, %6llu us\n",
+                processCount,
+                workerCount,
+                static_cast<double>(result.ticks) / processCount / std::chrono::duration<double>(RUN_TIME).count(),
+                result.averageLatenessUs,
+                result.maxLatenessUs);
+        }
+    }
+    return Finish("MultiProcessSwapperBenchmark");
+}
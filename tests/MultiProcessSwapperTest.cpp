@@ -0,0 +1,242 @@
+#include "FakeGame.h"
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/MultiProcessSwapper.h>
+#include <DSREquipmentSwap/ProcessDiscovery.h>
+
+#include <Firelink/Process.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    constexpr std::uint32_t UNOPENABLE_PROCESS_ID = 666;
+
+    /// @brief Process list set by the test.
+    class TestProcessDiscovery final : public ProcessDiscovery
+    {
+    public:
+        std::optional<std::uint32_t> FindProcess() override
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_processIDs.empty())
+                return std::nullopt;
+            return m_processIDs.front();
+        }
+
+        void FindProcesses(std::vector<std::uint32_t>& processIDs) override
+        {
+            std::lock_guard lock(m_mutex);
+            processIDs = m_processIDs;
+        }
+
+        [[nodiscard]] std::uint64_t GetNameLookupCount() const override { return 0; }
+        [[nodiscard]] std::string GetName() const override { return "Test"; }
+
+        void SetProcesses(std::vector<std::uint32_t> processIDs)
+        {
+            std::lock_guard lock(m_mutex);
+            m_processIDs = std::move(processIDs);
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::vector<std::uint32_t> m_processIDs;
+    };
+
+    EquipmentSwapConfig MakeConfig(const int maxProcesses)
+    {
+        EquipmentSwapConfig config;
+        config.hookConfig.maxProcesses = maxProcesses;
+        config.hookConfig.workerThreads = 2;
+        config.hookConfig.processSearchIntervalMs = 2;
+        config.hookConfig.monitorIntervalMs = 1;
+        config.hookConfig.gameLoadedIntervalMs = 1;
+        config.hookConfig.swapJournalPath.clear();
+        config.headArmorTriggers.push_back(SwapTriggerConfig{-1, 5000, -1, 6000, true, true}); // every update
+        return config;
+    }
+
+    /// @brief Whether a line starting with `prefix` has been logged.
+    bool HasLogLine(const std::string& prefix)
+    {
+        std::lock_guard lock(GetFakeGameMutex());
+        return std::ranges::any_of(
+            GetFakeGame().logLines, [&prefix](const std::string& line) { return line.starts_with(prefix); });
+    }
+
+    std::size_t CountLogLines(const std::string& prefix)
+    {
+        std::lock_guard lock(GetFakeGameMutex());
+        return std::ranges::count_if(
+            GetFakeGame().logLines, [&prefix](const std::string& line) { return line.starts_with(prefix); });
+    }
+
+    /// @brief Wait until `condition` holds. False if it does not within a few seconds.
+    template <typename Condition>
+    bool WaitFor(Condition condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!condition())
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    bool WaitForLogLine(const std::string& prefix)
+    {
+        return WaitFor([&prefix] { return HasLogLine(prefix); });
+    }
+
+    /// @brief Put the head slot back, so the next update of any instance swaps it again.
+    void ResetHead()
+    {
+        std::lock_guard lock(GetFakeGameMutex());
+        GetFakeGame().paramIDs[static_cast<int>(EquipSlot::HEAD)] = 5000;
+    }
+
+    bool IsHeadSwapped()
+    {
+        std::lock_guard lock(GetFakeGameMutex());
+        return GetFakeGame().paramIDs[static_cast<int>(EquipSlot::HEAD)] == 6000;
+    }
+
+    void SetProcessExited(const std::uint32_t processID)
+    {
+        std::lock_guard lock(GetFakeGameMutex());
+        GetFakeGame().exitedProcessIDs.push_back(processID);
+    }
+
+    void ResetFakeGame()
+    {
+        std::lock_guard lock(GetFakeGameMutex());
+        GetFakeGame() = {};
+    }
+
+    /// @brief Swapper with a test process list, whose opened processes are recorded. Runs on its own thread.
+    struct TestRig
+    {
+        MultiProcessSwapper swapper;
+        TestProcessDiscovery* discovery;
+        std::mutex openedMutex;
+        std::vector<std::uint32_t> openedProcessIDs;
+        std::thread runThread;
+
+        explicit TestRig(const int maxProcesses)
+            : swapper(MakeConfig(maxProcesses))
+        {
+            auto testDiscovery = std::make_unique<TestProcessDiscovery>();
+            discovery = testDiscovery.get();
+            swapper.SetProcessDiscovery(std::move(testDiscovery));
+            swapper.SetProcessOpener(
+                [this](const std::uint32_t processID) -> std::unique_ptr<Firelink::ManagedProcess>
+                {
+                    std::lock_guard lock(openedMutex);
+                    openedProcessIDs.push_back(processID);
+                    if (processID == UNOPENABLE_PROCESS_ID)
+                        return nullptr;
+                    return std::make_unique<Firelink::ManagedProcess>(processID, nullptr);
+                });
+        }
+
+        ~TestRig()
+        {
+            swapper.RequestStop();
+            if (runThread.joinable())
+                runThread.join();
+        }
+
+        void Start()
+        {
+            runThread = std::thread([this] { swapper.Run(); });
+        }
+
+        std::vector<std::uint32_t> GetOpenedProcessIDs()
+        {
+            std::lock_guard lock(openedMutex);
+            return openedProcessIDs;
+        }
+    };
+
+    void TestAttachAndReuse()
+    {
+        ResetFakeGame();
+        ResetHead();
+        TestRig rig(2);
+        rig.discovery->SetProcesses({10});
+        rig.Start();
+        CHECK(WaitForLogLine("INFO: Instance 0 hooked DSR process 10."));
+        CHECK(WaitFor(IsHeadSwapped)); // the instance updates
+
+        // A second process gets its own instance; a third finds none.
+        rig.discovery->SetProcesses({10, 11, 12});
+        CHECK(WaitForLogLine("INFO: Instance 1 hooked DSR process 11."));
+        CHECK(WaitForLogLine("WARNING: All 2 instances are in use. Not hooking 1 more DSR processes."));
+
+        // Process 10 exits: only its instance stops, and takes process 12 once 10 is no longer listed.
+        SetProcessExited(10);
+        CHECK(WaitForLogLine("WARNING: Instance 0 lost DSR process 10."));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        CHECK(!HasLogLine("INFO: Instance 0 hooked DSR process 12.")); // 10 is still listed
+        rig.discovery->SetProcesses({11, 12});
+        CHECK(WaitForLogLine("INFO: Instance 0 hooked DSR process 12."));
+        CHECK(!HasLogLine("WARNING: Instance 1 lost"));
+
+        rig.swapper.RequestStop();
+        rig.runThread.join();
+        CHECK(rig.GetOpenedProcessIDs() == (std::vector<std::uint32_t>{10, 11, 12}));
+        CHECK(HasLogLine("INFO: Stopped 2 swapper instances"));
+    }
+
+    /// @brief A process that cannot be opened keeps its instance (without retrying) until it is gone.
+    void TestUnopenableProcess()
+    {
+        ResetFakeGame();
+        TestRig rig(1);
+        rig.discovery->SetProcesses({UNOPENABLE_PROCESS_ID});
+        rig.Start();
+        CHECK(WaitForLogLine("ERROR: Could not open DSR process 666 for instance 0."));
+        rig.discovery->SetProcesses({UNOPENABLE_PROCESS_ID, 20});
+        CHECK(WaitForLogLine("WARNING: All 1 instances are in use."));
+        CHECK(CountLogLines("ERROR: Could not open DSR process 666") == 1);
+
+        rig.discovery->SetProcesses({20});
+        CHECK(WaitForLogLine("INFO: Instance 0 hooked DSR process 20."));
+        CHECK(rig.GetOpenedProcessIDs() == (std::vector<std::uint32_t>{UNOPENABLE_PROCESS_ID, 20}));
+    }
+
+    void TestSearchTimeout()
+    {
+        ResetFakeGame();
+        EquipmentSwapConfig config = MakeConfig(4);
+        config.hookConfig.processSearchTimeoutMs = 20;
+        MultiProcessSwapper swapper(config);
+        swapper.SetProcessDiscovery(std::make_unique<TestProcessDiscovery>());
+        swapper.Run(); // returns by itself
+        CHECK(HasLogLine("ERROR: No DSR process hooked for 20 ms."));
+        CHECK(HasLogLine("INFO: Stopped 0 swapper instances"));
+    }
+} // namespace
+
+int main()
+{
+    TestAttachAndReuse();
+    TestUnopenableProcess();
+    TestSearchTimeout();
+    return Finish("MultiProcessSwapperTest");
+}
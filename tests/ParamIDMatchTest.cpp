@@ -0,0 +1,158 @@
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/ParamIDMatch.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+// Built once as is (SSE2 on x64) and once with AVX2 (`ParamIDMatchAVX2Test`): every path must match the scalar loop.
+
+namespace
+{
+    constexpr std::int32_t ANY_MIN = std::numeric_limits<std::int32_t>::min();
+    constexpr std::int32_t ANY_MAX = std::numeric_limits<std::int32_t>::max();
+
+    /// @brief More than four vectors of the widest path, so every tail length (0-7) follows whole vectors.
+    constexpr std::size_t MAX_COUNT = 37;
+
+    std::size_t FindScalar(
+        const std::int32_t* mins, const std::int32_t* maxes, const std::size_t count, const std::int32_t paramID)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (mins[i] <= paramID && paramID <= maxes[i])
+                return i;
+        }
+        return count;
+    }
+
+    /// @brief Compare both paths for `paramID` over every prefix of the ranges, and from an unaligned start.
+    void CheckAllCounts(const std::vector<std::int32_t>& mins, const std::vector<std::int32_t>& maxes, std::int32_t id)
+    {
+        for (std::size_t count = 0; count <= mins.size(); ++count)
+        {
+            CHECK(FindParamIDMatch(mins.data(), maxes.data(), count, id)
+                  == FindScalar(mins.data(), maxes.data(), count, id));
+        }
+        if (mins.size() > 1)
+        {
+            const std::size_t count = mins.size() - 1;
+            CHECK(FindParamIDMatch(mins.data() + 1, maxes.data() + 1, count, id)
+                  == FindScalar(mins.data() + 1, maxes.data() + 1, count, id));
+        }
+    }
+
+    void TestMatchAtEveryIndex()
+    {
+        // Disjoint ranges [100i, 100i + 9]: each ID matches one index, in a vector or in the tail, for every count.
+        std::vector<std::int32_t> mins;
+        std::vector<std::int32_t> maxes;
+        for (std::size_t i = 0; i < MAX_COUNT; ++i)
+        {
+            mins.push_back(static_cast<std::int32_t>(100 * i));
+            maxes.push_back(static_cast<std::int32_t>(100 * i + 9));
+        }
+        for (std::size_t i = 0; i < MAX_COUNT; ++i)
+        {
+            for (const std::int32_t offset : {-1, 0, 5, 9, 10})
+                CheckAllCounts(mins, maxes, static_cast<std::int32_t>(100 * i) + offset);
+            for (std::size_t count = i + 1; count <= MAX_COUNT; ++count)
+                CHECK(FindParamIDMatch(mins.data(), maxes.data(), count, static_cast<std::int32_t>(100 * i)) == i);
+            CHECK(FindParamIDMatch(mins.data(), maxes.data(), i, static_cast<std::int32_t>(100 * i)) == i); // no match
+        }
+    }
+
+    void TestFirstMatchWins()
+    {
+        // Overlapping ranges in one vector, across vectors, and across the vector/tail boundary.
+        std::vector<std::int32_t> mins(MAX_COUNT, 0);
+        std::vector<std::int32_t> maxes(MAX_COUNT, -1); // empty ranges (min > max) never match
+        for (const std::size_t first : {0, 3, 5, 7, 8, 15, 31, 32, 35})
+        {
+            for (const std::size_t second : {first + 1, first + 4, first + 8, MAX_COUNT - 1})
+            {
+                if (second >= MAX_COUNT || second <= first)
+                    continue;
+                std::vector<std::int32_t> overlapMins = mins;
+                std::vector<std::int32_t> overlapMaxes = maxes;
+                overlapMins[first] = 10;
+                overlapMaxes[first] = 20;
+                overlapMins[second] = 15;
+                overlapMaxes[second] = 30;
+                CHECK(FindParamIDMatch(overlapMins.data(), overlapMaxes.data(), MAX_COUNT, 17) == first);
+                CHECK(FindParamIDMatch(overlapMins.data(), overlapMaxes.data(), MAX_COUNT, 25) == second);
+                CheckAllCounts(overlapMins, overlapMaxes, 17);
+                CheckAllCounts(overlapMins, overlapMaxes, 25);
+            }
+        }
+        CheckAllCounts(mins, maxes, 0);
+    }
+
+    void TestOpenRanges()
+    {
+        // The open-range sentinels and IDs at the ends of int32: the signed compares must not wrap.
+        const std::vector<std::int32_t> mins = {5, ANY_MIN, 1000, ANY_MIN, ANY_MAX, 7, 8, 9, 10, -5, 0};
+        const std::vector<std::int32_t> maxes = {4, -1, ANY_MAX, ANY_MAX, ANY_MAX, 6, 7, 8, 9, -6, ANY_MIN};
+        for (const std::int32_t id : {ANY_MIN, ANY_MIN + 1, -2, -1, 0, 1, 999, 1000, ANY_MAX - 1, ANY_MAX})
+            CheckAllCounts(mins, maxes, id);
+        CHECK(FindParamIDMatch(mins.data(), maxes.data(), mins.size(), ANY_MIN) == 1);
+        CHECK(FindParamIDMatch(mins.data(), maxes.data(), mins.size(), 0) == 3);
+        CHECK(FindParamIDMatch(mins.data(), maxes.data(), mins.size(), ANY_MAX) == 2);
+    }
+
+    void TestRandom()
+    {
+        std::mt19937 random(1);
+        for (int round = 0; round < 2000; ++round)
+        {
+            const std::size_t count = random() % (MAX_COUNT + 1);
+            std::vector<std::int32_t> mins(count);
+            std::vector<std::int32_t> maxes(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                // Mostly narrow ranges of real-looking IDs, with some open and some empty ones.
+                const int kind = static_cast<int>(random() % 10);
+                mins[i] = kind == 0 ? ANY_MIN : static_cast<std::int32_t>(random() % 20000);
+                maxes[i] = kind == 1 ? ANY_MAX : mins[i] + static_cast<std::int32_t>(random() % 300) - 10;
+            }
+            for (int i = 0; i < 8; ++i)
+            {
+                const auto id = static_cast<std::int32_t>(random() % 20400) - 200;
+                CHECK(FindParamIDMatch(mins.data(), maxes.data(), count, id)
+                      == FindScalar(mins.data(), maxes.data(), count, id));
+            }
+        }
+    }
+
+    bool IsPathSupported()
+    {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        if (std::strcmp(GetParamIDMatchPath(), "AVX2") == 0)
+            return __builtin_cpu_supports("avx2");
+#endif
+        return true;
+    }
+} // namespace
+
+int main()
+{
+    std::printf("ParamID match path: %s\n", GetParamIDMatchPath());
+    if (!IsPathSupported())
+    {
+        std::printf("SKIP: this CPU does not support the %s path\n", GetParamIDMatchPath());
+        return 0;
+    }
+    TestMatchAtEveryIndex();
+    TestFirstMatchWins();
+    TestOpenRanges();
+    TestRandom();
+    return Finish("ParamIDMatchTest");
+}
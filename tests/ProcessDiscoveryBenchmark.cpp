@@ -0,0 +1,88 @@
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/ProcessDiscovery.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    /// @brief Extra processes, so the scan sees a process list like a desktop's.
+    constexpr int BACKGROUND_PROCESS_COUNT = 300;
+    constexpr int SCAN_COUNT = 320; // ten full rechecks
+    constexpr int FULL_SCAN_COUNT = 30;
+
+    double GetUsPerScan(const std::chrono::steady_clock::duration elapsed, const int scanCount)
+    {
+        return std::chrono::duration<double, std::micro>(elapsed).count() / scanCount;
+    }
+} // namespace
+
+/// @brief Time of one scan for a game that is not running (what the EXE does while it waits), with the rejection cache
+/// and with every name looked up each time. Not a pass/fail threshold; it only fails if the cache does not save name
+/// lookups or a scan finds something.
+int main()
+{
+    std::vector<pid_t> background;
+    for (int i = 0; i < BACKGROUND_PROCESS_COUNT; ++i)
+    {
+        const pid_t processID = fork();
+        if (processID == 0)
+        {
+            execl("/bin/sleep", "sleep", "60", nullptr);
+            _exit(1);
+        }
+        if (processID > 0)
+            background.push_back(processID);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(300)); // let them `exec()`
+
+    const std::wstring gameName = L"DSREquipmentSwapDiscoveryBenchmark.exe";
+    IncrementalProcessDiscovery discovery(gameName);
+    const auto coldStart = std::chrono::steady_clock::now();
+    bool isFound = discovery.FindProcess().has_value();
+    const auto coldElapsed = std::chrono::steady_clock::now() - coldStart;
+    const std::uint64_t coldLookupCount = discovery.GetNameLookupCount();
+
+    const auto warmStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < SCAN_COUNT; ++i)
+        isFound |= discovery.FindProcess().has_value();
+    const auto warmElapsed = std::chrono::steady_clock::now() - warmStart;
+    const double warmLookupsPerScan =
+        static_cast<double>(discovery.GetNameLookupCount() - coldLookupCount) / SCAN_COUNT;
+
+    // Without the cache: a new discovery (so every name is looked up) for each scan.
+    const auto fullStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < FULL_SCAN_COUNT; ++i)
+        isFound |= IncrementalProcessDiscovery(gameName).FindProcess().has_value();
+    const auto fullElapsed = std::chrono::steady_clock::now() - fullStart;
+
+    for (const pid_t processID : background)
+        kill(processID, SIGKILL);
+    for (const pid_t processID : background)
+        waitpid(processID, nullptr, 0);
+
+    CHECK(!isFound);
+    CHECK(coldLookupCount >= static_cast<std::uint64_t>(background.size()));
+    CHECK(warmLookupsPerScan < static_cast<double>(coldLookupCount) / 4);
+    std::printf(
+        "%llu processes: first scan %.1f us; cached %.1f us (%.1f name lookups per scan, incl. full rechecks); "
+        "uncached %.1f us\n",
+        static_cast<unsigned long long>(coldLookupCount),
+        GetUsPerScan(coldElapsed, 1),
+        GetUsPerScan(warmElapsed, SCAN_COUNT),
+        warmLookupsPerScan,
+        GetUsPerScan(fullElapsed, FULL_SCAN_COUNT));
+    return Finish("ProcessDiscoveryBenchmark");
+}
@@ -0,0 +1,202 @@
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/ProcessDiscovery.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+// `/proc`-based discovery only. Game instances are `sleep` processes started with the game's name as their first
+// argument, which is what discovery matches (as it does for Wine paths).
+
+namespace
+{
+    /// @brief Name unique to this test run, so no other process matches.
+    std::string GetGameName()
+    {
+        return "DSREquipmentSwapDiscoveryTest" + std::to_string(getpid()) + ".exe";
+    }
+
+    std::wstring Widen(const std::string& text)
+    {
+        return {text.begin(), text.end()};
+    }
+
+    /// @brief Child process that runs `sleep` under `argument0`, right away or once `Exec()` is called.
+    class ChildProcess
+    {
+    public:
+        explicit ChildProcess(std::string argument0, const bool isExecDeferred = false)
+            : m_argument0(std::move(argument0))
+        {
+            int pipeFDs[2];
+            if (pipe(pipeFDs) != 0)
+                return;
+            m_processID = fork();
+            if (m_processID == 0)
+            {
+                close(pipeFDs[1]);
+                char go;
+                if (isExecDeferred && read(pipeFDs[0], &go, 1) != 1)
+                    _exit(1);
+                execl("/bin/sleep", m_argument0.c_str(), "30", nullptr);
+                _exit(1);
+            }
+            close(pipeFDs[0]);
+            m_execPipeFD = pipeFDs[1];
+            if (!isExecDeferred)
+                WaitForExec();
+        }
+
+        ~ChildProcess()
+        {
+            Kill();
+            if (m_execPipeFD >= 0)
+                close(m_execPipeFD);
+        }
+
+        ChildProcess(const ChildProcess&) = delete;
+        ChildProcess& operator=(const ChildProcess&) = delete;
+
+        [[nodiscard]] std::uint32_t GetProcessID() const { return static_cast<std::uint32_t>(m_processID); }
+
+        /// @brief Let a deferred child `exec()` `sleep`.
+        void Exec() const
+        {
+            constexpr char GO = 1;
+            if (write(m_execPipeFD, &GO, 1) == 1)
+                WaitForExec();
+        }
+
+        /// @brief Kill the child and reap it, so its `/proc` entry is gone.
+        void Kill()
+        {
+            if (m_processID <= 0)
+                return;
+            kill(m_processID, SIGKILL);
+            waitpid(m_processID, nullptr, 0);
+            m_processID = -1;
+        }
+
+    private:
+        std::string m_argument0;
+        pid_t m_processID = -1;
+        int m_execPipeFD = -1;
+
+        /// @brief Wait until the child's first argument is `m_argument0`, i.e. it runs `sleep`.
+        void WaitForExec() const
+        {
+            const std::string cmdlinePath = "/proc/" + std::to_string(m_processID) + "/cmdline";
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (std::chrono::steady_clock::now() < deadline)
+            {
+                std::string cmdline;
+                if (FILE* file = std::fopen(cmdlinePath.c_str(), "rb"))
+                {
+                    char buffer[512];
+                    cmdline.assign(buffer, std::fread(buffer, 1, sizeof(buffer), file));
+                    std::fclose(file);
+                }
+                if (cmdline.substr(0, cmdline.find('\0')) == m_argument0)
+                    return;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    };
+
+    void TestNotRunning()
+    {
+        IncrementalProcessDiscovery discovery(Widen(GetGameName()));
+        CHECK(!discovery.FindProcess());
+        const std::uint64_t firstLookupCount = discovery.GetNameLookupCount();
+        CHECK(firstLookupCount > 0); // this process, at least
+
+        // Rejected processes are not looked up again; the process list barely changes between scans.
+        std::vector<std::uint32_t> processIDs = {123};
+        discovery.FindProcesses(processIDs);
+        CHECK(processIDs.empty());
+        CHECK(discovery.GetNameLookupCount() - firstLookupCount < firstLookupCount);
+    }
+
+    void TestFindsInstances()
+    {
+        const std::string gameName = GetGameName();
+        IncrementalProcessDiscovery discovery(Widen(gameName));
+        CHECK(!discovery.FindProcess());
+
+        // Started after the first scan, by path; then a second instance as Wine names it, in other case.
+        ChildProcess game("/games/" + gameName);
+        CHECK(discovery.FindProcess() == game.GetProcessID());
+        std::string wineName = "C:\\Program Files\\" + gameName;
+        for (char& c : wineName)
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        ChildProcess wineGame(wineName);
+
+        std::vector<std::uint32_t> processIDs;
+        discovery.FindProcesses(processIDs);
+        std::ranges::sort(processIDs);
+        std::vector<std::uint32_t> expected = {game.GetProcessID(), wineGame.GetProcessID()};
+        std::ranges::sort(expected);
+        CHECK(processIDs == expected);
+
+        // Matches are never cached: once they exit, they are not found.
+        game.Kill();
+        CHECK(discovery.FindProcess() == wineGame.GetProcessID());
+        wineGame.Kill();
+        CHECK(!discovery.FindProcess());
+        discovery.FindProcesses(processIDs);
+        CHECK(processIDs.empty());
+
+        // A name that only starts with the game's does not match.
+        const ChildProcess other("/games/" + gameName + ".bak");
+        CHECK(!discovery.FindProcess());
+    }
+
+    /// @brief A process rejected under another name that turns into the game by `exec()` is found by a full recheck.
+    void TestExecInPlace()
+    {
+        const std::string gameName = GetGameName();
+        IncrementalProcessDiscovery discovery(Widen(gameName));
+        ChildProcess child(gameName, true);
+        CHECK(!discovery.FindProcess()); // still this test's image
+        child.Exec();
+
+        std::optional<std::uint32_t> found;
+        for (int scan = 0; scan < 32 && !found; ++scan)
+            found = discovery.FindProcess();
+        CHECK(found == child.GetProcessID());
+    }
+
+    void TestCurrentProcess()
+    {
+        CurrentProcessDiscovery discovery;
+        CHECK(discovery.FindProcess() == static_cast<std::uint32_t>(getpid()));
+        std::vector<std::uint32_t> processIDs;
+        discovery.FindProcesses(processIDs);
+        CHECK(processIDs == std::vector<std::uint32_t>{static_cast<std::uint32_t>(getpid())});
+        CHECK(discovery.GetNameLookupCount() == 0);
+    }
+} // namespace
+
+int main()
+{
+    TestNotRunning();
+    TestFindsInstances();
+    TestExecInPlace();
+    TestCurrentProcess();
+    return Finish("ProcessDiscoveryTest");
+}
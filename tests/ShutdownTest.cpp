@@ -0,0 +1,118 @@
+#include <DSREquipmentSwap/Bootstrap.h>
+#include <DSREquipmentSwap/WakeSignal.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using namespace DSREquipmentSwap;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Shutdown must finish within this, measured as the median of `TRIAL_COUNT` trials (so that one trial descheduled
+    // by a busy machine does not fail the test).
+    constexpr auto MAX_STOP_TIME = std::chrono::microseconds(1000);
+    constexpr int TRIAL_COUNT = 15;
+
+    // Much longer than any interval of the swapper loop, so a wait that is not ended by the stop request is obvious.
+    constexpr auto LOOP_WAIT = std::chrono::milliseconds(60'000);
+
+    /// @brief Stop and wait of `EquipmentSwapper::Run()`, without the game: `RequestStop()` is the swapper's own.
+    class FakeSwapperLoop
+    {
+    public:
+        void Run()
+        {
+            m_isWaiting = true;
+            while (!m_stopFlag.load())
+                m_wakeSignal.WaitFor(LOOP_WAIT);
+            m_wokeTime = Clock::now();
+        }
+
+        void RequestStop()
+        {
+            m_stopFlag = true;
+            m_wakeSignal.Notify();
+        }
+
+        [[nodiscard]] bool IsWaiting() const { return m_isWaiting.load(); }
+        [[nodiscard]] Clock::time_point GetWokeTime() const { return m_wokeTime; }
+
+    private:
+        WakeSignal m_wakeSignal;
+        std::atomic<bool> m_stopFlag = false;
+        std::atomic<bool> m_isWaiting = false;
+        Clock::time_point m_wokeTime;
+    };
+
+    std::chrono::microseconds Median(std::array<std::chrono::microseconds, TRIAL_COUNT> times)
+    {
+        std::ranges::sort(times);
+        return times[TRIAL_COUNT / 2];
+    }
+
+    bool Check(const char* name, const std::chrono::microseconds time)
+    {
+        const bool isPassed = time <= MAX_STOP_TIME;
+        std::printf(
+            "%s: %s: %lld us (max %lld us)\n",
+            isPassed ? "PASS" : "FAIL",
+            name,
+            static_cast<long long>(time.count()),
+            static_cast<long long>(MAX_STOP_TIME.count()));
+        return isPassed;
+    }
+
+    /// @brief Time from `RequestStop()` to the loop's `WaitFor()` returning.
+    std::chrono::microseconds TimeWakeAfterStop()
+    {
+        FakeSwapperLoop loop;
+        std::thread thread([&loop] { loop.Run(); });
+        while (!loop.IsWaiting())
+            std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2)); // let it block in `WaitFor()`
+
+        const Clock::time_point stopTime = Clock::now();
+        loop.RequestStop();
+        thread.join();
+        return std::chrono::duration_cast<std::chrono::microseconds>(loop.GetWokeTime() - stopTime);
+    }
+
+    /// @brief Time taken by `Bootstrap::Stop()` (stop request and join) while the loop is running.
+    std::chrono::microseconds TimeBootstrapStop()
+    {
+        FakeSwapperLoop loop;
+        Bootstrap bootstrap;
+        bootstrap.Start({[] { return true; }, [&loop] { loop.Run(); }, [&loop] { loop.RequestStop(); }});
+        while (!bootstrap.IsReady() || !loop.IsWaiting())
+            std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        const Clock::time_point stopTime = Clock::now();
+        bootstrap.Stop();
+        const auto time = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - stopTime);
+        if (bootstrap.GetState() != BootstrapState::STOPPED)
+            std::printf("FAIL: bootstrap is '%s' after Stop()\n", GetBootstrapStateName(bootstrap.GetState()));
+        return bootstrap.GetState() == BootstrapState::STOPPED ? time : std::chrono::microseconds::max();
+    }
+} // namespace
+
+int main()
+{
+    std::array<std::chrono::microseconds, TRIAL_COUNT> wakeTimes = {};
+    std::array<std::chrono::microseconds, TRIAL_COUNT> stopTimes = {};
+    for (int i = 0; i < TRIAL_COUNT; ++i)
+    {
+        wakeTimes[i] = TimeWakeAfterStop();
+        stopTimes[i] = TimeBootstrapStop();
+    }
+
+    bool isPassed = Check("RequestStop() to WakeSignal::WaitFor() return", Median(wakeTimes));
+    isPassed &= Check("Bootstrap::Stop() while running", Median(stopTimes));
+    return isPassed ? 0 : 1;
+}
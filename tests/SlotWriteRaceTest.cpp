@@ -0,0 +1,174 @@
+#include "FakeGame.h"
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/DeferredLog.h>
+#include <DSREquipmentSwap/LoadoutTable.h>
+#include <DSREquipmentSwap/SlotAccess.h>
+#include <DSREquipmentSwap/SlotSwapper.h>
+#include <DSREquipmentSwap/SpEffectDeltas.h>
+#include <DSREquipmentSwap/TimerWheel.h>
+#include <DSREquipmentSwap/TriggerTable.h>
+
+#include <vector>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    int& GetSlot(const EquipSlot slot)
+    {
+        return GetFakeGame().paramIDs[static_cast<int>(slot)];
+    }
+
+    /// @brief The game changes the slot between `WriteSlotChecked()`'s re-read and its write, or right after it.
+    void TestWriteSlotChecked()
+    {
+        GetFakeGame() = {};
+        const FirelinkDSR::DSRPlayer player;
+        SlotWriteRaceStats stats;
+
+        // No race: written once.
+        GetSlot(EquipSlot::HEAD) = 5000;
+        CHECK(WriteSlotChecked(player, EquipSlot::HEAD, 5000, 6000, stats) == SlotWriteResult::WRITTEN);
+        CHECK(GetSlot(EquipSlot::HEAD) == 6000 && GetFakeGame().writeCount == 1);
+        CHECK(stats.preWriteRaces == 0 && stats.postWriteRaces == 0 && stats.retries == 0);
+
+        // The game equips something else before our write: the check fails, nothing is written.
+        GetSlot(EquipSlot::HEAD) = 5000;
+        GetFakeGame().writeCount = 0;
+        GetFakeGame().onRead = [](const EquipSlot slot) { GetSlot(slot) = 7000; };
+        CHECK(WriteSlotChecked(player, EquipSlot::HEAD, 5000, 6000, stats) == SlotWriteResult::RACED);
+        CHECK(GetSlot(EquipSlot::HEAD) == 7000 && GetFakeGame().writeCount == 0);
+        CHECK(stats.preWriteRaces == 1);
+        GetFakeGame().onRead = nullptr;
+
+        // The game undoes our write once: retried, and written.
+        GetSlot(EquipSlot::HEAD) = 5000;
+        int undoCount = 1;
+        GetFakeGame().onWrite = [&undoCount](const EquipSlot slot)
+        {
+            if (undoCount-- > 0)
+                GetSlot(slot) = 5000;
+        };
+        CHECK(WriteSlotChecked(player, EquipSlot::HEAD, 5000, 6000, stats) == SlotWriteResult::WRITTEN);
+        CHECK(GetSlot(EquipSlot::HEAD) == 6000);
+        CHECK(stats.retries == 1 && stats.postWriteRaces == 0);
+
+        // The game always undoes it: a bounded number of attempts.
+        GetSlot(EquipSlot::HEAD) = 5000;
+        GetFakeGame().writeCount = 0;
+        GetFakeGame().onWrite = [](const EquipSlot slot) { GetSlot(slot) = 5000; };
+        CHECK(WriteSlotChecked(player, EquipSlot::HEAD, 5000, 6000, stats) == SlotWriteResult::RACED);
+        CHECK(GetSlot(EquipSlot::HEAD) == 5000 && GetFakeGame().writeCount == SLOT_WRITE_MAX_ATTEMPTS);
+        CHECK(stats.postWriteRaces == 1 && stats.retries == 1 + (SLOT_WRITE_MAX_ATTEMPTS - 1));
+
+        // The game equips something else right after our write: the game's ID is kept.
+        GetSlot(EquipSlot::HEAD) = 5000;
+        GetFakeGame().onWrite = [](const EquipSlot slot) { GetSlot(slot) = 8000; };
+        CHECK(WriteSlotChecked(player, EquipSlot::HEAD, 5000, 6000, stats) == SlotWriteResult::RACED);
+        CHECK(GetSlot(EquipSlot::HEAD) == 8000 && stats.postWriteRaces == 2);
+        GetFakeGame().onWrite = nullptr;
+
+        // The write itself fails.
+        GetSlot(EquipSlot::HEAD) = 5000;
+        GetFakeGame().isWriteFailing = true;
+        CHECK(WriteSlotChecked(player, EquipSlot::HEAD, 5000, 6000, stats) == SlotWriteResult::FAILED);
+        CHECK(GetSlot(EquipSlot::HEAD) == 5000);
+    }
+
+    /// @brief A trigger whose slot changed since the snapshot is not swapped, not consumed, and fires later.
+    void TestTriggerSwapRace()
+    {
+        GetFakeGame() = {};
+        const FirelinkDSR::DSRPlayer player;
+        EquipmentSwapConfig config;
+        config.headArmorTriggers.push_back(SwapTriggerConfig{77, 5000, -1, 6000, true, false});
+        ManualTimerClock clock;
+        TriggerTable triggers(config, clock);
+        DeferredLog log;
+        SlotSwapper swapper(log, 500, clock);
+        std::vector<int> abortedSpEffects;
+
+        GetSlot(EquipSlot::HEAD) = 5000;
+        PlayerSnapshot snapshot;
+        ReadPlayerSnapshot(player, SlotMask().set(), snapshot);
+        snapshot.activeSpEffects = {77};
+        GetSlot(EquipSlot::HEAD) = 7000; // menu equip between the snapshot and the write
+        CHECK(swapper.CheckSwapTriggers(0, player, snapshot, triggers, abortedSpEffects) == 0);
+        CHECK(GetSlot(EquipSlot::HEAD) == 7000 && !swapper.GetTempSwap(0, EquipSlot::HEAD));
+        CHECK(swapper.GetWriteRaceStats().preWriteRaces == 1);
+        CHECK(snapshot.GetParamID(EquipSlot::HEAD) == 5000);
+        CHECK(abortedSpEffects == std::vector{77}); // for a retry
+        CHECK(triggers.GetCooldown(0, 0) == 0); // cooldown not started
+
+        // Back to the trigger's ID: the same trigger fires on the next evaluation.
+        GetSlot(EquipSlot::HEAD) = 5000;
+        abortedSpEffects.clear();
+        CHECK(swapper.CheckSwapTriggers(0, player, snapshot, triggers, abortedSpEffects) == 1);
+        CHECK(GetSlot(EquipSlot::HEAD) == 6000 && swapper.GetTempSwap(0, EquipSlot::HEAD));
+        CHECK(abortedSpEffects.empty() && triggers.GetCooldown(0, 0) > 0);
+        log.Flush();
+    }
+
+    /// @brief A rising-edge SpEffect whose swap was not written rises again once forgotten.
+    void TestForgottenSpEffectRises()
+    {
+        SpEffectDeltaTracker deltas({77});
+        std::vector<int> rising;
+        std::vector<int> falling;
+        deltas.Update(0, std::vector{77}, false, rising, falling);
+        CHECK(rising == std::vector{77});
+        deltas.Update(0, std::vector{77}, false, rising, falling);
+        CHECK(rising.empty());
+        deltas.Forget(0, 77);
+        deltas.Update(0, std::vector{77}, false, rising, falling);
+        CHECK(rising == std::vector{77});
+    }
+
+    /// @brief A loadout whose second slot races is rolled back as a unit.
+    void TestLoadoutRace()
+    {
+        GetFakeGame() = {};
+        const FirelinkDSR::DSRPlayer player;
+        EquipmentSwapConfig config;
+        LoadoutConfig loadout;
+        loadout.name = "Race";
+        loadout.spEffectIDTrigger = 88;
+        loadout.targets = {{"headArmor", 1}, {"bodyArmor", 2}};
+        config.loadouts.push_back(loadout);
+        ManualTimerClock clock;
+        LoadoutTable loadouts(config, clock);
+        DeferredLog log;
+        SlotSwapper swapper(log, 0, clock);
+        std::vector<int> abortedSpEffects;
+
+        GetSlot(EquipSlot::HEAD) = 10;
+        GetSlot(EquipSlot::BODY) = 20;
+        PlayerSnapshot snapshot;
+        ReadPlayerSnapshot(player, SlotMask().set(), snapshot);
+        snapshot.activeSpEffects = {88};
+        GetSlot(EquipSlot::BODY) = 21;
+        CHECK(swapper.ApplyLoadouts(0, player, snapshot, loadouts, abortedSpEffects) == 0);
+        CHECK(abortedSpEffects == std::vector{88});
+        CHECK(GetSlot(EquipSlot::HEAD) == 10 && GetSlot(EquipSlot::BODY) == 21);
+        CHECK(!swapper.GetTempLoadout(0));
+
+        // Without the race, the whole loadout is written.
+        ReadPlayerSnapshot(player, SlotMask().set(), snapshot);
+        abortedSpEffects.clear();
+        CHECK(swapper.ApplyLoadouts(0, player, snapshot, loadouts, abortedSpEffects) == 1);
+        CHECK(GetSlot(EquipSlot::HEAD) == 1 && GetSlot(EquipSlot::BODY) == 2 && abortedSpEffects.empty());
+        log.Flush();
+    }
+} // namespace
+
+int main()
+{
+    TestWriteSlotChecked();
+    TestTriggerSwapRace();
+    TestForgottenSpEffectRises();
+    TestLoadoutRace();
+    return Finish("SlotWriteRaceTest");
+}
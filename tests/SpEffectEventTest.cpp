@@ -0,0 +1,123 @@
+#include "FakeGame.h"
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/Config.h>
+#include <DSREquipmentSwap/EquipmentSwapper.h>
+#include <DSREquipmentSwap/SpEffectEvents.h>
+
+#include <Firelink/Process.h>
+
+#include <memory>
+#include <string>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    constexpr int TRIGGER_SP_EFFECT_ID = 77;
+    constexpr int CONDITION_SP_EFFECT_ID = 99;
+    constexpr int SOURCE_PARAM_ID = 5000;
+    constexpr int TARGET_PARAM_ID = 6000;
+
+    /// @brief Event source pushed to by the test itself.
+    class TestSpEffectEventSource final : public SpEffectEventSource
+    {
+    public:
+        bool Start(SpEffectEventQueue& queue) override
+        {
+            m_queue = &queue;
+            return true;
+        }
+
+        void Stop() override { m_queue = nullptr; }
+
+        [[nodiscard]] std::string GetName() const override { return "Test"; }
+
+        void Push(const int spEffectID) const
+        {
+            CHECK(m_queue && m_queue->Push(0, spEffectID));
+        }
+
+    private:
+        SpEffectEventQueue* m_queue = nullptr;
+    };
+
+    /// @brief Swapper whose only trigger (on the host's head armor) needs another SpEffect to be active too.
+    EquipmentSwapConfig MakeConfig()
+    {
+        EquipmentSwapConfig config;
+        config.hookConfig.eventDrivenSpEffects = true;
+        config.hookConfig.spEffectRisingEdge = true;
+        config.hookConfig.swapJournalPath.clear();
+        SwapTriggerConfig trigger{TRIGGER_SP_EFFECT_ID, SOURCE_PARAM_ID, -1, TARGET_PARAM_ID, true, true};
+        trigger.condition = "spEffect(" + std::to_string(CONDITION_SP_EFFECT_ID) + ")";
+        config.headArmorTriggers.push_back(trigger);
+        return config;
+    }
+
+    int GetHeadParamID()
+    {
+        return GetFakeGame().paramIDs[static_cast<int>(EquipSlot::HEAD)];
+    }
+
+    void TestSwitchToEvents()
+    {
+        GetFakeGame() = {};
+        GetFakeGame().paramIDs[static_cast<int>(EquipSlot::HEAD)] = SOURCE_PARAM_ID;
+
+        EquipmentSwapper swapper(MakeConfig());
+        auto eventSource = std::make_unique<TestSpEffectEventSource>();
+        const TestSpEffectEventSource& events = *eventSource;
+        swapper.SetSpEffectEventSource(std::move(eventSource));
+        swapper.Attach(std::make_unique<Firelink::ManagedProcess>(1, nullptr));
+
+        // Polled until the first event: the condition's SpEffect is held.
+        GetFakeGame().activeSpEffects = {CONDITION_SP_EFFECT_ID};
+        CHECK(swapper.Tick().has_value());
+        CHECK(swapper.Tick().has_value());
+        CHECK(GetHeadParamID() == SOURCE_PARAM_ID);
+
+        // The condition's SpEffect ends, then events take over. The last polled list must not satisfy the condition.
+        GetFakeGame().activeSpEffects = {TRIGGER_SP_EFFECT_ID};
+        events.Push(TRIGGER_SP_EFFECT_ID);
+        CHECK(swapper.Tick().has_value());
+        CHECK(GetHeadParamID() == SOURCE_PARAM_ID);
+
+        // Nor on later event updates, whatever is still polled (nothing is).
+        GetFakeGame().activeSpEffects = {TRIGGER_SP_EFFECT_ID, CONDITION_SP_EFFECT_ID};
+        events.Push(TRIGGER_SP_EFFECT_ID);
+        CHECK(swapper.Tick().has_value());
+        CHECK(GetHeadParamID() == SOURCE_PARAM_ID);
+
+        // Conditions see the SpEffects of the same update's events.
+        events.Push(CONDITION_SP_EFFECT_ID);
+        events.Push(TRIGGER_SP_EFFECT_ID);
+        CHECK(swapper.Tick().has_value());
+        CHECK(GetHeadParamID() == TARGET_PARAM_ID);
+    }
+
+    void TestPollingUntilFirstEvent()
+    {
+        GetFakeGame() = {};
+        GetFakeGame().paramIDs[static_cast<int>(EquipSlot::HEAD)] = SOURCE_PARAM_ID;
+
+        EquipmentSwapper swapper(MakeConfig());
+        swapper.SetSpEffectEventSource(std::make_unique<TestSpEffectEventSource>());
+        swapper.Attach(std::make_unique<Firelink::ManagedProcess>(1, nullptr));
+
+        // No event yet: still polling, and conditions see every held SpEffect.
+        GetFakeGame().activeSpEffects = {CONDITION_SP_EFFECT_ID};
+        CHECK(swapper.Tick().has_value());
+        GetFakeGame().activeSpEffects = {CONDITION_SP_EFFECT_ID, TRIGGER_SP_EFFECT_ID};
+        CHECK(swapper.Tick().has_value());
+        CHECK(GetHeadParamID() == TARGET_PARAM_ID);
+    }
+} // namespace
+
+int main()
+{
+    TestSwitchToEvents();
+    TestPollingUntilFirstEvent();
+    return Finish("SpEffectEventTest");
+}
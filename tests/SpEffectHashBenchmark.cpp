@@ -0,0 +1,119 @@
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/SpEffectHash.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    constexpr int LOOKUP_COUNT = 4'000'000;
+
+    /// @brief Share of looked-up IDs that some trigger reacts to. Most active SpEffects (buffs, ambient effects,
+    /// other players' items) have no trigger, so lookups mostly miss.
+    constexpr int HIT_PERCENT = 10;
+
+    /// @brief The sorted alternative: keys with `lower_bound`, and trigger lists laid out like the hash's.
+    struct SortedLists
+    {
+        std::vector<std::int32_t> keys;
+        std::vector<std::uint32_t> listStarts;
+        std::vector<std::uint32_t> triggerIndices;
+
+        explicit SortedLists(const std::vector<std::int32_t>& triggerIDs)
+        {
+            std::vector<std::pair<std::int32_t, std::uint32_t>> pairs;
+            for (std::uint32_t i = 0; i < triggerIDs.size(); ++i)
+                pairs.emplace_back(triggerIDs[i], i);
+            std::ranges::sort(pairs);
+            for (const auto& [id, triggerIndex] : pairs)
+            {
+                if (keys.empty() || keys.back() != id)
+                {
+                    keys.push_back(id);
+                    listStarts.push_back(static_cast<std::uint32_t>(triggerIndices.size()));
+                }
+                triggerIndices.push_back(triggerIndex);
+            }
+            listStarts.push_back(static_cast<std::uint32_t>(triggerIndices.size()));
+        }
+
+        [[nodiscard]] std::size_t FindCount(const std::int32_t id) const
+        {
+            const auto it = std::ranges::lower_bound(keys, id);
+            if (it == keys.end() || *it != id)
+                return 0;
+            const auto cell = static_cast<std::size_t>(it - keys.begin());
+            return listStarts[cell + 1] - listStarts[cell];
+        }
+    };
+
+    template <typename Lookup>
+    std::size_t Time(const char* name, const std::vector<std::int32_t>& lookups, Lookup lookup)
+    {
+        std::size_t foundCount = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < LOOKUP_COUNT; ++i)
+            foundCount += lookup(lookups[i % lookups.size()]);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        std::printf("  %-20s %6.2f ns per lookup\n", name,
+            std::chrono::duration<double, std::nano>(elapsed).count() / LOOKUP_COUNT);
+        return foundCount;
+    }
+
+    void Run(const int keyCount)
+    {
+        std::mt19937 random(static_cast<std::uint32_t>(keyCount));
+        std::vector<std::int32_t> triggerIDs;
+        for (int i = 0; i < keyCount; ++i)
+            triggerIDs.push_back(1000 + static_cast<std::int32_t>(random() % 10'000'000));
+
+        std::vector<std::int32_t> lookups;
+        for (int i = 0; i < 4096; ++i)
+        {
+            lookups.push_back(static_cast<int>(random() % 100) < HIT_PERCENT
+                ? triggerIDs[random() % triggerIDs.size()]
+                : 1000 + static_cast<std::int32_t>(random() % 10'000'000));
+        }
+
+        const SpEffectHash hash = SpEffectHash::Build(triggerIDs);
+        std::unordered_map<std::int32_t, std::vector<std::uint32_t>> map;
+        for (std::uint32_t i = 0; i < triggerIDs.size(); ++i)
+            map[triggerIDs[i]].push_back(i);
+        const SortedLists sorted(triggerIDs);
+
+        std::printf("%d triggers (%d%% hits):\n", keyCount, HIT_PERCENT);
+        const std::size_t hashCount = Time("SpEffectHash", lookups, [&hash](const std::int32_t id)
+        {
+            return hash.Find(id).size();
+        });
+        const std::size_t mapCount = Time("std::unordered_map", lookups, [&map](const std::int32_t id)
+        {
+            const auto it = map.find(id);
+            return it == map.end() ? std::size_t{0} : it->second.size();
+        });
+        const std::size_t sortedCount = Time("sorted vector", lookups, [&sorted](const std::int32_t id)
+        {
+            return sorted.FindCount(id);
+        });
+        CHECK(hashCount > 0 && hashCount == mapCount && hashCount == sortedCount);
+    }
+} // namespace
+
+/// @brief Time of one SpEffect lookup in the trigger hash, next to `std::unordered_map` and a sorted vector with the
+/// same trigger lists. Not a pass/fail threshold; it only fails if they find different triggers.
+int main()
+{
+    for (const int keyCount : {16, 128, 1024, 8192})
+        Run(keyCount);
+    return Finish("SpEffectHashBenchmark");
+}
@@ -0,0 +1,150 @@
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/SpEffectHash.h>
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <span>
+#include <vector>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    constexpr std::int32_t INT32_MIN_ID = std::numeric_limits<std::int32_t>::min();
+    constexpr std::int32_t INT32_MAX_ID = std::numeric_limits<std::int32_t>::max();
+
+    /// @brief Trigger indices per SpEffect ID, as the hash should have them (in trigger order).
+    std::map<std::int32_t, std::vector<std::uint32_t>> GetExpectedLists(const std::vector<std::int32_t>& triggerIDs)
+    {
+        std::map<std::int32_t, std::vector<std::uint32_t>> lists;
+        for (std::uint32_t i = 0; i < triggerIDs.size(); ++i)
+        {
+            if (triggerIDs[i] > 0)
+                lists[triggerIDs[i]].push_back(i);
+        }
+        return lists;
+    }
+
+    bool IsList(const std::span<const std::uint32_t> found, const std::vector<std::uint32_t>& expected)
+    {
+        return std::vector<std::uint32_t>(found.begin(), found.end()) == expected;
+    }
+
+    /// @brief Every present key finds its full list; its neighbours and IDs the hash skips find nothing.
+    void CheckHash(const std::vector<std::int32_t>& triggerIDs)
+    {
+        const SpEffectHash hash = SpEffectHash::Build(triggerIDs);
+        const auto lists = GetExpectedLists(triggerIDs);
+        for (const auto& [id, list] : lists)
+        {
+            CHECK(IsList(hash.Find(id), list));
+            for (const std::int32_t neighbour : {id - 1, id + 1})
+            {
+                if (!lists.contains(neighbour))
+                    CHECK(hash.Find(neighbour).empty());
+            }
+        }
+        for (const std::int32_t skipped : {0, -1, -1000, INT32_MIN_ID})
+            CHECK(hash.Find(skipped).empty());
+    }
+
+    void TestEmpty()
+    {
+        const SpEffectHash empty;
+        CHECK(empty.Find(1).empty() && empty.GetMemoryBytes() == 0);
+
+        // Only "no SpEffect" IDs: nothing is stored.
+        const std::vector<std::int32_t> none = {0, -1, 0, INT32_MIN_ID};
+        const SpEffectHash hash = SpEffectHash::Build(none);
+        CHECK(hash.Find(0).empty() && hash.Find(-1).empty() && hash.Find(1).empty());
+        CHECK(hash.GetView().keys.empty());
+    }
+
+    void TestSmall()
+    {
+        // One key; one key shared by several triggers, between unrelated ones; the ends of the ID range.
+        CheckHash({2100});
+        CheckHash({0, 2100, 33, 2100, -1, 2100, 7});
+        CheckHash({1, INT32_MAX_ID, 0, 1, INT32_MAX_ID - 1});
+
+        const std::vector<std::int32_t> triggerIDs = {0, 2100, 33, 2100, -1, 2100, 7};
+        const SpEffectHash hash = SpEffectHash::Build(triggerIDs);
+        CHECK(IsList(hash.Find(2100), {1, 3, 5}));
+        CHECK(hash.GetView().keys.size() == 3); // one cell per distinct ID
+    }
+
+    void TestAbsentKeys()
+    {
+        // Game-like IDs (clustered, some shared), then every ID around and between them, plus random ones.
+        std::mt19937 random(1);
+        std::vector<std::int32_t> triggerIDs;
+        for (int i = 0; i < 500; ++i)
+            triggerIDs.push_back(i % 7 == 0 ? 0 : 2000 + static_cast<std::int32_t>(random() % 5000));
+        CheckHash(triggerIDs);
+
+        const SpEffectHash hash = SpEffectHash::Build(triggerIDs);
+        const std::set<std::int32_t> present(triggerIDs.begin(), triggerIDs.end());
+        int absentCount = 0;
+        for (std::int32_t id = 1000; id < 8000; ++id)
+        {
+            if (present.contains(id))
+                continue;
+            CHECK(hash.Find(id).empty());
+            ++absentCount;
+        }
+        for (int i = 0; i < 100'000; ++i)
+        {
+            const auto id = static_cast<std::int32_t>(random());
+            if (!present.contains(id))
+                CHECK(hash.Find(id).empty());
+        }
+        for (const std::int32_t id : {INT32_MAX_ID, INT32_MIN_ID, 1, 1 << 16, (1 << 16) + 2000})
+            CHECK(hash.Find(id).empty());
+        CHECK(absentCount > 0);
+
+        // Keys whose low 32 bits are equal after the sign: a negative ID must not match its positive twin.
+        const std::vector<std::int32_t> highBit = {INT32_MAX_ID, 0x40000000};
+        const SpEffectHash highBitHash = SpEffectHash::Build(highBit);
+        CHECK(highBitHash.Find(-INT32_MAX_ID).empty() && highBitHash.Find(-0x40000000).empty());
+    }
+
+    void TestSizes()
+    {
+        // Bucket counts change with size: check each around the keys-per-bucket steps, and a large table.
+        std::mt19937 random(2);
+        for (const int keyCount : {2, 3, 4, 5, 6, 7, 31, 32, 33, 255, 256, 257, 4096})
+        {
+            std::vector<std::int32_t> triggerIDs;
+            for (int i = 0; i < keyCount; ++i)
+                triggerIDs.push_back(1 + static_cast<std::int32_t>(random() % 10'000'000));
+            CheckHash(triggerIDs);
+        }
+    }
+
+    void TestDeterministic()
+    {
+        const std::vector<std::int32_t> triggerIDs = {5, 900, 12, 77777, 5, 3};
+        const SpEffectHash first = SpEffectHash::Build(triggerIDs);
+        const SpEffectHash second = SpEffectHash::Build(triggerIDs);
+        const SpEffectHashView a = first.GetView();
+        const SpEffectHashView b = second.GetView();
+        CHECK(a.multiplier == b.multiplier);
+        CHECK(std::vector(a.pilots.begin(), a.pilots.end()) == std::vector(b.pilots.begin(), b.pilots.end()));
+        CHECK(std::vector(a.keys.begin(), a.keys.end()) == std::vector(b.keys.begin(), b.keys.end()));
+    }
+} // namespace
+
+int main()
+{
+    TestEmpty();
+    TestSmall();
+    TestAbsentKeys();
+    TestSizes();
+    TestDeterministic();
+    return Finish("SpEffectHashTest");
+}
@@ -0,0 +1,149 @@
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/MemoryBackend.h>
+#include <DSREquipmentSwap/SpEffectListReader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    constexpr int REPEAT_COUNT = 2000;
+
+    /// @brief A list node as the game's pool lays it out: the fields the reader needs, among others.
+    struct Node
+    {
+        std::byte header[8];
+        std::int32_t spEffectID;
+        float remainingTime;
+        std::byte flags[8];
+        Node* next;
+        std::byte rest[0x60];
+    };
+
+    /// @brief Enough nodes for the longest list, spread over pages (about 13 pages of 0x80-byte nodes).
+    constexpr std::size_t POOL_SIZE = 416;
+
+    /// @brief Stands in for PlayerIns: the list head is at `HEAD_OFFSET`.
+    constexpr int HEAD_OFFSET = 0x40;
+    struct Owner
+    {
+        std::byte fields[HEAD_OFFSET];
+        Node* head;
+    };
+
+    SpEffectListConfig GetConfig(const int maxNodesPerUpdate)
+    {
+        SpEffectListConfig config;
+        config.headPointerPath = {HEAD_OFFSET};
+        config.nodeIDOffset = offsetof(Node, spEffectID);
+        config.nodeNextOffset = offsetof(Node, next);
+        config.nodeSize = offsetof(Node, next) + sizeof(Node*);
+        config.maxNodesPerUpdate = maxNodesPerUpdate;
+        return config;
+    }
+
+    /// @brief What `GetPlayerActiveSpEffects()` does: one read for the ID and one for the next pointer per node.
+    bool ReadPerNode(const MemoryBackend& memory, const Owner& owner, std::vector<int>& spEffectIDs, int& readCount)
+    {
+        spEffectIDs.clear();
+        readCount = 1;
+        std::uint64_t node = 0;
+        if (!memory.Read(reinterpret_cast<std::uintptr_t>(&owner) + HEAD_OFFSET, node))
+            return false;
+        while (node != 0)
+        {
+            std::int32_t spEffectID = 0;
+            readCount += 2;
+            if (!memory.Read(node + offsetof(Node, spEffectID), spEffectID)
+                || !memory.Read(node + offsetof(Node, next), node))
+                return false;
+            spEffectIDs.push_back(spEffectID);
+        }
+        return true;
+    }
+
+    double GetUsPerList(const std::chrono::steady_clock::duration elapsed)
+    {
+        return std::chrono::duration<double, std::micro>(elapsed).count() / REPEAT_COUNT;
+    }
+} // namespace
+
+/// @brief Time to read a player's SpEffect list of 0 to 256 nodes, scattered over a node pool, from another process's
+/// point of view (every backend read is a syscall). Not a pass/fail threshold; it only fails if a reader gets the wrong
+/// IDs, or the early stop and node budget do not hold.
+int main()
+{
+    const MemoryBackend memory(reinterpret_cast<void*>(static_cast<std::intptr_t>(getpid())));
+    std::vector<Node> pool(POOL_SIZE);
+    std::vector<std::size_t> order(POOL_SIZE);
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::shuffle(order, std::mt19937(1)); // list order has nothing to do with pool order
+
+    const std::vector<int> absentTriggerIDs = {999'999}; // never active: the whole list is walked
+    std::printf("Nodes | page reader: reads, us | per node: reads, us | early stop: nodes | budget 128: nodes\n");
+    for (const int nodeCount : {0, 1, 8, 32, 64, 128, 256})
+    {
+        Owner owner = {};
+        std::vector<int> expectedIDs;
+        for (int i = nodeCount - 1; i >= 0; --i)
+        {
+            Node& node = pool[order[i]];
+            node.spEffectID = 1000 + i;
+            node.next = owner.head;
+            owner.head = &node;
+        }
+        for (int i = 0; i < nodeCount; ++i)
+            expectedIDs.push_back(1000 + i);
+        const auto ownerAddress = reinterpret_cast<std::uintptr_t>(&owner);
+
+        SpEffectListReader reader(GetConfig(256), absentTriggerIDs);
+        std::vector<int> spEffectIDs;
+        bool isRead = true;
+        const auto pageStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < REPEAT_COUNT; ++i)
+            isRead &= reader.Read(memory, ownerAddress, spEffectIDs);
+        const auto pageElapsed = std::chrono::steady_clock::now() - pageStart;
+        CHECK(isRead && spEffectIDs == expectedIDs && reader.GetLastNodeCount() == nodeCount);
+
+        int perNodeReadCount = 0;
+        const auto perNodeStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < REPEAT_COUNT; ++i)
+            isRead &= ReadPerNode(memory, owner, spEffectIDs, perNodeReadCount);
+        const auto perNodeElapsed = std::chrono::steady_clock::now() - perNodeStart;
+        CHECK(isRead && spEffectIDs == expectedIDs);
+
+        // The only trigger SpEffect is halfway down the list: the rest is not read.
+        const int middleID = 1000 + nodeCount / 2;
+        SpEffectListReader earlyStopReader(GetConfig(256), {middleID});
+        CHECK(earlyStopReader.Read(memory, ownerAddress, spEffectIDs));
+        CHECK(earlyStopReader.GetLastNodeCount() == (nodeCount == 0 ? 0 : nodeCount / 2 + 1));
+
+        SpEffectListReader budgetReader(GetConfig(128), absentTriggerIDs);
+        CHECK(budgetReader.Read(memory, ownerAddress, spEffectIDs));
+        CHECK(budgetReader.GetLastNodeCount() == std::min(nodeCount, 128));
+        CHECK(budgetReader.WasLastTruncated() == (nodeCount > 128));
+
+        std::printf(
+            "%5d | %11d, %6.2f | %8d, %6.2f | %17d | %16d\n",
+            nodeCount,
+            reader.GetLastReadCount(),
+            GetUsPerList(pageElapsed),
+            perNodeReadCount,
+            GetUsPerList(perNodeElapsed),
+            earlyStopReader.GetLastNodeCount(),
+            budgetReader.GetLastNodeCount());
+    }
+    return Finish("SpEffectListBenchmark");
+}
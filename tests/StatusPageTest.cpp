@@ -0,0 +1,229 @@
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/StatusPage.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+// POSIX shared memory only: the Windows file mapping path is the same code around another mapping call.
+
+namespace
+{
+    /// @brief Name unique to this test run, so parallel runs do not share a page.
+    std::string GetPageName(const char* suffix)
+    {
+        return "DSREquipmentSwapStatusPageTest" + std::to_string(getpid()) + suffix;
+    }
+
+    /// @brief Writable mapping of an existing page, to play a writer that `SharedStatusPage` would never be.
+    class RawPage
+    {
+    public:
+        explicit RawPage(const std::string& name)
+        {
+            const int fd = shm_open(("/" + name).c_str(), O_RDWR, 0);
+            if (fd < 0)
+                return;
+            void* view = mmap(nullptr, sizeof(StatusPageBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (view != MAP_FAILED)
+                m_block = static_cast<StatusPageBlock*>(view);
+        }
+
+        ~RawPage()
+        {
+            if (m_block)
+                munmap(m_block, sizeof(StatusPageBlock));
+        }
+
+        RawPage(const RawPage&) = delete;
+        RawPage& operator=(const RawPage&) = delete;
+
+        [[nodiscard]] StatusPageBlock* Get() const { return m_block; }
+
+    private:
+        StatusPageBlock* m_block = nullptr;
+    };
+
+    /// @brief The layout is shared with readers built separately (other tools, other languages): it must not move.
+    void TestLayout()
+    {
+        CHECK(offsetof(StatusPageBlock, magic) == 0);
+        CHECK(offsetof(StatusPageBlock, version) == 4);
+        CHECK(offsetof(StatusPageBlock, payloadSize) == 8);
+        CHECK(offsetof(StatusPageBlock, sequence) == 12);
+        CHECK(offsetof(StatusPageBlock, status) == 16);
+
+        CHECK(offsetof(SwapperStatus, tick) == 0);
+        CHECK(offsetof(SwapperStatus, publishTimeUs) == 8);
+        CHECK(offsetof(SwapperStatus, gameLoaded) == 16);
+        CHECK(offsetof(SwapperStatus, connectedPlayerMask) == 18);
+        CHECK(offsetof(SwapperStatus, monitorIntervalMs) == 20);
+        CHECK(offsetof(SwapperStatus, tempSwaps) == 24);
+        CHECK(sizeof(StatusTempSwap) == 12);
+        CHECK(offsetof(SwapperStatus, triggerCount) == 24 + sizeof(SwapperStatus::tempSwaps));
+        CHECK(offsetof(SwapperStatus, cooldownDeadlinesUs) % 8 == 0);
+        CHECK(offsetof(SwapperStatus, ticks) == offsetof(SwapperStatus, cooldownDeadlinesUs) + 256 * 4 * 8);
+        CHECK(sizeof(SwapperStatus) == offsetof(SwapperStatus, ticks) + 7 * 8);
+    }
+
+    void TestCreateAndOpen()
+    {
+        const std::string name = GetPageName("Open");
+        CHECK(!SharedStatusPage::Open(name)); // does not exist yet
+
+        auto writer = SharedStatusPage::Create(name);
+        CHECK(writer != nullptr);
+        if (!writer)
+            return;
+        {
+            const RawPage raw(name);
+            CHECK(raw.Get() != nullptr);
+            if (raw.Get())
+            {
+                CHECK(raw.Get()->magic == STATUS_PAGE_MAGIC && raw.Get()->version == STATUS_PAGE_VERSION);
+                CHECK(raw.Get()->payloadSize == sizeof(SwapperStatus) && raw.Get()->sequence.load() == 0);
+            }
+        }
+
+        // An open page sees everything published later, through its own mapping.
+        auto reader = SharedStatusPage::Open(name);
+        CHECK(reader != nullptr);
+        if (!reader)
+            return;
+        SwapperStatus status = {};
+        CHECK(reader->TryRead(status) && status.tick == 0);
+
+        SwapperStatus published = {};
+        published.tick = 42;
+        published.gameLoaded = 1;
+        published.connectedPlayerMask = 0b101;
+        published.tempSwaps[2][static_cast<int>(EquipSlot::RING_1)] = {1, 100, 200};
+        published.triggerCount = 3;
+        published.cooldownDeadlinesUs[STATUS_PAGE_MAX_TRIGGERS - 1][STATUS_PAGE_MAX_PLAYERS - 1] = 123456;
+        published.spEffectEventsDropped = 7;
+        writer->Publish(published);
+        CHECK(reader->TryRead(status));
+        CHECK(status.tick == 42 && status.gameLoaded == 1 && status.connectedPlayerMask == 0b101);
+        CHECK(status.tempSwaps[2][static_cast<int>(EquipSlot::RING_1)].destParamID == 200);
+        CHECK(status.cooldownDeadlinesUs[STATUS_PAGE_MAX_TRIGGERS - 1][STATUS_PAGE_MAX_PLAYERS - 1] == 123456);
+        CHECK(status.spEffectEventsDropped == 7);
+
+        // A second reader of the same page, and a writer that reopens it (e.g. after a reload), which starts clean.
+        auto secondReader = SharedStatusPage::Open(name);
+        CHECK(secondReader && secondReader->TryRead(status) && status.tick == 42);
+        writer.reset(); // the creator removes the name; open mappings stay valid
+        CHECK(!SharedStatusPage::Open(name));
+        CHECK(reader->TryRead(status) && status.tick == 42);
+
+        writer = SharedStatusPage::Create(name);
+        CHECK(writer && SharedStatusPage::Open(name));
+    }
+
+    void TestRejectsOtherLayouts()
+    {
+        const std::string name = GetPageName("Layout");
+        const auto writer = SharedStatusPage::Create(name);
+        CHECK(writer != nullptr);
+        const RawPage raw(name);
+        if (!writer || !raw.Get())
+            return;
+
+        raw.Get()->version = STATUS_PAGE_VERSION + 1;
+        CHECK(!SharedStatusPage::Open(name));
+        raw.Get()->version = STATUS_PAGE_VERSION;
+        raw.Get()->payloadSize = sizeof(SwapperStatus) - 8;
+        CHECK(!SharedStatusPage::Open(name));
+        raw.Get()->payloadSize = sizeof(SwapperStatus);
+        raw.Get()->magic = 0;
+        CHECK(!SharedStatusPage::Open(name));
+        raw.Get()->magic = STATUS_PAGE_MAGIC;
+        CHECK(SharedStatusPage::Open(name) != nullptr);
+    }
+
+    void TestSeqlock()
+    {
+        const std::string name = GetPageName("Seqlock");
+        const auto writer = SharedStatusPage::Create(name);
+        const auto reader = SharedStatusPage::Open(name);
+        CHECK(writer && reader);
+        if (!writer || !reader)
+            return;
+
+        // A write in progress (odd sequence) is never read.
+        {
+            const RawPage raw(name);
+            CHECK(raw.Get() != nullptr);
+            if (raw.Get())
+            {
+                SwapperStatus status = {};
+                raw.Get()->sequence.store(1);
+                CHECK(!reader->TryRead(status, 8));
+                raw.Get()->sequence.store(2);
+                CHECK(reader->TryRead(status, 8));
+            }
+        }
+
+        // Every copy a reader gets while the writer keeps publishing is one whole status: fields at both ends of the
+        // payload always come from the same publication.
+        constexpr std::uint64_t PUBLISH_COUNT = 200'000;
+        std::atomic<bool> isDone = false;
+        std::thread writerThread(
+            [&]
+            {
+                SwapperStatus status = {};
+                for (std::uint64_t i = 1; i <= PUBLISH_COUNT; ++i)
+                {
+                    status.tick = i;
+                    status.cooldownDeadlinesUs[100][2] = static_cast<std::int64_t>(i);
+                    status.spEffectEventsDropped = i;
+                    writer->Publish(status);
+                }
+                isDone = true;
+            });
+
+        std::uint64_t readCount = 0;
+        std::uint64_t tornCount = 0;
+        std::uint64_t lastTick = 0;
+        bool isMonotonic = true;
+        while (!isDone.load())
+        {
+            SwapperStatus status;
+            if (!reader->TryRead(status))
+                continue;
+            ++readCount;
+            if (status.tick != status.spEffectEventsDropped
+                || static_cast<std::int64_t>(status.tick) != status.cooldownDeadlinesUs[100][2])
+                ++tornCount;
+            isMonotonic &= status.tick >= lastTick;
+            lastTick = status.tick;
+        }
+        writerThread.join();
+
+        SwapperStatus status;
+        CHECK(reader->TryRead(status) && status.tick == PUBLISH_COUNT);
+        CHECK(readCount > 0 && tornCount == 0 && isMonotonic);
+        if (tornCount != 0)
+            std::printf("  %llu of %llu reads torn\n", (unsigned long long)tornCount, (unsigned long long)readCount);
+    }
+} // namespace
+
+int main()
+{
+    TestLayout();
+    TestCreateAndOpen();
+    TestRejectsOtherLayouts();
+    TestSeqlock();
+    return Finish("StatusPageTest");
+}
@@ -0,0 +1,275 @@
+#include "FakeGame.h"
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/DeferredLog.h>
+#include <DSREquipmentSwap/SlotAccess.h>
+#include <DSREquipmentSwap/SlotSwapper.h>
+#include <DSREquipmentSwap/SwapJournal.h>
+#include <DSREquipmentSwap/TimerWheel.h>
+#include <DSREquipmentSwap/TriggerTable.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    CharacterName MakeName(const std::u16string& text)
+    {
+        CharacterName name = {};
+        std::ranges::copy(text, name.begin());
+        return name;
+    }
+
+    const std::uint64_t SOLAIRE_ID = GetCharacterID(MakeName(u"Solaire"));
+    const std::uint64_t SIEGMEYER_ID = GetCharacterID(MakeName(u"Siegmeyer"));
+
+    JournaledSwap MakeSwap(
+        const std::uint64_t characterID,
+        const EquipSlot slot,
+        const int sourceParamID,
+        const int destParamID,
+        const SwapJournalLayer layer = SwapJournalLayer::SWAP)
+    {
+        return JournaledSwap{0, slot, layer, sourceParamID, destParamID, characterID};
+    }
+
+    /// @brief A journal file that is deleted before and after the test.
+    class JournalFile
+    {
+    public:
+        JournalFile()
+            : m_path(std::filesystem::temp_directory_path() / "DSREquipmentSwapJournalTest.journal")
+        {
+            Remove();
+        }
+
+        ~JournalFile() { Remove(); }
+
+        [[nodiscard]] const std::filesystem::path& GetPath() const { return m_path; }
+
+        void Remove() const
+        {
+            std::error_code error;
+            std::filesystem::remove(m_path, error);
+        }
+
+    private:
+        std::filesystem::path m_path;
+    };
+
+    bool Contains(const std::vector<JournaledSwap>& swaps, const JournaledSwap& swap)
+    {
+        return std::ranges::find(swaps, swap) != swaps.end();
+    }
+
+    void TestCharacterIDs()
+    {
+        CHECK(SOLAIRE_ID != 0 && SIEGMEYER_ID != 0 && SOLAIRE_ID != SIEGMEYER_ID);
+        CHECK(GetCharacterID(CharacterName{}) == 0); // no character loaded
+
+        // Only characters before the first null count.
+        CharacterName name = MakeName(u"Solaire");
+        name[10] = u'x';
+        CHECK(GetCharacterID(name) == SOLAIRE_ID);
+    }
+
+    void TestKeepsOtherCharacters(const JournalFile& file)
+    {
+        file.Remove();
+        const JournaledSwap solaireSwap = MakeSwap(SOLAIRE_ID, EquipSlot::HEAD, 5000, 6000);
+        const JournaledSwap siegmeyerSwap = MakeSwap(SIEGMEYER_ID, EquipSlot::HEAD, 7000, 8000);
+        {
+            auto journal = SwapJournal::Open(file.GetPath());
+            CHECK(journal && journal->GetRecovered().empty());
+            journal->Set(solaireSwap);
+        }
+        {
+            // Another character is played: Solaire's swap is not released, and Siegmeyer's own swap of the same slot
+            // does not replace it.
+            auto journal = SwapJournal::Open(file.GetPath());
+            CHECK(journal->GetRecovered() == std::vector{solaireSwap});
+            journal->Set(siegmeyerSwap);
+            CHECK(journal->GetLiveCount() == 2);
+        }
+        {
+            auto journal = SwapJournal::Open(file.GetPath());
+            CHECK(journal->GetRecovered() == (std::vector{solaireSwap, siegmeyerSwap})); // oldest first
+            journal->Release(solaireSwap);
+            journal->Release(solaireSwap); // no-op
+            CHECK(journal->GetLiveCount() == 1);
+        }
+        {
+            auto journal = SwapJournal::Open(file.GetPath());
+            CHECK(journal->GetRecovered() == std::vector{siegmeyerSwap});
+
+            // A swap set again by this run replaces the kept record of the same character and slot.
+            const JournaledSwap newSwap = MakeSwap(SIEGMEYER_ID, EquipSlot::HEAD, 7000, 9000);
+            journal->Set(newSwap);
+            CHECK(journal->GetLiveCount() == 1);
+            journal->Clear(0, EquipSlot::HEAD, SwapJournalLayer::SWAP);
+            CHECK(journal->GetLiveCount() == 0);
+        }
+        CHECK(SwapJournal::Open(file.GetPath())->GetRecovered().empty());
+    }
+
+    void TestCompactionKeepsRecovered(const JournalFile& file)
+    {
+        file.Remove();
+        const JournaledSwap loadoutSwap =
+            MakeSwap(SOLAIRE_ID, EquipSlot::BODY, 100, 200, SwapJournalLayer::LOADOUT);
+        const JournaledSwap ringSwap = MakeSwap(SOLAIRE_ID, EquipSlot::RING_0, 300, 400);
+        {
+            auto journal = SwapJournal::Open(file.GetPath());
+            journal->Set(loadoutSwap);
+            journal->Set(ringSwap);
+        }
+        {
+            auto journal = SwapJournal::Open(file.GetPath());
+            CHECK(journal->GetRecovered() == (std::vector{ringSwap, loadoutSwap})); // swaps before loadouts
+            for (int i = 0; i < 4 * static_cast<int>(SwapJournal::REGION_CAPACITY); ++i)
+            {
+                journal->Set(MakeSwap(SIEGMEYER_ID, EquipSlot::HEAD, i, i + 1));
+                journal->Clear(0, EquipSlot::HEAD, SwapJournalLayer::SWAP);
+            }
+            CHECK(journal->GetCompactionCount() >= 4);
+        }
+        const auto journal = SwapJournal::Open(file.GetPath());
+        CHECK(journal->GetRecovered().size() == 2);
+        CHECK(Contains(journal->GetRecovered(), loadoutSwap) && Contains(journal->GetRecovered(), ringSwap));
+    }
+
+    void TestDropsOldestCharacters(const JournalFile& file)
+    {
+        file.Remove();
+        constexpr int RECORDS_PER_CHARACTER = EQUIP_SLOT_COUNT * SWAP_JOURNAL_LAYER_COUNT;
+        constexpr int CHARACTER_COUNT = SwapJournal::MAX_KEPT_SWAPS / RECORDS_PER_CHARACTER + 1;
+        for (int character = 1; character <= CHARACTER_COUNT; ++character)
+        {
+            auto journal = SwapJournal::Open(file.GetPath());
+            CHECK(journal->GetDroppedCount() == 0);
+            for (int slot = 0; slot < EQUIP_SLOT_COUNT; ++slot)
+            {
+                for (int layer = 0; layer < SWAP_JOURNAL_LAYER_COUNT; ++layer)
+                {
+                    journal->Set(
+                        MakeSwap(
+                            static_cast<std::uint64_t>(character),
+                            static_cast<EquipSlot>(slot),
+                            1,
+                            2,
+                            static_cast<SwapJournalLayer>(layer)));
+                }
+            }
+        }
+
+        const auto journal = SwapJournal::Open(file.GetPath());
+        CHECK(journal->GetDroppedCount() == RECORDS_PER_CHARACTER);
+        CHECK(journal->GetRecovered().size() == SwapJournal::MAX_KEPT_SWAPS);
+        CHECK(std::ranges::none_of(
+            journal->GetRecovered(), [](const JournaledSwap& swap) { return swap.characterID == 1; }));
+    }
+
+    void TestRecoveryMatchesCharacter(const JournalFile& file)
+    {
+        file.Remove();
+        {
+            auto journal = SwapJournal::Open(file.GetPath());
+            journal->Set(MakeSwap(SOLAIRE_ID, EquipSlot::HEAD, 5000, 6000));
+            journal->Set(JournaledSwap{1, EquipSlot::HEAD, SwapJournalLayer::SWAP, 1, 2, SOLAIRE_ID}); // not the host
+        }
+
+        GetFakeGame() = {};
+        GetFakeGame().paramIDs[static_cast<int>(EquipSlot::HEAD)] = 6000;
+        const FirelinkDSR::DSRPlayer player;
+        DeferredLog log;
+        ManualTimerClock clock;
+        {
+            auto journal = SwapJournal::Open(file.GetPath());
+            SlotSwapper swapper(log, 0, clock);
+            swapper.SetJournal(journal.get());
+            CHECK(journal->GetLiveCount() == 1); // the other player's record is released at once
+            CHECK(swapper.HasJournalRecovery());
+
+            PlayerSnapshot snapshot;
+            CHECK(swapper.RecoverJournaledSwaps(player, snapshot) == 0); // character not known yet
+            snapshot.characterID = SIEGMEYER_ID;
+            CHECK(swapper.RecoverJournaledSwaps(player, snapshot) == 0);
+            CHECK(GetFakeGame().paramIDs[static_cast<int>(EquipSlot::HEAD)] == 6000);
+            CHECK(GetFakeGame().writeCount == 0);
+            CHECK(swapper.HasJournalRecovery() && journal->GetLiveCount() == 1);
+        }
+        {
+            // Solaire is loaded in a later run (or later in the same one): reverted and released.
+            auto journal = SwapJournal::Open(file.GetPath());
+            CHECK(journal->GetRecovered().size() == 1);
+            SlotSwapper swapper(log, 0, clock);
+            swapper.SetJournal(journal.get());
+            PlayerSnapshot snapshot;
+            snapshot.characterID = SIEGMEYER_ID;
+            CHECK(swapper.RecoverJournaledSwaps(player, snapshot) == 0);
+            snapshot.characterID = SOLAIRE_ID;
+            CHECK(swapper.RecoverJournaledSwaps(player, snapshot) == 1);
+            CHECK(GetFakeGame().paramIDs[static_cast<int>(EquipSlot::HEAD)] == 5000);
+            CHECK(snapshot.GetParamID(EquipSlot::HEAD) == 5000);
+            CHECK(!swapper.HasJournalRecovery() && journal->GetLiveCount() == 0);
+        }
+        CHECK(SwapJournal::Open(file.GetPath())->GetRecovered().empty());
+        log.Flush();
+    }
+
+    void TestJournalsOnlyKnownCharacters(const JournalFile& file)
+    {
+        file.Remove();
+        EquipmentSwapConfig config;
+        config.headArmorTriggers.push_back(SwapTriggerConfig{77, 5000, -1, 6000, true, false});
+        ManualTimerClock clock;
+        TriggerTable triggers(config, clock);
+        DeferredLog log;
+        SlotSwapper swapper(log, 0, clock);
+        auto journal = SwapJournal::Open(file.GetPath());
+        swapper.SetJournal(journal.get());
+
+        GetFakeGame() = {};
+        GetFakeGame().paramIDs[static_cast<int>(EquipSlot::HEAD)] = 5000;
+        const FirelinkDSR::DSRPlayer player;
+        std::vector<int> abortedSpEffects;
+
+        // Unknown character (e.g. no `nameOffset`): swapped, but not journaled, as it could never be matched.
+        PlayerSnapshot snapshot;
+        ReadPlayerSnapshot(player, SlotMask().set(), snapshot);
+        snapshot.activeSpEffects = {77};
+        CHECK(swapper.CheckSwapTriggers(0, player, snapshot, triggers, abortedSpEffects) == 1);
+        CHECK(swapper.GetTempSwap(0, EquipSlot::HEAD).has_value());
+        CHECK(journal->GetLiveCount() == 0);
+        swapper.RevertTempSwaps(0, player);
+
+        // Known character: journaled with its identity.
+        ReadPlayerSnapshot(player, SlotMask().set(), snapshot);
+        snapshot.characterID = SOLAIRE_ID;
+        snapshot.activeSpEffects = {77};
+        CHECK(swapper.CheckSwapTriggers(0, player, snapshot, triggers, abortedSpEffects) == 1);
+        CHECK(journal->GetLiveCount() == 1);
+        journal.reset();
+        const auto reopened = SwapJournal::Open(file.GetPath());
+        CHECK(reopened->GetRecovered() == std::vector{MakeSwap(SOLAIRE_ID, EquipSlot::HEAD, 5000, 6000)});
+        log.Flush();
+    }
+} // namespace
+
+int main()
+{
+    const JournalFile file;
+    TestCharacterIDs();
+    TestKeepsOtherCharacters(file);
+    TestCompactionKeepsRecovered(file);
+    TestDropsOldestCharacters(file);
+    TestRecoveryMatchesCharacter(file);
+    TestJournalsOnlyKnownCharacters(file);
+    return Finish("SwapJournalTest");
+}
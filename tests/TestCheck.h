@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdio>
+
+namespace DSREquipmentSwap::Testing
+{
+    /// @brief Number of failed `CHECK()`s so far.
+    inline int g_failedCheckCount = 0;
+
+    /// @brief Print the result of all `CHECK()`s of test `name` and return its exit code (for `main()`).
+    inline int Finish(const char* name)
+    {
+        std::printf("%s: %s (%d failed checks)\n", g_failedCheckCount == 0 ? "PASS" : "FAIL", name, g_failedCheckCount);
+        return g_failedCheckCount == 0 ? 0 : 1;
+    }
+} // namespace DSREquipmentSwap::Testing
+
+/// @brief Check `condition`, printing it and its location if it is false. The test goes on either way.
+#define CHECK(condition)                                                                                               \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(condition))                                                                                              \
+        {                                                                                                              \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);                                  \
+            ++DSREquipmentSwap::Testing::g_failedCheckCount;                                                           \
+        }                                                                                                              \
+    } while (false)
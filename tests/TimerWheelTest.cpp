@@ -0,0 +1,239 @@
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/TimerWheel.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    // Wheel geometry (see `TimerWheel`): levels of 64 slots, and the longest delay filed without parking.
+    constexpr std::uint64_t LEVEL_0_SPAN_MS = 64;
+    constexpr std::uint64_t LEVEL_1_SPAN_MS = 64 * 64;
+    constexpr std::uint64_t LEVEL_2_SPAN_MS = 64 * 64 * 64;
+    constexpr std::uint64_t MAX_DELAY_MS = 64 * 64 * 64 * 64 - 1;
+
+    /// @brief Not a multiple of any level's span, so slots do not line up with the start of the wheel.
+    constexpr std::uint64_t START_MS = 123'456'789;
+
+    /// @brief Advance `clock` by `ms` and the wheel with it. Returns the expired keys.
+    std::vector<std::uint32_t> AdvanceBy(ManualTimerClock& clock, TimerWheel& wheel, const std::uint64_t ms)
+    {
+        std::vector<std::uint32_t> expired = {999}; // must be cleared
+        clock.AdvanceMs(ms);
+        wheel.Advance(expired);
+        return expired;
+    }
+
+    /// @brief Schedule one timer with `delayMs` and check it expires exactly then, not a millisecond earlier, when
+    /// the wheel is advanced in `stepMs` steps.
+    void CheckExpiresExactly(const std::uint64_t delayMs, const std::uint64_t stepMs)
+    {
+        ManualTimerClock clock;
+        clock.AdvanceMs(START_MS);
+        TimerWheel wheel(1, clock);
+        wheel.Schedule(0, delayMs);
+        CHECK(wheel.GetRemainingMs(0) == delayMs);
+
+        std::uint64_t elapsedMs = 0;
+        while (elapsedMs + stepMs < delayMs)
+        {
+            elapsedMs += stepMs;
+            CHECK(AdvanceBy(clock, wheel, stepMs).empty());
+        }
+        CHECK(AdvanceBy(clock, wheel, delayMs - 1 - elapsedMs).empty());
+        CHECK(wheel.IsScheduled(0) && wheel.GetRemainingMs(0) == 1);
+        CHECK(AdvanceBy(clock, wheel, 1) == std::vector<std::uint32_t>{0});
+        CHECK(!wheel.IsScheduled(0) && wheel.GetCount() == 0);
+    }
+
+    void TestCascade()
+    {
+        // Around each level boundary, with single steps, update-sized steps and one jump.
+        for (const std::uint64_t delayMs : {
+                 std::uint64_t{1},
+                 LEVEL_0_SPAN_MS - 1,
+                 LEVEL_0_SPAN_MS,
+                 LEVEL_0_SPAN_MS + 1,
+                 LEVEL_1_SPAN_MS - 1,
+                 LEVEL_1_SPAN_MS,
+                 LEVEL_1_SPAN_MS + 1,
+                 LEVEL_2_SPAN_MS - 1,
+                 LEVEL_2_SPAN_MS,
+                 LEVEL_2_SPAN_MS + 1,
+                 MAX_DELAY_MS,
+             })
+        {
+            if (delayMs <= LEVEL_1_SPAN_MS + 1)
+                CheckExpiresExactly(delayMs, 1);
+            CheckExpiresExactly(delayMs, 16);
+            CheckExpiresExactly(delayMs, delayMs);
+        }
+
+        // Timers of every level expire in order when one advance passes them all.
+        ManualTimerClock clock;
+        clock.AdvanceMs(START_MS);
+        TimerWheel wheel(4, clock);
+        wheel.Schedule(0, LEVEL_2_SPAN_MS + 5);
+        wheel.Schedule(1, 3);
+        wheel.Schedule(2, LEVEL_1_SPAN_MS + 7);
+        wheel.Schedule(3, LEVEL_0_SPAN_MS + 1);
+        CHECK(wheel.GetCount() == 4);
+        CHECK(AdvanceBy(clock, wheel, LEVEL_2_SPAN_MS + 5) == (std::vector<std::uint32_t>{1, 3, 2, 0}));
+        CHECK(wheel.GetCount() == 0);
+    }
+
+    void TestParkedTimers()
+    {
+        // Further out than the top level: parked, then re-filed when its slot comes around.
+        for (const std::uint64_t delayMs : {MAX_DELAY_MS + 1, MAX_DELAY_MS + 1000, 3 * MAX_DELAY_MS + 12345})
+        {
+            CheckExpiresExactly(delayMs, LEVEL_1_SPAN_MS - 3);
+            CheckExpiresExactly(delayMs, delayMs);
+        }
+
+        // A parked timer does not hold back (or get expired with) nearer timers.
+        ManualTimerClock clock;
+        clock.AdvanceMs(START_MS);
+        TimerWheel wheel(2, clock);
+        wheel.Schedule(0, 2 * MAX_DELAY_MS);
+        wheel.Schedule(1, 10);
+        CHECK(AdvanceBy(clock, wheel, 10) == std::vector<std::uint32_t>{1});
+        CHECK(AdvanceBy(clock, wheel, MAX_DELAY_MS).empty());
+        CHECK(wheel.GetRemainingMs(0) == MAX_DELAY_MS - 10);
+        CHECK(AdvanceBy(clock, wheel, MAX_DELAY_MS - 10) == std::vector<std::uint32_t>{0});
+    }
+
+    void TestCancelAndReschedule()
+    {
+        ManualTimerClock clock;
+        clock.AdvanceMs(START_MS);
+        TimerWheel wheel(3, clock);
+
+        wheel.Schedule(0, 100);
+        wheel.Schedule(1, LEVEL_1_SPAN_MS + 100);
+        wheel.Cancel(0);
+        wheel.Cancel(0); // not running: no-op
+        wheel.Cancel(2);
+        CHECK(wheel.GetCount() == 1 && !wheel.IsScheduled(0) && wheel.GetRemainingMs(0) == 0);
+        CHECK(AdvanceBy(clock, wheel, 200).empty());
+
+        // Rescheduling restarts the timer, later or sooner, from its current level.
+        wheel.Schedule(1, 50);
+        wheel.Schedule(2, 50);
+        wheel.Schedule(2, 2 * LEVEL_0_SPAN_MS);
+        CHECK(wheel.GetCount() == 2);
+        CHECK(AdvanceBy(clock, wheel, 50) == std::vector<std::uint32_t>{1});
+        CHECK(AdvanceBy(clock, wheel, 2 * LEVEL_0_SPAN_MS - 51).empty());
+        CHECK(AdvanceBy(clock, wheel, 1) == std::vector<std::uint32_t>{2});
+
+        // A timer may be rescheduled right after it expired, and all can be stopped at once.
+        wheel.Schedule(2, 5);
+        wheel.Schedule(0, MAX_DELAY_MS + 5);
+        wheel.CancelAll();
+        CHECK(wheel.GetCount() == 0 && !wheel.IsScheduled(0) && !wheel.IsScheduled(2));
+        CHECK(AdvanceBy(clock, wheel, 2 * MAX_DELAY_MS).empty());
+    }
+
+    void TestZeroDelay()
+    {
+        ManualTimerClock clock;
+        clock.AdvanceMs(START_MS);
+        TimerWheel wheel(1, clock);
+
+        // Due now, but the wheel has already visited this millisecond: it expires on the next one.
+        wheel.Schedule(0, 0);
+        CHECK(wheel.IsScheduled(0) && wheel.GetCount() == 1);
+        CHECK(AdvanceBy(clock, wheel, 0).empty());
+        CHECK(AdvanceBy(clock, wheel, 1) == std::vector<std::uint32_t>{0});
+
+        // Scheduled while the clock is ahead of the wheel: expires at the next advance.
+        clock.AdvanceMs(500);
+        wheel.Schedule(0, 0);
+        CHECK(AdvanceBy(clock, wheel, 0) == std::vector<std::uint32_t>{0});
+    }
+
+    /// @brief Random schedules, cancels and advances against a map of expiry times.
+    void TestAgainstModel()
+    {
+        constexpr std::uint32_t KEY_COUNT = 64;
+        std::mt19937_64 random(1);
+        for (int round = 0; round < 50; ++round)
+        {
+            ManualTimerClock clock;
+            clock.AdvanceMs(random() % 100'000);
+            TimerWheel wheel(KEY_COUNT, clock);
+            std::map<std::uint32_t, std::uint64_t> expiries;
+            std::uint64_t wheelMs = clock.NowMs();
+            std::vector<std::uint32_t> expired;
+            for (int step = 0; step < 1000; ++step)
+            {
+                const std::uint32_t key = random() % KEY_COUNT;
+                if (const int operation = static_cast<int>(random() % 10); operation < 4)
+                {
+                    constexpr std::uint64_t DELAY_RANGES[] = {70, 5000, 300'000, 1ull << 26};
+                    const std::uint64_t delayMs = random() % DELAY_RANGES[random() % 4];
+                    wheel.Schedule(key, delayMs);
+                    expiries[key] = std::max(clock.NowMs() + delayMs, wheelMs + 1);
+                }
+                else if (operation < 5)
+                {
+                    wheel.Cancel(key);
+                    expiries.erase(key);
+                }
+                else
+                {
+                    clock.AdvanceMs(random() % 3 == 0 ? random() % (1ull << 25) : random() % 200);
+                    wheel.Advance(expired);
+                    wheelMs = clock.NowMs();
+
+                    std::vector<std::pair<std::uint64_t, std::uint32_t>> due;
+                    for (auto it = expiries.begin(); it != expiries.end();)
+                    {
+                        if (it->second <= wheelMs)
+                        {
+                            due.emplace_back(it->second, it->first);
+                            it = expiries.erase(it);
+                        }
+                        else
+                            ++it;
+                    }
+                    std::ranges::sort(due);
+
+                    // Same keys, in expiry order (timers due in the same millisecond in any order).
+                    CHECK(expired.size() == due.size());
+                    std::vector<std::uint64_t> expiredTimes;
+                    for (const std::uint32_t expiredKey : expired)
+                    {
+                        const auto it = std::ranges::find_if(
+                            due, [expiredKey](const auto& timer) { return timer.second == expiredKey; });
+                        CHECK(it != due.end());
+                        if (it != due.end())
+                            expiredTimes.push_back(it->first);
+                    }
+                    CHECK(std::ranges::is_sorted(expiredTimes));
+                }
+                CHECK(wheel.GetCount() == expiries.size());
+            }
+            for (const auto& [key, expiryMs] : expiries)
+                CHECK(wheel.IsScheduled(key) && wheel.GetRemainingMs(key) == expiryMs - clock.NowMs());
+        }
+    }
+} // namespace
+
+int main()
+{
+    TestCascade();
+    TestParkedTimers();
+    TestCancelAndReschedule();
+    TestZeroDelay();
+    TestAgainstModel();
+    return Finish("TimerWheelTest");
+}
@@ -0,0 +1,79 @@
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/Slots.h>
+#include <DSREquipmentSwap/TriggerCondition.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    constexpr int EVALUATION_COUNT = 5'000'000;
+
+    /// @brief A condition as a config would write it, with a hand-written equivalent to compare against.
+    constexpr const char* CONDITION = "spEffect(2100) && param(rightPrimaryWeapon) >= 200000 "
+                                      "&& param(rightPrimaryWeapon) < 201000 && !secondary(left) && id % 1000 == 0";
+
+    bool EvaluateByHand(const PlayerSnapshot& snapshot, const std::uint8_t isSpEffectActive)
+    {
+        const int rightWeapon = snapshot.paramIDs[static_cast<int>(EquipSlot::RIGHT_PRIMARY)];
+        return isSpEffectActive && rightWeapon >= 200000 && rightWeapon < 201000 && !snapshot.isSecondaryActive[0]
+               && snapshot.paramIDs[static_cast<int>(EquipSlot::LEFT_PRIMARY)] % 1000 == 0;
+    }
+
+    double GetNsPerEvaluation(const std::chrono::steady_clock::duration elapsed)
+    {
+        return std::chrono::duration<double, std::nano>(elapsed).count() / EVALUATION_COUNT;
+    }
+} // namespace
+
+/// @brief Time of one evaluation of a compiled condition, next to the same check written in C++. Not a pass/fail
+/// threshold (timing depends on the machine); it only fails if the two disagree.
+int main()
+{
+    std::vector<std::int32_t> spEffectIDs;
+    std::string error;
+    const std::optional<CompiledCondition> condition =
+        CompileCondition(CONDITION, EquipSlot::LEFT_PRIMARY, spEffectIDs, error);
+    CHECK(condition.has_value());
+    if (!condition)
+        return Finish("TriggerConditionBenchmark");
+
+    PlayerSnapshot snapshot;
+    snapshot.paramIDs = {300000, 301000, 200000, 0, 1000, 2000, 3000, 4000, 100, 0};
+    const std::vector<std::uint8_t> spEffectActive(spEffectIDs.size(), 1);
+
+    // Alternate between passing and failing on the last check, so neither loop can be predicted away entirely.
+    int bytecodeCount = 0;
+    const auto bytecodeStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < EVALUATION_COUNT; ++i)
+    {
+        snapshot.paramIDs[static_cast<int>(EquipSlot::LEFT_PRIMARY)] = 300000 + (i & 1);
+        bytecodeCount += RunCondition(condition->code.data(), ConditionContext{snapshot, 0, spEffectActive});
+    }
+    const auto bytecodeElapsed = std::chrono::steady_clock::now() - bytecodeStart;
+
+    int handWrittenCount = 0;
+    const auto handWrittenStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < EVALUATION_COUNT; ++i)
+    {
+        snapshot.paramIDs[static_cast<int>(EquipSlot::LEFT_PRIMARY)] = 300000 + (i & 1);
+        handWrittenCount += EvaluateByHand(snapshot, spEffectActive[0]);
+    }
+    const auto handWrittenElapsed = std::chrono::steady_clock::now() - handWrittenStart;
+
+    CHECK(bytecodeCount == EVALUATION_COUNT / 2 && handWrittenCount == bytecodeCount);
+    std::printf(
+        "Condition (%zu instructions): %.2f ns per evaluation; hand-written: %.2f ns\n",
+        condition->code.size(),
+        GetNsPerEvaluation(bytecodeElapsed),
+        GetNsPerEvaluation(handWrittenElapsed));
+    return Finish("TriggerConditionBenchmark");
+}
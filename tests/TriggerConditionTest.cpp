@@ -0,0 +1,218 @@
+#include "TestCheck.h"
+
+#include <DSREquipmentSwap/Slots.h>
+#include <DSREquipmentSwap/TriggerCondition.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace DSREquipmentSwap;
+using namespace DSREquipmentSwap::Testing;
+
+namespace
+{
+    /// @brief Left weapons 300000/301000 (primary current), right primary 200000, armor 1000-4000, ring 0 100.
+    PlayerSnapshot MakeSnapshot()
+    {
+        PlayerSnapshot snapshot;
+        snapshot.paramIDs = {300000, 301000, 200000, 0, 1000, 2000, 3000, 4000, 100, 0};
+        snapshot.isSecondaryActive = {false, true};
+        snapshot.activeSpEffects = {40, 2100, 5};
+        return snapshot;
+    }
+
+    std::optional<CompiledCondition> Compile(const std::string& source, const EquipSlot slot = EquipSlot::LEFT_PRIMARY)
+    {
+        std::vector<std::int32_t> spEffectIDs;
+        std::string error;
+        std::optional<CompiledCondition> condition = CompileCondition(source, slot, spEffectIDs, error);
+        CHECK(condition.has_value() == error.empty());
+        return condition;
+    }
+
+    /// @brief Compile and run `source` against `MakeSnapshot()`. Nullopt if it does not compile. A folded condition
+    /// must give the same result as its code.
+    std::optional<bool> Evaluate(
+        const std::string& source, const int playerIndex = 0, const EquipSlot slot = EquipSlot::LEFT_PRIMARY)
+    {
+        const PlayerSnapshot snapshot = MakeSnapshot();
+        std::vector<std::int32_t> spEffectIDs;
+        std::string error;
+        const std::optional<CompiledCondition> condition = CompileCondition(source, slot, spEffectIDs, error);
+        if (!condition)
+            return std::nullopt;
+
+        std::vector<std::uint8_t> spEffectActive(spEffectIDs.size());
+        for (std::size_t i = 0; i < spEffectIDs.size(); ++i)
+        {
+            const auto& active = snapshot.activeSpEffects;
+            spEffectActive[i] = std::ranges::find(active, spEffectIDs[i]) != active.end();
+        }
+        const ConditionContext context{snapshot, playerIndex, spEffectActive};
+        const bool result = RunCondition(condition->code.data(), context);
+        if (condition->constantValue)
+            CHECK(*condition->constantValue == result);
+        return result;
+    }
+
+    using Ops = std::vector<ConditionOp>;
+
+    Ops GetOps(const CompiledCondition& condition)
+    {
+        Ops ops;
+        for (const ConditionInstruction& instruction : condition.code)
+            ops.push_back(instruction.op);
+        return ops;
+    }
+
+    void TestEvaluation()
+    {
+        CHECK(Evaluate("true") == true);
+        CHECK(Evaluate("false") == false);
+        CHECK(Evaluate("1 + 2 * 3 == 7") == true);
+        CHECK(Evaluate("(1 + 2) * 3 == 9") == true);
+        CHECK(Evaluate("7 / 0 == 0 && 7 % 0 == 0") == true); // no trap
+        CHECK(Evaluate("-2147483647 - 1 < 0") == true);
+        CHECK(Evaluate("id == 300000") == true);
+        CHECK(Evaluate("id == 301000", 0, EquipSlot::LEFT_SECONDARY) == true);
+        CHECK(Evaluate("param(rightPrimaryWeapon) >= 200000 && param(ring0) == 100") == true);
+        CHECK(Evaluate("spEffect(2100) && !spEffect(7)") == true);
+        CHECK(Evaluate("spEffect(2000 + 100)") == true);
+        CHECK(Evaluate("secondary(right) && !secondary(left)") == true);
+        CHECK(Evaluate("player == 2", 2) == true);
+        CHECK(Evaluate("player == 2", 1) == false);
+        CHECK(Evaluate("id % 1000 == 0 && (id / 1000) % 2 == 0") == true);
+        CHECK(Evaluate("300000 <= id && 300001 > id && 2 - id < 0 && 600000 == id * 2") == true);
+        CHECK(Evaluate("!!id") == true);
+    }
+
+    void TestFolding()
+    {
+        // Whole conditions.
+        std::optional<CompiledCondition> condition = Compile("false && spEffect(1)");
+        CHECK(condition && condition->constantValue == false);
+        CHECK(condition && GetOps(*condition) == (Ops{ConditionOp::PUSH, ConditionOp::RETURN}));
+        condition = Compile("true || id");
+        CHECK(condition && condition->constantValue == true && condition->slots.none());
+        condition = Compile("false && id == 5 || spEffect(1)");
+        CHECK(condition && !condition->constantValue && condition->slots.none()); // no slot left to read
+
+        // Constant subexpressions, inlined into the instruction that uses them.
+        condition = Compile("2 * 3 + 1 == 7 && id == 5", EquipSlot::HEAD);
+        CHECK(condition && !condition->constantValue);
+        CHECK(
+            condition
+            && GetOps(*condition) == (Ops{ConditionOp::LOAD_SLOT, ConditionOp::EQ_CONSTANT, ConditionOp::RETURN}));
+        CHECK(condition && condition->code[1].operand == 5);
+        CHECK(condition && condition->slots.test(static_cast<int>(EquipSlot::HEAD)) && condition->slots.count() == 1);
+
+        // A constant operand of `&&`/`||` only leaves the truth of the other one.
+        condition = Compile("(id && 5) == 1", EquipSlot::HEAD);
+        CHECK(
+            condition
+            && GetOps(*condition)
+                   == (Ops{ConditionOp::LOAD_SLOT, ConditionOp::BOOL, ConditionOp::EQ_CONSTANT, ConditionOp::RETURN}));
+        CHECK(Evaluate("id || 0") == true);
+        CHECK(Evaluate("(0 || id) == 1") == true);
+        CHECK(Evaluate("(spEffect(40) && id) + 1 == 2") == true);
+    }
+
+    void TestShortCircuit()
+    {
+        // `&&`: the right operand is skipped, to the end, if the left one is 0 (which is kept as the result).
+        std::optional<CompiledCondition> condition = Compile("spEffect(1) && id == 5", EquipSlot::HEAD);
+        CHECK(
+            condition
+            && GetOps(*condition)
+                   == (Ops{
+                       ConditionOp::LOAD_SP_EFFECT,
+                       ConditionOp::JUMP_IF_FALSE,
+                       ConditionOp::LOAD_SLOT,
+                       ConditionOp::EQ_CONSTANT,
+                       ConditionOp::RETURN}));
+        CHECK(condition && condition->code[1].operand == 4);
+
+        // `||` binds looser than `&&`: both jump past the `&&`.
+        condition = Compile("spEffect(1) || spEffect(2) && id", EquipSlot::HEAD);
+        CHECK(
+            condition
+            && GetOps(*condition)
+                   == (Ops{
+                       ConditionOp::LOAD_SP_EFFECT,
+                       ConditionOp::JUMP_IF_TRUE,
+                       ConditionOp::LOAD_SP_EFFECT,
+                       ConditionOp::JUMP_IF_FALSE,
+                       ConditionOp::LOAD_SLOT,
+                       ConditionOp::BOOL,
+                       ConditionOp::RETURN}));
+        CHECK(condition && condition->code[1].operand == 6 && condition->code[3].operand == 6);
+
+        // Results are booleans whichever way the jumps go.
+        CHECK(Evaluate("spEffect(7) || spEffect(5)") == true);
+        CHECK(Evaluate("spEffect(7) || spEffect(8)") == false);
+        CHECK(Evaluate("(spEffect(7) || id) == 1") == true);
+        CHECK(Evaluate("(spEffect(40) && spEffect(7)) == 0") == true);
+    }
+
+    void TestDepthLimit()
+    {
+        // Each `id + (...)` keeps one more value on the stack.
+        std::string source = "id";
+        for (int i = 1; i < CONDITION_MAX_STACK; ++i)
+            source = "id + (" + source + ")";
+        CHECK(Compile(source).has_value());
+        source = "id + (" + source + ")";
+        CHECK(!Evaluate(source).has_value());
+
+        // Parentheses alone need no stack, but are still limited.
+        CHECK(Evaluate(std::string(20, '(') + "1" + std::string(20, ')')) == true);
+        CHECK(!Evaluate(std::string(100, '(') + "1" + std::string(100, ')')).has_value());
+
+        std::string longSource = "1";
+        while (longSource.size() <= CONDITION_MAX_LENGTH)
+            longSource += "+1";
+        CHECK(!Evaluate(longSource).has_value());
+    }
+
+    void TestMalformed()
+    {
+        for (const char* source : {
+                 "",
+                 "1 < 2 == 1", // comparisons are not chained
+                 "foo",
+                 "param(hand)",
+                 "spEffect(id)",
+                 "spEffect(0)",
+                 "secondary(both)",
+                 "(1",
+                 "1)",
+                 "1 +",
+                 "&& id",
+                 "id ==",
+                 "99999999999",
+                 "id = 5",
+                 "id # 5",
+             })
+        {
+            std::vector<std::int32_t> spEffectIDs;
+            std::string error;
+            const bool isRejected = !CompileCondition(source, EquipSlot::HEAD, spEffectIDs, error).has_value();
+            CHECK(isRejected && !error.empty());
+            if (!isRejected)
+                std::printf("  accepted: '%s'\n", source);
+        }
+    }
+} // namespace
+
+int main()
+{
+    TestEvaluation();
+    TestFolding();
+    TestShortCircuit();
+    TestDepthLimit();
+    TestMalformed();
+    return Finish("TriggerConditionTest");
+}